@@ -0,0 +1,273 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% report = (struct) with the fields
+%              Created, MATLAB    - when and with which MATLAB release the suite ran
+%              Settings           - NumRepeats and NumLatencySamples used
+%              Cases              - (struct array) one element per case with Name, Region, Fluid, NumPoints and
+%                                   REFPROP, CoolProp - (struct) ThroughputPointsPerSecond (whole grid per call, best of
+%                                                       NumRepeats), LatencyP50Ms, LatencyP90Ms, LatencyP99Ms (one
+%                                                       state point per call) and FailureRate (NaN points / points)
+%                                   Deviation         - (struct array) per requested property: Property, NumCompared,
+%                                                       MedianRelDeviation, P95RelDeviation, MaxRelDeviation of
+%                                                       CoolProp from REFPROP over the points both evaluated
+%              Regressions        - (string) one line per metric that is worse than in Baseline by more than Tolerance
+%
+% [INPUTS]:
+% refpropLocation     = (string) the location of the REFPROP library files, "" to skip REFPROP
+% coolpropLocation    = (string) the location of the CoolProp library files, "" to skip CoolProp
+% Cases               = [optional (name, value) pair] (struct array) grids to run, defaults to the built-in suite of
+%                                                     single-phase, two-phase, near-critical and mixture grids. Fields:
+%                                                     Name, Region, Fluid, Composition, Input1, Values1, Input2,
+%                                                     Values2 and Properties, with REFPROP names (T, P, D, H, S, Q, CP)
+%                                                     and values in SI units (K, Pa, kg/m^3, J/kg, J/(kg K))
+% NumRepeats          = [optional (name, value) pair] (double) timed evaluations of each grid, defaults to 5
+% NumLatencySamples   = [optional (name, value) pair] (double) single-point calls timed per case, defaults to 20
+% ReportFile          = [optional (name, value) pair] (string) JSON file the report is written to, defaults to none
+% Baseline            = [optional (name, value) pair] (string) JSON report of an earlier run to compare with
+% Tolerance           = [optional (name, value) pair] (double) relative change of a metric counted as a regression,
+%                                                     defaults to 0.25
+%
+% Both backends get identical grids through getFluidProperty: REFPROP in MASS BASE SI with molar compositions,
+% CoolProp with the library kept loaded. The JSON report keeps the field order fixed, so two reports can be diffed.
+%
+% EXAMPLES:
+%    report = benchmarkFluidBackends('C:\Program Files (x86)\REFPROP\', 'C:\Program Files\CoolProp\',...
+%                                    ReportFile="benchmark_R2026a.json");
+%
+%    Compare a later run with it and list the regressions:
+%    report = benchmarkFluidBackends(rpLoc, cpLoc, Baseline="benchmark_R2026a.json");
+%    disp(report.Regressions)
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function report = benchmarkFluidBackends(refpropLocation, coolpropLocation, opts)
+    arguments
+        refpropLocation        (1, :) {mustBeText}
+        coolpropLocation       (1, :) {mustBeText}
+        opts.Cases             (1, :) struct = defaultCases()
+        opts.NumRepeats        (1, 1) double {mustBeInteger, mustBePositive} = 5;
+        opts.NumLatencySamples (1, 1) double {mustBeInteger, mustBePositive} = 20;
+        opts.ReportFile        (1, 1) string = "";
+        opts.Baseline          (1, 1) string = "";
+        opts.Tolerance         (1, 1) double {mustBePositive} = 0.25;
+    end
+
+    backends  = ["REFPROP", "CoolProp"];
+    locations = [string(refpropLocation), string(coolpropLocation)];
+    if strlength(locations(2)) > 0
+        unloadCoolProp = onCleanup(@() unloadLibraryIfLoaded('CoolProp'));
+    end
+
+    report = struct("Created",     string(datetime("now", "Format", "yyyy-MM-dd'T'HH:mm:ss")),...
+                    "MATLAB",      string(version),...
+                    "Settings",    struct("NumRepeats",        opts.NumRepeats,...
+                                          "NumLatencySamples", opts.NumLatencySamples),...
+                    "Cases",       [],...
+                    "Regressions", strings(0, 1));
+
+    caseResults = cell(1, numel(opts.Cases));
+    for cx = 1:numel(opts.Cases)
+        tc     = opts.Cases(cx);
+        result = struct("Name", string(tc.Name), "Region", string(tc.Region), "Fluid", string(tc.Fluid),...
+                        "NumPoints", numel(tc.Values1) * numel(tc.Values2));
+        values = cell(1, 2);
+        for bx = 1:2
+            if strlength(locations(bx)) == 0
+                result.(backends(bx)) = struct("ThroughputPointsPerSecond", NaN, "LatencyP50Ms", NaN,...
+                                               "LatencyP90Ms", NaN, "LatencyP99Ms", NaN, "FailureRate", NaN);
+                continue
+            end
+            [result.(backends(bx)), values{bx}] = runBackend(backends(bx), locations(bx), tc, opts);
+        end % end loop over backends
+
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        % relative deviation of CoolProp from REFPROP where both returned a value %
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        deviation = struct("Property", {}, "NumCompared", {}, "MedianRelDeviation", {}, "P95RelDeviation", {},...
+                           "MaxRelDeviation", {});
+        if ~any(cellfun(@isempty, values))
+            for px = 1:numel(tc.Properties)
+                rp     = values{1}{px};
+                cp     = values{2}{px};
+                both   = ~isnan(rp) & ~isnan(cp);
+                relDev = sort(abs(cp(both) - rp(both)) ./ abs(rp(both)));
+                deviation(px).Property           = string(tc.Properties{px});
+                deviation(px).NumCompared        = numel(relDev);
+                deviation(px).MedianRelDeviation = percentileOf(relDev, 0.50);
+                deviation(px).P95RelDeviation    = percentileOf(relDev, 0.95);
+                deviation(px).MaxRelDeviation    = percentileOf(relDev, 1.00);
+            end % end loop over properties
+        end
+        result.Deviation = deviation;
+        caseResults{cx}  = result;
+    end % end loop over cases
+    report.Cases = [caseResults{:}];
+
+    if strlength(opts.Baseline) > 0
+        report.Regressions = findRegressions(report, jsondecode(fileread(opts.Baseline)), opts.Tolerance);
+    end
+    if strlength(opts.ReportFile) > 0
+        fid = fopen(opts.ReportFile, "w");
+        if fid < 0
+            error("Cannot open " + opts.ReportFile + " to write the report.");
+        end
+        closeFile = onCleanup(@() fclose(fid));
+        fprintf(fid, "%s\n", jsonencode(report, "PrettyPrint", true));
+    end
+end % end function benchmarkFluidBackends
+
+function [metrics, values] = runBackend(backend, location, tc, opts)
+% RUNBACKEND times one case on one backend: the whole grid per call for the throughput, and single state points per
+%            call for the latency. Returns the metrics and the grid values of each property.
+    numProp = numel(tc.Properties);
+    values  = cell(1, numProp);
+    evalProp = @(prop, val1, val2) evaluate(backend, location, prop, tc, val1, val2);
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % the first evaluation loads the library and the fluid, so it is not timed %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    for px = 1:numProp
+        values{px} = evalProp(tc.Properties{px}, tc.Values1, tc.Values2);
+    end % end loop over properties
+
+    gridTime = Inf;
+    for rx = 1:opts.NumRepeats
+        timer = tic;
+        for px = 1:numProp
+            evalProp(tc.Properties{px}, tc.Values1, tc.Values2);
+        end % end loop over properties
+        gridTime = min(gridTime, toc(timer));
+    end % end loop over repeats
+
+    [idx1, idx2] = ndgrid(1:numel(tc.Values1), 1:numel(tc.Values2));
+    samples      = round(linspace(1, numel(idx1), min(opts.NumLatencySamples, numel(idx1))));
+    latency      = zeros(numel(samples), 1);
+    for sx = 1:numel(samples)
+        timer = tic;
+        evalProp(tc.Properties{1}, tc.Values1(idx1(samples(sx))), tc.Values2(idx2(samples(sx))));
+        latency(sx) = toc(timer);
+    end % end loop over latency samples
+    latency = sort(latency) * 1e3;
+
+    numFailed = sum(cellfun(@(v) nnz(isnan(v)), values));
+    metrics = struct("ThroughputPointsPerSecond", numProp * numel(idx1) / gridTime,...
+                     "LatencyP50Ms",              percentileOf(latency, 0.50),...
+                     "LatencyP90Ms",              percentileOf(latency, 0.90),...
+                     "LatencyP99Ms",              percentileOf(latency, 0.99),...
+                     "FailureRate",               numFailed / (numProp * numel(idx1)));
+end % end function runBackend
+
+function vals = evaluate(backend, location, prop, tc, val1, val2)
+% EVALUATE one property on one backend over the grid of val1 and val2, NaN where the backend failed. A grid the
+%          backend stops on is repeated point by point, so one bad state point does not fail the whole grid.
+    cpNames = containers.Map({'T', 'P', 'D',     'H',     'S',     'Q', 'CP'},...
+                             {'T', 'P', 'Dmass', 'Hmass', 'Smass', 'Q', 'Cpmass'});
+    if backend == "REFPROP"
+        call = @(v1, v2) getFluidProperty(location, prop, tc.Input1, v1, tc.Input2, v2, tc.Fluid, tc.Composition,...
+                                          0, 'MASS BASE SI');
+    else
+        call = @(v1, v2) getFluidProperty(location, cpNames(char(prop)), cpNames(char(tc.Input1)), v1,...
+                                          cpNames(char(tc.Input2)), v2, tc.Fluid, tc.Composition,...
+                                          keepLibraryLoaded=true);
+    end
+
+    vals = NaN(numel(val1), numel(val2));
+    try
+        out = call(val1, val2);
+        if isequal(size(out), size(vals))
+            vals = out;
+            return
+        end
+    catch
+    end
+    for ix1 = 1:numel(val1)
+        for ix2 = 1:numel(val2)
+            try
+                out = call(val1(ix1), val2(ix2));
+                if isscalar(out)
+                    vals(ix1, ix2) = out;
+                end
+            catch
+            end
+        end % end loop over input property 2 values
+    end % end loop over input property 1 values
+end % end function evaluate
+
+function value = percentileOf(sortedValues, fraction)
+% PERCENTILEOF nearest-rank percentile of an ascending array, NaN when it is empty
+    if isempty(sortedValues)
+        value = NaN;
+    else
+        value = sortedValues(max(1, ceil(fraction * numel(sortedValues))));
+    end
+end % end function percentileOf
+
+function regressions = findRegressions(report, baseline, tolerance)
+% FINDREGRESSIONS lists the metrics of the cases in both reports that are worse than the baseline by more than the
+%                 tolerance: lower throughput, higher latency, failure rate or deviation
+    regressions = strings(0, 1);
+    if iscell(baseline.Cases)   % jsondecode keeps cases with different numbers of properties in a cell array
+        baseline.Cases = [baseline.Cases{:}];
+    end
+    higherIsWorse = ["LatencyP50Ms", "LatencyP90Ms", "LatencyP99Ms"];
+    for cx = 1:numel(report.Cases)
+        current = report.Cases(cx);
+        bx      = find(string({baseline.Cases.Name}) == current.Name, 1);
+        if isempty(bx)
+            continue
+        end
+        base    = baseline.Cases(bx);
+        for backend = ["REFPROP", "CoolProp"]
+            was = base.(backend);
+            is  = current.(backend);
+            if is.ThroughputPointsPerSecond < (1 - tolerance) * was.ThroughputPointsPerSecond
+                regressions(end + 1, 1) = sprintf("%s %s throughput %.4g -> %.4g points/s", current.Name, backend,...
+                                                  was.ThroughputPointsPerSecond,...
+                                                  is.ThroughputPointsPerSecond); %#ok<AGROW>
+            end
+            for metric = higherIsWorse
+                if is.(metric) > (1 + tolerance) * was.(metric)
+                    regressions(end + 1, 1) = sprintf("%s %s %s %.4g -> %.4g", current.Name, backend, metric,...
+                                                      was.(metric), is.(metric)); %#ok<AGROW>
+                end
+            end % end loop over latency metrics
+            if is.FailureRate > was.FailureRate
+                regressions(end + 1, 1) = sprintf("%s %s failure rate %.4g -> %.4g", current.Name, backend,...
+                                                  was.FailureRate, is.FailureRate); %#ok<AGROW>
+            end
+        end % end loop over backends
+        if isempty(base.Deviation)
+            continue
+        end
+        for px = 1:numel(current.Deviation)
+            is = current.Deviation(px);
+            dx = find(string({base.Deviation.Property}) == is.Property, 1);
+            if ~isempty(dx) && (is.MaxRelDeviation > (1 + tolerance) * base.Deviation(dx).MaxRelDeviation)
+                regressions(end + 1, 1) = sprintf("%s %s max deviation %.4g -> %.4g", current.Name, is.Property,...
+                                                  base.Deviation(dx).MaxRelDeviation, is.MaxRelDeviation); %#ok<AGROW>
+            end
+        end % end loop over properties
+    end % end loop over cases
+end % end function findRegressions
+
+function cases = defaultCases()
+% DEFAULTCASES single-phase, two-phase, near-critical and mixture grids in SI units
+    cases = struct("Name",        {"water-liquid", "r134a-vapor", "r134a-two-phase", "co2-near-critical",...
+                                   "r32-r125-mixture"},...
+                   "Region",      {"single-phase", "single-phase", "two-phase", "near-critical", "mixture"},...
+                   "Fluid",       {"Water", "R134a", "R134a", "CO2", "R32;R125"},...
+                   "Composition", {1, 1, 1, 1, [0.5, 0.5]},...
+                   "Input1",      {'T', 'T', 'T', 'T', 'T'},...
+                   "Values1",     {300:10:400, 320:10:400, 250:10:350, 300:0.25:306, 280:10:340},...
+                   "Input2",      {'P', 'P', 'Q', 'P', 'P'},...
+                   "Values2",     {[1e6, 5e6, 1e7], [2e5, 5e5, 1e6], 0:0.25:1, [7.0e6, 7.377e6, 7.6e6, 8.0e6],...
+                                   [1e6, 2e6]},...
+                   "Properties",  {{'H', 'S', 'D'}, {'H', 'S', 'D'}, {'P', 'H', 'D'}, {'D', 'H', 'CP'}, {'H', 'D'}});
+end % end function defaultCases
+
+function unloadLibraryIfLoaded(libName)
+    if libisloaded(libName)
+        unloadlibrary(libName);
+    end
+end % end function unloadLibraryIfLoaded
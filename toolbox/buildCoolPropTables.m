@@ -0,0 +1,75 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% report = (struct) (1xnumFluids) array with the fields
+%              Fluid          - (string) the fluid the tables were built for
+%              Backend        - (string) the tabular backend, "BICUBIC&HEOS" or "TTSE&HEOS"
+%              BuildTime      - (double) time to build the tables, or to load them from the table directory, in seconds
+%              FromCache      - (logical) true when no new table files were written, i.e. the tables were loaded
+%              TableDirectory - (string) the directory the tables are saved in
+%
+% [INPUTS]:
+% libraryLocation   = (string) the location of the CoolProp library files (dll, exe, etc.)
+% fluids            = (string) (1xnumFluids) array of pure or predefined CoolProp fluids, e.g., ["Water", "R134a"]
+% Backend           = [optional (name, value) pair] (string) tabular backend, defaults to "BICUBIC&HEOS"
+% TableDirectory    = [optional (name, value) pair] (string) directory CoolProp saves the tables to, defaults to
+%                                                            "" -> CoolProp's ~/.CoolProp/Tables
+% keepLibraryLoaded = [optional (name, value) pair] (logical) defaults to true so the tables stay in memory for the
+%                                                             getFluidProperty calls that follow, see getFluidProperty
+%
+% Building the tables of a fluid can take tens of seconds. CoolProp does it the first time a tabular backend is used
+% for that fluid and saves them, so later sessions only load them. Calling this function before a simulation moves
+% that cost out of the first time step.
+%
+% EXAMPLES:
+%    libLoc = 'C:\Program Files\CoolProp\';
+%
+%    Build the bicubic tables of two refrigerants in a project directory and show how long each took:
+%    report = buildCoolPropTables(libLoc, ["R134a", "R1234yf"], TableDirectory="C:\work\tables");
+%    disp(struct2table(report))
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function report = buildCoolPropTables(libraryLocation, fluids, opts)
+    arguments
+        libraryLocation        (1, :) {mustBeText}
+        fluids                 (1, :) string
+        opts.Backend           (1, 1) string {mustBeMember(opts.Backend,...
+                                                   ["BICUBIC&HEOS", "TTSE&HEOS"])} = "BICUBIC&HEOS";
+        opts.TableDirectory    (1, :) {mustBeText} = "";
+        opts.keepLibraryLoaded (1, 1) logical      = true;
+    end
+
+    cpObj = MLCoolProp(libraryLocation, opts.keepLibraryLoaded);
+    cpObj.backend = char(opts.Backend);
+    tableDir = string(opts.TableDirectory);
+    if strlength(tableDir) > 0
+        cpObj.setTableDirectory(tableDir);
+    else
+        tableDir = fullfile(homeDirectory(), ".CoolProp", "Tables");
+    end
+
+    report = struct("Fluid", cell(1, numel(fluids)), "Backend", opts.Backend, "BuildTime", 0, "FromCache", false,...
+                    "TableDirectory", tableDir);
+    for fx = 1:numel(fluids)
+        numFiles = countTableFiles(tableDir);
+        report(fx).Fluid     = fluids(fx);
+        report(fx).BuildTime = cpObj.buildTables(fluids(fx));
+        report(fx).FromCache = (countTableFiles(tableDir) == numFiles);
+    end % end loop over fluids
+end % end function buildCoolPropTables
+
+function numFiles = countTableFiles(tableDir)
+% COUNTTABLEFILES number of files below tableDir, 0 if it does not exist yet
+    listing  = dir(fullfile(tableDir, "**", "*"));
+    numFiles = nnz(~[listing.isdir]);
+end % end function countTableFiles
+
+function homeDir = homeDirectory()
+% HOMEDIRECTORY the user's home directory, where CoolProp keeps its tables by default
+    if ispc
+        homeDir = string(getenv("USERPROFILE"));
+    else
+        homeDir = string(getenv("HOME"));
+    end
+end % end function homeDirectory
@@ -0,0 +1,112 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% report = (struct) with the fields
+%              Exact, Fast      - (MxN) values of the requested property from the "exact" and "fast" tiers
+%              TimeExact        - (double) fastest of NumRepeats calls for the grid with "exact", in seconds
+%              TimeFast         - (double) fastest of NumRepeats calls for the grid with "fast", in seconds
+%              TimeLoad         - (double) fastest of NumRepeats calls for one state point with "exact", in
+%                                 seconds: the cost of loading REFPROP, setting the fluid and unloading REFPROP
+%                                 that every call, and so TimeExact and TimeFast, includes
+%              Speedup          - (double) (TimeExact - TimeLoad) / (TimeFast - TimeLoad), the speedup of the
+%                                 evaluations themselves
+%              MaxAbsDeviation  - (double) largest |Fast - Exact| over the points both tiers evaluated
+%              MaxRelDeviation  - (double) largest |Fast - Exact| / |Exact| over those points
+%              RmsRelDeviation  - (double) root mean square of the relative deviation over those points
+%              NumFailedFast    - (double) points the fast tier returned as NaN where the exact tier did not
+%
+% [INPUTS]:
+% libraryLocation     = (string) the location of the REFPROP library files
+% requestedProperty   = (string) the thermodynamic property name compared
+% inputProperty1      = (string) name of the 1st property of the reference grid
+% inputProperty1Value = (double) (1xM) array of values of the 1st property of the reference grid
+% inputProperty2      = (string) name of the 2nd property of the reference grid
+% inputProperty2Value = (double) (1xN) array of values of the 2nd property of the reference grid
+% fluid               = (string) indicating the fluid, e.g., "Water", "R32;R125"
+% fluidComposition    = (double) array of size 1xnumSpec species fraction, see getFluidProperty
+% massOrMolar         = (int) value to determine input composition units: 0 -> Molar, 1 -> Mass
+% desiredUnits        = (char) enum as expected by refprop.dll to determine the units to use
+% NumRepeats          = [optional (name, value) pair] (double) evaluations timed per tier, defaults to 3
+%
+% Use it before choosing Accuracy="fast" or "hybrid" in getFluidProperty, on a grid covering the screening region.
+%
+% EXAMPLES:
+%    libLoc = 'C:\Program Files (x86)\REFPROP\';
+%
+%    Deviation and speedup of the fast tier for the density of R32 over a screening grid:
+%    report = compareAccuracyTiers(libLoc, 'D', 'T', 250:5:340, 'P', [500, 1000, 2000], "R32", 1, 1, 'MKS');
+%    fprintf("%.1fx faster, %.2f %% largest deviation\n", report.Speedup, 100*report.MaxRelDeviation);
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function report = compareAccuracyTiers(libraryLocation, requestedProperty, inputProperty1, inputProperty1Value,...
+                                       inputProperty2, inputProperty2Value, fluid, fluidComposition, massOrMolar,...
+                                       desiredUnits, opts)
+    arguments
+        libraryLocation     (1, :) {mustBeText}
+        requestedProperty   (1, :) {mustBeText}
+        inputProperty1      (1, :) {mustBeText}
+        inputProperty1Value (1, :) double
+        inputProperty2      (1, :) {mustBeText}
+        inputProperty2Value (1, :) double
+        fluid               (1, :) string
+        fluidComposition    (1, :) double       = 1;
+        massOrMolar         (1, 1) double       = 0;
+        desiredUnits        (1, :) {mustBeText} = "MKS";
+        opts.NumRepeats     (1, 1) double {mustBeInteger, mustBePositive} = 3;
+    end
+
+    tiers    = ["exact", "fast"];
+    times    = Inf(1, 2);
+    vals     = cell(1, 2);
+    gridSize = [numel(inputProperty1Value), numel(inputProperty2Value)];
+    for tx = 1:2
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        % the first call reads the REFPROP files from disk, so it is not one of the timed. Each %
+        % call loads and unloads REFPROP again, which TimeLoad measures on its own below        %
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        vals{tx} = getFluidProperty(libraryLocation, requestedProperty, inputProperty1, inputProperty1Value,...
+                                    inputProperty2, inputProperty2Value, fluid, fluidComposition, massOrMolar,...
+                                    desiredUnits, Accuracy=tiers(tx));
+        if ~isequal(size(vals{tx}), gridSize)
+            error("The " + tiers(tx) + " tier returned " + join(string(size(vals{tx})), "x") + " values for the "...
+                  + gridSize(1) + "x" + gridSize(2) + " grid.");
+        end
+        for rx = 1:opts.NumRepeats
+            timer = tic;
+            getFluidProperty(libraryLocation, requestedProperty, inputProperty1, inputProperty1Value,...
+                             inputProperty2, inputProperty2Value, fluid, fluidComposition, massOrMolar,...
+                             desiredUnits, Accuracy=tiers(tx));
+            times(tx) = min(times(tx), toc(timer));
+        end % end loop over timed evaluations
+    end % end loop over tiers
+
+    timeLoad = Inf;
+    for rx = 1:opts.NumRepeats
+        timer = tic;
+        getFluidProperty(libraryLocation, requestedProperty, inputProperty1, inputProperty1Value(1),...
+                         inputProperty2, inputProperty2Value(1), fluid, fluidComposition, massOrMolar,...
+                         desiredUnits, Accuracy="exact");
+        timeLoad = min(timeLoad, toc(timer));
+    end % end loop over timed single state points
+
+    exact  = vals{1};
+    fast   = vals{2};
+    both   = ~isnan(exact) & ~isnan(fast);
+    absDev = abs(fast(both) - exact(both));
+    relDev = absDev ./ abs(exact(both));
+    if isempty(relDev)
+        [absDev, relDev] = deal(0);
+    end
+
+    report = struct("Exact",           exact,...
+                    "Fast",            fast,...
+                    "TimeExact",       times(1),...
+                    "TimeFast",        times(2),...
+                    "TimeLoad",        timeLoad,...
+                    "Speedup",         max(times(1) - timeLoad, eps) / max(times(2) - timeLoad, eps),...
+                    "MaxAbsDeviation", max(absDev),...
+                    "MaxRelDeviation", max(relDev),...
+                    "RmsRelDeviation", sqrt(mean(relDev.^2)),...
+                    "NumFailedFast",   nnz(~isnan(exact) & isnan(fast)));
+end % end function compareAccuracyTiers
@@ -1,11 +1,62 @@
 
-% Copyright 2019 - 2025 The MathWorks, Inc.
+% Copyright 2019 - 2026 The MathWorks, Inc.
 
 origLoc = cd(fullfile('toolbox', 'internal'));
 
 try
     includePath = ['-I' fullfile(pwd, 'include')];
-    mex('hiLevelMexC.cpp', includePath);
+
+    % the engine's shared result cache uses shm_open, which is in librt on older glibc
+    rtLib = {};
+    if isunix && ~ismac
+        rtLib = {'-lrt'};
+    end
+    mex('hiLevelMexC.cpp', 'refpropEngine.cpp', includePath, '-lut', rtLib{:}, '-R2018a');
+    mex('cycleMexC.cpp',   includePath);
+    mex('fluidInfoMexC.cpp', includePath);
+    mex('transportMexC.cpp', includePath);
+    mex('derivativeMexC.cpp', includePath);
+    mex('preparedMexC.cpp', includePath);
+    mex('batchMexC.cpp', 'refpropEngine.cpp', includePath, '-lut', rtLib{:});
+    mex('hxMexC.cpp', includePath);
+    mex('compressionMexC.cpp', includePath, '-lut');
+
+    % CoolProp is opened at run time with dlopen, which is in libdl on older glibc
+    dlLib = {};
+    if isunix && ~ismac
+        dlLib = {'-ldl'};
+    end
+    mex('coolpropMexC.cpp', includePath, '-lut', dlLib{:});
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % the property server and its client use Unix domain sockets and fork() %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    if isunix
+        mex('serverMexC.cpp', includePath);
+        [status, msg] = system(['c++ -O2 -std=c++17 "' includePath '" refpropServer.cpp -o refpropServer -ldl '...
+                                strjoin(rtLib)]);
+        if status ~= 0
+            error("Building refpropServer failed:\n%s", msg);
+        end
+
+        % the engine behind hiLevelMexC as a shared library for S-functions, FMUs and C++ models
+        engineLib = 'librefpropEngine.so';
+        if ismac
+            engineLib = 'librefpropEngine.dylib';
+        end
+        [status, msg] = system(['c++ -O2 -std=c++17 -fPIC -shared "' includePath '" refpropEngine.cpp -o '...
+                                engineLib ' -ldl ' strjoin(rtLib)]);
+        if status ~= 0
+            error("Building %s failed:\n%s", engineLib, msg);
+        end
+
+        % the sharded command-line tool that generates property tables without MATLAB
+        [status, msg] = system(['c++ -O2 -std=c++17 "' includePath '" refpropBatch.cpp refpropEngine.cpp -o '...
+                                'refpropBatch -ldl ' strjoin(rtLib)]);
+        if status ~= 0
+            error("Building refpropBatch failed:\n%s", msg);
+        end
+    end
 catch ME
     cd(origLoc);
     clear origLoc;
@@ -0,0 +1,25 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% requestedPropertyValue = (double) (MxN) array of values for the requested property of the prepared query where M is
+%                                   the number of values for inputProperty1 and N is the number of values for
+%                                   inputProperty2
+%
+% [INPUTS]:
+% handle              = (double) handle returned by prepareFluidProperty
+% inputProperty1Value = (double) (1xM) array of values of the 1st property of the prepared query
+% inputProperty2Value = (double) (1xN) array of values of the 2nd property of the prepared query
+%
+% There is no arguments block, so nothing but the handle and the value types is checked on a call; everything else was
+% checked by prepareFluidProperty. Points REFPROP cannot evaluate are NaN with a warning.
+% The output array is the only allocation of a call; REFPROP stays loaded and the fluid set between calls.
+%
+% EXAMPLES:
+%    hQuery = prepareFluidProperty(libLoc, 'H', 'T', 'P', "Water", 1, 1, 'MKS');
+%    h      = evaluatePreparedProperty(hQuery, 300, 101.325);
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function requestedPropertyValue = evaluatePreparedProperty(handle, inputProperty1Value, inputProperty2Value)
+    requestedPropertyValue = preparedMexC(handle, inputProperty1Value, inputProperty2Value);
+end % end function evaluatePreparedProperty
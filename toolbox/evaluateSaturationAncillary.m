@@ -0,0 +1,95 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% value = (double) array of the same size as inputValue of the saturation property in SI units (Pa, K, kg/m^3, J/kg,
+%                  J/(kg K))
+% fromLibrary = (logical) array of the same size as inputValue, true where the value was evaluated by the library
+%                         because the point is outside the range of the approximants, e.g., near the critical point
+%
+% [INPUTS]:
+% ancillary         = (struct) approximants returned by fitSaturationAncillary
+% requestedProperty = (string) one of "Pliq", "Pvap", "Tliq", "Tvap", "Dliq", "Dvap", "Hliq", "Hvap", "Sliq" or
+%                              "Svap"; the liq properties are at the bubble point and the vap properties at the dew
+%                              point. "P" and "T" are accepted for "Pliq" and "Tliq"
+% inputProperty     = (string) "T" or "P", the saturation temperature or pressure the property is evaluated at
+% inputValue        = (double) array of temperatures (K) or pressures (Pa)
+%
+% The approximants are evaluated with Clenshaw's recurrence on the whole array at once, so no library is called for
+% points inside their range. A property requested at a pressure is evaluated at the bubble or dew temperature of
+% that pressure. Points outside the range, and only those, are evaluated by the library through getFluidProperty.
+%
+% EXAMPLES:
+%    libLoc = 'C:\Program Files (x86)\REFPROP\';
+%
+%    Saturated vapor enthalpy of R134a at the evaporating pressure of a million cycle iterations:
+%    anc  = fitSaturationAncillary(libLoc, "R134a");
+%    hVap = evaluateSaturationAncillary(anc, "Hvap", "P", 2e5 + 1e5*rand(1, 1e6));
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function [value, fromLibrary] = evaluateSaturationAncillary(ancillary, requestedProperty, inputProperty, inputValue)
+    arguments
+        ancillary         (1, 1) struct
+        requestedProperty (1, 1) string {mustBeMember(requestedProperty, ["P", "T", "Pliq", "Pvap", "Tliq", "Tvap",...
+                                                                          "Dliq", "Dvap", "Hliq", "Hvap", "Sliq",...
+                                                                          "Svap"])}
+        inputProperty     (1, 1) string {mustBeMember(inputProperty, ["T", "P"])}
+        inputValue               double
+    end
+
+    name = requestedProperty;
+    if strlength(name) == 1
+        name = name + "liq";
+    end
+    if startsWith(name, inputProperty)
+        error("%s is the input property, request one of the other saturation properties.", inputProperty);
+    end
+    phase = extractAfter(name, 1);
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % T along log(P) directly, other properties at a pressure through their T of that P %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    if inputProperty == "P"
+        T = evaluateFit(ancillary.Fits.("T" + phase), log(inputValue));
+        if name == "T" + phase
+            value = T;
+        else
+            value = evaluateFit(ancillary.Fits.(name), T);
+        end
+    else
+        value = evaluateFit(ancillary.Fits.(name), inputValue);
+    end
+
+    fromLibrary = isnan(value) & ~isnan(inputValue);
+    if any(fromLibrary, "all")
+        value(fromLibrary) = saturationReference(ancillary, name, inputProperty, inputValue(fromLibrary));
+    end
+end % end function evaluateSaturationAncillary
+
+function values = evaluateFit(fit, x)
+% EVALUATEFIT the piecewise Chebyshev sum of fit at every point of x, NaN outside its edges
+    values  = NaN(size(x));
+    piece   = discretize(x, fit.Edges);
+    inside  = ~isnan(piece);
+    piece   = piece(inside);
+    xInside = x(inside);
+    lo      = fit.Edges(piece);
+    hi      = fit.Edges(piece + 1);
+    local   = (2 * xInside(:) - lo(:) - hi(:)) ./ (hi(:) - lo(:));
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % Clenshaw's recurrence over the degree, vectorized over the points with %
+    % the coefficients of each point's piece                                 %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    coeffs = fit.Coeffs;
+    b1 = zeros(size(local));
+    b2 = b1;
+    for jx = size(coeffs, 1):-1:2
+        [b1, b2] = deal(2 * local .* b1 - b2 + coeffs(jx, piece)', b1);
+    end
+    sums = local .* b1 - b2 + coeffs(1, piece)';
+    if fit.IsLog
+        sums = exp(sums);
+    end
+    values(inside) = sums;
+end % end function evaluateFit
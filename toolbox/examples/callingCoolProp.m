@@ -111,6 +111,15 @@ disp("h_max = " + num2str(h_max));
 % h_min = 97296.6733
 % h_max = 650989.485
 
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% Get R410A from pressure and enthalpy (HmassP_INPUTS in the AbstractState), back at the T of h_max: %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+props = getTransportProperties(libLoc, "T", 'P', 800000, 'H', h_max, 'R410A', 1, keepLibraryLoaded=true);
+assert(abs(props.T - T_max) < 1e-6 * T_max, "The P-H state of R410A is not at T_max.");
+disp("T = " + num2str(props.T) + newline);
+% output is given as:
+% T = 500
+
 %%%%%%%%%%%%%%%%%%%%%%
 % unload the library %
 %%%%%%%%%%%%%%%%%%%%%%
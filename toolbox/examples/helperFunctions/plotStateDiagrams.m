@@ -1,4 +1,4 @@
-% Copyright 2025 The MathWorks, Inc.
+% Copyright 2025 - 2026 The MathWorks, Inc.
 
 function [hfig_PH, hfig_TS] = plotStateDiagrams(libLoc, Fluid, P_min, P_max, H_min, H_max, P_unit, H_unit, T_unit, showContourLabels)
 % Plot PH & TS Diagrams in custom units
@@ -36,7 +36,8 @@ end
     P_vec = 10.^linspace(log10(P_min), log10(P_max), 200);  %   Pa, pressure vector
     [H_grid, P_grid] = meshgrid(H_vec, P_vec);              % enthalpy-pressure grid
     if contains(libLoc, 'refprop', 'IgnoreCase', true)
-        T_contr = getFluidProperty(libLoc, 'T', 'H', H_vec, 'P', P_vec, Fluid, 1, 1, 'MASS BASE SI');  % K, temperature contour data
+        T_contr = getFluidProperty(libLoc, 'T', 'H', H_vec, 'P', P_vec, Fluid, 1, 1, 'MASS BASE SI',...
+                                   DomainCheck=true);  % K, temperature contour data, NaN outside the EOS domain
     elseif contains(libLoc, 'coolprop', 'IgnoreCase', true)
         T_contr = getFluidProperty(libLoc, 'T', 'Hmass', H_vec, 'P', P_vec, Fluid, 1, keepLibraryLoaded=true);  % K, temperature contour data
     end % end if REFPROP, else CoolProp
@@ -77,7 +78,8 @@ end
     [S_grid, T_grid] = meshgrid(S_vec, T_vec);
     warning off
     if contains(libLoc, 'refprop', 'IgnoreCase', true)
-        P_contr = getFluidProperty(libLoc, 'P', 'S', S_vec, 'T', T_vec, Fluid, 1, 1, 'MASS BASE SI');  % Pa
+        P_contr = getFluidProperty(libLoc, 'P', 'S', S_vec, 'T', T_vec, Fluid, 1, 1, 'MASS BASE SI',...
+                                   DomainCheck=true);  % Pa, NaN outside the EOS domain
     elseif contains(libLoc, 'coolprop', 'IgnoreCase', true)
         P_contr = getFluidProperty(libLoc, 'P', 'Smass', S_vec, 'T', T_vec, Fluid, 1, keepLibraryLoaded=true);  % Pa
     end % end if REFPROP, else CoolProp
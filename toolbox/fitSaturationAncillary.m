@@ -0,0 +1,236 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% ancillary = (struct) piecewise Chebyshev approximants of the saturation properties of the fluid, pass it to
+%                      evaluateSaturationAncillary. The field MaxError holds the largest error found for each property
+%                      at the check points, TRange the temperatures the approximants cover
+%
+% [INPUTS]:
+% libraryLocation   = (string) the location of the REFPROP or CoolProp library files (dll, exe, etc.)
+% fluid             = (string) indicating the fluid, e.g., "R134a", "R32;R125"
+% fluidComposition  = (double) array of size 1xnumSpec species fraction where 1 <= numSpec <= 20, whose values must
+%                              sum to 1; numSpec must match the number of species in the fluid
+% massOrMolar       = [REFPROP only] (int) value to determine input composition units: 0 -> Molar, 1 -> Mass
+% Tolerance         = [optional (name, value) pair] (double) largest error accepted, relative to the value for P, T
+%                                                            and D and to the largest magnitude along the saturation
+%                                                            line for H and S, defaults to 1e-6
+% Degree            = [optional (name, value) pair] (double) degree of the Chebyshev polynomial of each piece,
+%                                                            defaults to 12
+% CriticalMargin    = [optional (name, value) pair] (double) the approximants stop at (1 - CriticalMargin)*Tcrit,
+%                                                            where the saturation curves become singular, defaults
+%                                                            to 0.01. Closer to the critical point
+%                                                            evaluateSaturationAncillary calls the library
+% TRange            = [optional (name, value) pair] (double) 1x2 temperature range to fit (K), defaults to the
+%                                                            triple point (Tmin for mixtures) to the critical margin
+% CacheFile         = [optional (name, value) pair] (string) .mat file to load the approximants from, or to save
+%                                                            them to when it does not hold this fit, defaults to ""
+%                                                            -> not kept on disk
+% keepLibraryLoaded = [CoolProp optional (name, value) pair] (logical) see getFluidProperty
+%
+% Each property is fitted as a function of T, and T itself as a function of log(P), on pieces that are halved until
+% the polynomial interpolating the library at the Chebyshev points of a piece agrees with the library within
+% Tolerance at the points halfway between them, up to 1024 pieces. If that is not enough, the pieces are kept, a
+% warning names the range and MaxError exceeds Tolerance. P is fitted as log(P). The liq properties are those at the
+% bubble point and the vap properties those at the dew point, which are the same for pure fluids. The fit is cached
+% for each library, fluid, composition and setting for the rest of the MATLAB session. To empty the cache type
+% clear fitSaturationAncillary in the MATLAB command line.
+%
+% EXAMPLES:
+%    libLoc = 'C:\Program Files (x86)\REFPROP\';
+%
+%    Fit R134a once, then evaluate saturation pressures and temperatures without calling REFPROP:
+%    anc  = fitSaturationAncillary(libLoc, "R134a", CacheFile="R134a_sat.mat");
+%    Psat = evaluateSaturationAncillary(anc, "Pliq", "T", 250:0.01:350);
+%    Tsat = evaluateSaturationAncillary(anc, "Tliq", "P", [2e5, 5e5, 1e6]);
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function ancillary = fitSaturationAncillary(libraryLocation, fluid, fluidComposition, massOrMolar, opts)
+    arguments
+        libraryLocation        (1, :) {mustBeText}
+        fluid                  (1, :) string
+        fluidComposition       (1, :) double  = 1;
+        massOrMolar            (1, 1) double  = 1;
+        opts.Tolerance         (1, 1) double {mustBePositive} = 1e-6;
+        opts.Degree            (1, 1) double {mustBeInteger, mustBeGreaterThanOrEqual(opts.Degree, 2)} = 12;
+        opts.CriticalMargin    (1, 1) double {mustBeNonnegative, mustBeLessThan(opts.CriticalMargin, 1)} = 0.01;
+        opts.TRange                   double = [];
+        opts.CacheFile         (1, :) {mustBeText} = "";
+        opts.keepLibraryLoaded (1, 1) logical = false;
+    end
+
+    persistent ancillaryCache
+    if isempty(ancillaryCache)
+        ancillaryCache = containers.Map('KeyType', 'char', 'ValueType', 'any');
+    end
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % one cache entry per library, fluid, composition (and its basis) and fit settings %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    isRefprop = contains(libraryLocation, "REFPROP", "IgnoreCase", true);
+    cacheKey  = char(strjoin([string(libraryLocation), fluid, string(num2str(fluidComposition, 17)),...
+                              string(massOrMolar * isRefprop), string(num2str([opts.Tolerance, opts.Degree,...
+                              opts.CriticalMargin, opts.TRange], 17))], "|"));
+    if isKey(ancillaryCache, cacheKey)
+        ancillary = ancillaryCache(cacheKey);
+        return
+    end
+    if (strlength(opts.CacheFile) > 0) && isfile(opts.CacheFile)
+        stored = load(opts.CacheFile, "ancillary");
+        if isfield(stored, "ancillary") && strcmp(stored.ancillary.Key, cacheKey)
+            ancillary = stored.ancillary;
+            ancillaryCache(cacheKey) = ancillary;
+            return
+        end
+    end
+
+    ancillary = struct("Key", cacheKey, "Library", char(libraryLocation), "Fluid", fluid,...
+                       "Composition", fluidComposition, "MassOrMolar", massOrMolar,...
+                       "KeepLibraryLoaded", opts.keepLibraryLoaded, "Tolerance", opts.Tolerance,...
+                       "Tcrit", NaN, "Pcrit", NaN, "TRange", opts.TRange, "Fits", struct(), "MaxError", struct());
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % from the triple point, or Tmin, to the margin below the critical point %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    info = getFluidInfo(libraryLocation, fluid, fluidComposition, massOrMolar,...
+                        keepLibraryLoaded=opts.keepLibraryLoaded);
+    ancillary.Tcrit = info.Tcrit;
+    ancillary.Pcrit = info.Pcrit;
+    if isempty(ancillary.TRange)
+        Tlow = info.Ttriple;
+        if isnan(Tlow)
+            Tlow = info.Tmin;
+        end
+        ancillary.TRange = [Tlow, (1 - opts.CriticalMargin) * info.Tcrit];
+    end
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % the properties along T first, then T along log(P) between the pressures at the ends of TRange %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    for phase = ["liq", "vap"]
+        names = ["P", "D", "H", "S"] + phase;
+        fits  = fitPiecewise(@(T) referenceColumns(ancillary, names, "T", T), ancillary.TRange, names, opts, "T");
+        for nx = 1:numel(names)
+            ancillary.Fits.(names(nx))     = fits(nx);
+            ancillary.MaxError.(names(nx)) = fits(nx).MaxError;
+        end
+
+        PRange = exp(evaluatePiece(fits(1), ancillary.TRange));
+        name   = "T" + phase;
+        fitT   = fitPiecewise(@(logP) referenceColumns(ancillary, name, "P", exp(logP)), log(PRange), name, opts, "P");
+        ancillary.Fits.(name)     = fitT;
+        ancillary.MaxError.(name) = fitT.MaxError;
+    end % end loop over the bubble and dew lines
+
+    ancillaryCache(cacheKey) = ancillary;
+    if strlength(opts.CacheFile) > 0
+        save(opts.CacheFile, "ancillary");
+    end
+end % end function fitSaturationAncillary
+
+function values = referenceColumns(ancillary, names, inputProperty, inputValue)
+% REFERENCECOLUMNS library values of the saturation properties names at inputValue, one column per property
+    values = zeros(numel(inputValue), numel(names));
+    for nx = 1:numel(names)
+        values(:, nx) = saturationReference(ancillary, names(nx), inputProperty, inputValue(:));
+    end
+end % end function referenceColumns
+
+function fits = fitPiecewise(reference, range, names, opts, inputName)
+% FITPIECEWISE Chebyshev pieces over range, shared by the properties names, halved until all are within tolerance.
+% inputName is the input the properties are fitted along, "T", or "P" for a range of log(P)
+    degree  = opts.Degree;
+    nodes   = cos(pi * (0:degree)' / degree);             % Chebyshev points of the second kind on [-1, 1]
+    checks  = cos(pi * ((0:(degree - 1))' + 0.5) / degree); % halfway between them
+    basis   = cos(pi * (0:degree)' * (0:degree) / degree);
+    weights = [0.5; ones(degree - 1, 1); 0.5];
+    isLog   = startsWith(names, "P");
+    isScale = startsWith(names, ["H", "S"]);
+    maxPieces = 2^10;
+
+    pending  = range(:)';
+    accepted = zeros(0, 2);
+    coeffs   = cell(0, 1);
+    errors   = zeros(0, numel(names));
+    missed   = zeros(0, 3);                                  % pieces accepted at maxPieces above Tolerance
+    scale    = [];
+    while ~isempty(pending)
+        lo = pending(1, 1);
+        hi = pending(1, 2);
+        pending(1, :) = [];
+
+        x    = (lo + hi) / 2 + (hi - lo) / 2 * [nodes; checks];
+        vals = reference(x);
+        if ~all(isfinite(vals(:)))
+            error("The library failed on the saturation line of %s between %g and %g. Narrow TRange.",...
+                  strjoin(names, ", "), lo, hi);
+        end
+        if isempty(scale)
+            scale = max(abs(vals), [], 1);
+        end
+        fitVals = vals;
+        fitVals(:, isLog) = log(fitVals(:, isLog));
+
+        c = (2 / degree) * basis * (weights .* fitVals(1:(degree + 1), :));
+        c([1, end], :) = c([1, end], :) / 2;
+        approx = chebyshevSum(c, checks);
+        approx(:, isLog) = exp(approx(:, isLog));
+
+        ref = vals((degree + 2):end, :);
+        den = abs(ref);
+        den(:, isScale) = repmat(scale(isScale), size(den, 1), 1);
+        err = max(abs(approx - ref) ./ den, [], 1);
+
+        if all(err <= opts.Tolerance) || (size(accepted, 1) + size(pending, 1) >= maxPieces)
+            if any(err > opts.Tolerance)
+                missed(end + 1, :) = [lo, hi, max(err)]; %#ok<AGROW>
+            end
+            accepted(end + 1, :) = [lo, hi]; %#ok<AGROW>
+            coeffs{end + 1, 1}   = c;        %#ok<AGROW>
+            errors(end + 1, :)   = err;      %#ok<AGROW>
+        else
+            pending = [pending; lo, (lo + hi) / 2; (lo + hi) / 2, hi]; %#ok<AGROW>
+        end
+    end % end loop over pieces
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % at maxPieces the remaining pieces are kept as they are, MaxError holds their error and the caller is told %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    if ~isempty(missed)
+        missedRange = [min(missed(:, 1)), max(missed(:, 2))];
+        if inputName == "P"
+            missedRange = exp(missedRange);
+        end
+        warning("The fit of %s reached %d pieces with an error of up to %g, above the Tolerance of %g, " +...
+                "between %s = %g and %g. Increase Degree or narrow TRange.", strjoin(names, ", "), maxPieces,...
+                max(missed(:, 3)), opts.Tolerance, inputName, missedRange(1), missedRange(2));
+    end
+
+    [~, order] = sort(accepted(:, 1));
+    edges  = [accepted(order, 1); accepted(order(end), 2)]';
+    coeffs = cat(3, coeffs{order});
+    fits   = struct("Edges", edges, "Coeffs", reshape(num2cell(permute(coeffs, [1, 3, 2]), [1, 2]), 1, []),...
+                    "IsLog", num2cell(isLog), "MaxError", num2cell(max(errors, [], 1)));
+end % end function fitPiecewise
+
+function values = evaluatePiece(fit, x)
+% EVALUATEPIECE value of a fitted property at x inside its edges
+    piece  = discretize(x, fit.Edges);
+    lo     = fit.Edges(piece);
+    hi     = fit.Edges(piece + 1);
+    local  = (2 * x - lo - hi) ./ (hi - lo);
+    values = zeros(size(x));
+    for px = 1:numel(x)
+        values(px) = chebyshevSum(fit.Coeffs(:, piece(px)), local(px));
+    end
+end % end function evaluatePiece
+
+function values = chebyshevSum(c, x)
+% CHEBYSHEVSUM sum of c(j+1, :) * T_j(x) over j at each point of the column x, by Clenshaw's recurrence
+    b1 = zeros(numel(x), size(c, 2));
+    b2 = b1;
+    for jx = size(c, 1):-1:2
+        [b1, b2] = deal(2 * x .* b1 - b2 + c(jx, :), b1);
+    end
+    values = x .* b1 - b2 + c(1, :);
+end % end function chebyshevSum
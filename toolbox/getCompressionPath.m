@@ -0,0 +1,102 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% outlet    = (table) (Kx9) one row per operating point with variables P (Pa), H (J/kg), T (K), S (J/(kg K)),
+%                     D (kg/m^3) and Q (kg/kg) of the outlet state, Head (J/kg) (polytropic head, the integral of
+%                     v dp, or with Efficiency="isentropic" the isentropic head), Work (J/kg) (enthalpy rise over the
+%                     stages) and IntercoolerHeat (J/kg) (heat removed between stages, negative for reheat). Head and
+%                     Work are negative for expansion. Rows REFPROP could not march to the outlet are NaN. Q is
+%                     -998 for liquid, 998 for vapor and 999 above the critical pressure, as REFPROP reports
+%                     single-phase states
+% statePath = (double) (numStages*(NumSteps+1))x6xK array, page k is the path of operating point k with columns P,
+%                      H, T, S, D and Q in the units of outlet. Each stage has its inlet and NumSteps nodes, the inlet
+%                      of a stage after the first is the intercooler outlet
+%
+% [INPUTS]:
+% libraryLocation = (string) the location of the REFPROP library files
+% fluid           = (string) indicating the fluid, e.g., "CO2", "R1234ze(E)", "R32;R125"
+% inletPressure   = (double) (Kx1) array of inlet pressures in Pa, or one for all operating points
+% inletValue      = (double) (Kx1) array of inlet temperatures in K (or enthalpies in J/kg with InletProperty="H"),
+%                            or one for all operating points
+% outletPressure  = (double) (Kx1) array of outlet pressures in Pa, or one for all operating points. Above the inlet
+%                            pressure the path is a compression, below it an expansion
+% efficiency      = (double) (Kx1) array of efficiencies in (0, 1], or one for all operating points
+% fluidComposition = (double) array of size 1xnumSpec species fraction, defaults to 1
+% massOrMolar     = (int) value to determine input composition units: 0 -> Molar, 1 -> Mass
+% InletProperty   = [optional (name, value) pair] (string) "T" (default) or "H", the property of inletValue
+% Efficiency      = [optional (name, value) pair] (string) "polytropic" (default) or "isentropic" per stage
+% NumSteps        = [optional (name, value) pair] (double) pressure steps per stage, defaults to 100
+% NumStages       = [optional (name, value) pair] (double) stages of equal pressure ratio, defaults to 1
+% IntercoolTemperature = [optional (name, value) pair] (double) temperature in K the fluid is brought to at the
+%                                                              outlet pressure of each stage but the last, defaults
+%                                                              to NaN -> no intercooling
+%
+% Every operating point is marched from its inlet to its outlet pressure in NumSteps steps of equal pressure ratio
+% per stage by compressionMexC, which loads REFPROP and sets the fluid once for the whole batch. Each single-phase
+% node is solved from the previous node's temperature and density rather than by a new flash. The polytropic path
+% is integrated by Heun's method, so its error falls with the square of NumSteps.
+%
+% EXAMPLES:
+%    libLoc = 'C:\Program Files (x86)\REFPROP\';
+%
+%    Polytropic CO2 compression from 3.5 MPa and 300 K to 8, 9 and 10 MPa at 82 % polytropic efficiency:
+%    [outlet, statePath] = getCompressionPath(libLoc, "CO2", 3.5e6, 300, [8e6; 9e6; 10e6], 0.82);
+%    plot(squeeze(statePath(:, 4, :)), squeeze(statePath(:, 3, :)))
+%
+%    Three-stage air compression to 2 MPa with intercooling to 305 K:
+%    outlet = getCompressionPath(libLoc, "Nitrogen;Oxygen;Argon", 1e5, 293.15, 2e6, 0.85, [0.7812, 0.2096, 0.0092],...
+%                                0, NumStages=3, IntercoolTemperature=305);
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function [outlet, statePath] = getCompressionPath(libraryLocation, fluid, inletPressure, inletValue, outletPressure,...
+                                             efficiency, fluidComposition, massOrMolar, opts)
+    arguments
+        libraryLocation           (1, :) {mustBeText}
+        fluid                     (1, :) string
+        inletPressure             (:, 1) double {mustBePositive}
+        inletValue                (:, 1) double
+        outletPressure            (:, 1) double {mustBePositive}
+        efficiency                (:, 1) double {mustBePositive, mustBeLessThanOrEqual(efficiency, 1)}
+        fluidComposition          (1, :) double = 1;
+        massOrMolar               (1, 1) double = 0;
+        opts.InletProperty        (1, 1) string {mustBeMember(opts.InletProperty, ["T", "H"])} = "T";
+        opts.Efficiency           (1, 1) string {mustBeMember(opts.Efficiency, ["polytropic", "isentropic"])} =...
+                                                 "polytropic";
+        opts.NumSteps             (1, 1) double {mustBeInteger, mustBePositive} = 100;
+        opts.NumStages            (1, 1) double {mustBeInteger, mustBePositive} = 1;
+        opts.IntercoolTemperature (1, 1) double = NaN;
+    end
+
+    if ~contains(libraryLocation, "REFPROP", "IgnoreCase", true)
+        error("getCompressionPath is only available with the REFPROP library.");
+    end
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % rows of inlet P, inlet H, outlet P and efficiency, as compressionMexC expects %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    columns = {inletPressure, inletValue, outletPressure, efficiency};
+    sizes   = cellfun(@numel, columns);
+    numPts  = max(sizes);
+    if any((sizes ~= 1) & (sizes ~= numPts))
+        error("inletPressure, inletValue, outletPressure and efficiency must have 1 or %d elements.", numPts);
+    end
+    points = zeros(numPts, 4);
+    for cx = 1:4
+        points(:, cx) = columns{cx};
+    end % end loop over columns
+    Composition = validateRefpropInputs(char(fluid), fluidComposition, char(libraryLocation));
+    if opts.InletProperty == "T"
+        points(:, 2) = getFluidPropertyBatch(libraryLocation, "H", "T", points(:, 2), "P", points(:, 1), fluid,...
+                                             fluidComposition, massOrMolar, "MASS BASE SI");
+    end
+
+    [statePath, summary] = compressionMexC(char(fluid), Composition, massOrMolar, points, opts.NumSteps,...
+                                           opts.NumStages, opts.IntercoolTemperature,...
+                                           double(opts.Efficiency == "polytropic"), char(libraryLocation));
+
+    names  = ["P", "H", "T", "S", "D", "Q", "Head", "Work", "IntercoolerHeat"];
+    units  = ["Pa", "J/kg", "K", "J/(kg K)", "kg/m^3", "kg/kg", "J/kg", "J/kg", "J/kg"];
+    outlet = array2table([reshape(statePath(end, :, :), 6, numPts)', summary], VariableNames=names);
+    outlet.Properties.VariableUnits = units;
+end % end function getCompressionPath
@@ -0,0 +1,170 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% stateTables = (cell)   (Kx1) array of 8x5 tables, one per design, with variables P (Pa), H (J/kg), S (J/(kg K)),
+%                        T (K) and Q (kg/kg) for the 8 states of the single-stage cycle used in
+%                        designCycleSingle_REFPROP.m and designCycleSingle_CoolProp.m
+% COP         = (double) (Kx1) array of cooling coefficients of performance (h1 - h6) / (h2 - h1)
+% capacity    = (double) (Kx1) array of specific cooling capacities h1 - h6 in J/kg
+% states      = (double) (8x5xK) array holding the same values as stateTables
+%
+% [INPUTS]:
+% libraryLocation  = (string) the location of the REFPROP or CoolProp library files (dll, exe, etc.)
+% fluid            = (string) indicating the refrigerant, e.g., "R134a", "R32;R125"
+% designs          = (double) (Kx5) array, one design per row, with columns (all temperatures in K):
+%                             T_sat_evap - saturated evaporating temperature
+%                             T_sat_cond - saturated condensing temperature
+%                             T_sc       - subcooling at the condenser outlet
+%                             T_sh       - superheat at the evaporator outlet
+%                             eta_s      - compressor isentropic efficiency
+%                    or a table with variables of those names
+% fluidComposition = (double) array of size 1xnumSpec species fraction where 1 <= numSpec <= 20, whose values must
+%                             sum to 1; numSpec must match the number of species in the fluid
+% massOrMolar      = [REFPROP only] (int) value to determine input composition units: 0 -> Molar, 1 -> Mass
+% UseParallel      = [optional (name, value) pair] (logical) defaults to false -> evaluate every design in this
+%                                                            MATLAB session
+%                                                    true -> split the designs over the workers of the current
+%                                                            parallel pool (requires Parallel Computing Toolbox)
+% keepLibraryLoaded = [CoolProp optional (name, value) pair] (logical) see getFluidProperty
+%
+% With REFPROP the designs are evaluated by cycleMexC, which loads REFPROP and sets the fluid once for the whole
+% batch rather than once per state point. REFPROP keeps its state in global memory, so designs are evaluated in
+% parallel across the process workers of a parallel pool rather than across threads.
+%
+% EXAMPLES:
+%    libLoc = 'C:\Program Files (x86)\REFPROP\';
+%
+%    Sweep the evaporating temperature of the R134a cycle from designCycleSingle_REFPROP.m:
+%    T_evap  = (268.15:1:283.15)';
+%    designs = [T_evap, repmat([333.15, 5, 5, 0.6], numel(T_evap), 1)];
+%    [stateTables, COP, capacity] = getCycleStates(libLoc, "R134a", designs);
+%
+%    Same sweep as a table, evaluated on a parallel pool:
+%    designs = table(T_evap, repmat(333.15, size(T_evap)), repmat(5, size(T_evap)), repmat(5, size(T_evap)),...
+%                    repmat(0.6, size(T_evap)), VariableNames=["T_sat_evap", "T_sat_cond", "T_sc", "T_sh", "eta_s"]);
+%    [~, COP] = getCycleStates(libLoc, "R134a", designs, UseParallel=true);
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function [stateTables, COP, capacity, states] = getCycleStates(libraryLocation, fluid, designs, fluidComposition,...
+                                                               massOrMolar, opts)
+    arguments
+        libraryLocation        (1, :) {mustBeText}
+        fluid                  (1, :) string
+        designs                       {mustBeA(designs, ["double", "table"])}
+        fluidComposition       (1, :) double  = 1;
+        massOrMolar            (1, 1) double  = 1;
+        opts.UseParallel       (1, 1) logical = false;
+        opts.keepLibraryLoaded (1, 1) logical = false;
+    end
+
+    designNames = ["T_sat_evap", "T_sat_cond", "T_sc", "T_sh", "eta_s"];
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % accept either a table or a Kx5 array of designs %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    if istable(designs)
+        designs = designs{:, designNames};
+    end
+    if size(designs, 2) ~= numel(designNames)
+        error("designs must have %d columns: %s. Currently, it has %d columns.", numel(designNames),...
+              strjoin(designNames, ", "), size(designs, 2));
+    end
+    numDesigns = size(designs, 1);
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % split the designs into one chunk per worker, parfor runs serially with zero %
+    % workers so the same loop is used whether or not a pool is requested         %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    if opts.UseParallel
+        pool       = gcp;
+        numChunks  = max(1, min(pool.NumWorkers, numDesigns));
+        maxWorkers = pool.NumWorkers;
+    else
+        numChunks  = 1;
+        maxWorkers = 0;
+    end
+    chunkEdges = round(linspace(0, numDesigns, numChunks + 1));
+
+    isRefprop   = contains(libraryLocation, "REFPROP", "IgnoreCase", true);
+    Composition = [];
+    if isRefprop
+        Composition = validateRefpropInputs(char(fluid), fluidComposition, char(libraryLocation));
+    end
+
+    chunkStates = cell(numChunks, 1);
+    chunkPerf   = cell(numChunks, 1);
+    parfor (cx = 1:numChunks, maxWorkers)
+        chunkDesigns = designs((chunkEdges(cx) + 1):chunkEdges(cx + 1), :); %#ok<PFBNS>
+        if isRefprop
+            [chunkStates{cx}, chunkPerf{cx}] = cycleMexC(char(fluid), massOrMolar, Composition, chunkDesigns,...
+                                                         char(libraryLocation));
+        else
+            [chunkStates{cx}, chunkPerf{cx}] = cycleCoolProp(libraryLocation, fluid, fluidComposition,...
+                                                             chunkDesigns, opts.keepLibraryLoaded);
+        end % end if REFPROP, else CoolProp
+    end % end loop over chunks of designs
+
+    states = cat(3, chunkStates{:});
+    perf   = cat(1, chunkPerf{:});
+    COP      = perf(:, 1);
+    capacity = perf(:, 2);
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % one state table per design, SI units %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    stateTables = cell(numDesigns, 1);
+    for dx = 1:numDesigns
+        stateTables{dx} = array2table(states(:, :, dx), VariableNames=["P", "H", "S", "T", "Q"]);
+        stateTables{dx}.Properties.VariableUnits = ["Pa", "J/kg", "J/(kg K)", "K", "kg/kg"];
+    end % end loop over designs
+end % end function getCycleStates
+
+function [states, perf] = cycleCoolProp(libraryLocation, fluid, fluidComposition, designs, keepLibraryLoaded)
+% same state sequence as designCycleSingle_CoolProp.m, with the library loaded once for all designs
+    cpObj = MLCoolProp(libraryLocation, keepLibraryLoaded);
+    cpVal = @(outputVar, in1, val1, in2, val2) cpObj.getCoolPropValues(outputVar, in1, val1, in2, val2, fluid,...
+                                                                       fluidComposition);
+
+    numDesigns = size(designs, 1);
+    states     = zeros(8, 5, numDesigns);
+    perf       = zeros(numDesigns, 4);
+    for dx = 1:numDesigns
+        T_sat_evap = designs(dx, 1);
+        T_sat_cond = designs(dx, 2);
+        T_sc       = designs(dx, 3);
+        T_sh       = designs(dx, 4);
+        eta_s      = designs(dx, 5);
+
+        P = zeros(1, 8);
+        H = zeros(1, 8);
+        S = zeros(1, 8);
+        T = zeros(1, 8);
+        Q = [1, 1, 1, 0, 0, 0, 1, 1];
+
+        P(1)       = cpVal('P', 'Q', 1, 'T', T_sat_evap);
+        P(2)       = cpVal('P', 'Q', 1, 'T', T_sat_cond);
+        P([3 4 5]) = P(2);
+        P([6 7 8]) = P(1);
+
+        H(1) = cpVal('Hmass', 'P', P(1), 'T', T_sat_evap + T_sh);
+        S(1) = cpVal('Smass', 'P', P(1), 'Hmass', H(1));
+        H(2) = cpVal('Hmass', 'P', P(2), 'Smass', S(1));
+        H(2) = (H(2) - H(1)) / eta_s + H(1);
+        H(3) = cpVal('Hmass', 'P', P(3), 'Q', 1);
+        H(4) = cpVal('Hmass', 'P', P(4), 'Q', 0);
+        H(5) = cpVal('Hmass', 'P', P(5), 'T', T_sat_cond - T_sc);
+        H(6) = H(5);
+        H(7) = cpVal('Hmass', 'P', P(7), 'Q', 1);
+        H(8) = H(1);
+
+        for sx = 1:8
+            T(sx) = cpVal('T',     'P', P(sx), 'Hmass', H(sx));
+            S(sx) = cpVal('Smass', 'P', P(sx), 'Hmass', H(sx));
+        end % end loop over states
+        Q(6) = cpVal('Q', 'P', P(6), 'Hmass', H(6));
+
+        states(:, :, dx) = [P; H; S; T; Q]';
+        perf(dx, :)      = [(H(1) - H(6)) / (H(2) - H(1)), H(1) - H(6), H(2) - H(1), H(2) - H(5)];
+    end % end loop over designs
+end % end function cycleCoolProp
@@ -0,0 +1,134 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% props = (struct) one field per requested property (named as requested, made a valid MATLAB name) followed by one
+%                  field per requested derivative, e.g. "dH/dP|T" -> dH_dP_T. Each field is an MxN array, where M is
+%                  the number of values for inputProperty1 and N is the number of values for inputProperty2, or a Kx1
+%                  array when Zipped is true
+%
+% [INPUTS]:
+% libraryLocation       = (string) the location of the REFPROP or CoolProp library files (dll, exe, etc.)
+% requestedProperties   = (string) array of thermodynamic property names returned from the same flash as the
+%                                  derivatives, e.g., ["H", "S"] for REFPROP, ["Hmass", "Smass"] for CoolProp; may be
+%                                  empty
+% requestedDerivatives  = (string) array of first partial derivatives given as "da/db|c", where a, b and c are one of
+%                                  T (K), P (Pa), D (kg/m^3), H (J/kg), S (J/(kg K)) or E (internal energy, J/kg),
+%                                  e.g., ["dH/dP|T", "dD/dT|P", "dT/dH|P"]
+% inputProperty1        = (string) name of the 1st property used as the state point
+% inputProperty1Value   = (double) (1xM) array of values of the 1st property in SI units (K, Pa, kg/m^3, J/kg)
+% inputProperty2        = (string) name of the 2nd property used as the state point
+% inputProperty2Value   = (double) (1xN) array of values of the 2nd property in SI units (K, Pa, kg/m^3, J/kg)
+% fluid                 = (string) indicating the fluid, e.g., "Water", "R32;R125"
+% fluidComposition      = (double) array of size 1xnumSpec species fraction where 1 <= numSpec <= 20, whose values
+%                                  must sum to 1; numSpec must match the number of species in the fluid
+% massOrMolar           = [REFPROP only] (int) value to determine input composition units: 0 -> Molar, 1 -> Mass
+% Zipped                = [optional (name, value) pair] (logical) defaults to false -> every pair of input values
+%                                                                         true  -> inputProperty1Value(k) with
+%                                                                                  inputProperty2Value(k) only
+% keepLibraryLoaded     = [CoolProp optional (name, value) pair] (logical) see getFluidProperty
+%
+% Each state point is flashed once and every derivative is evaluated analytically on the solved state (THERM2dll
+% for REFPROP, AbstractState_first_partial_deriv for CoolProp), which is both faster and more accurate than finite
+% differences of getFluidProperty calls when building a solver Jacobian.
+% All values are in SI units (MASS BASE SI for REFPROP). The derivatives are single-phase derivatives and are NaN for
+% two-phase states.
+%
+% EXAMPLES:
+%    libLoc = 'C:\Program Files (x86)\REFPROP\';
+%
+%    Isobaric heat capacity and isothermal enthalpy derivative of R134a along a 1 MPa isobar:
+%    props = getFluidDerivatives(libLoc, "H", ["dH/dT|P", "dH/dP|T"], 'T', 300:10:350, 'P', 1e6, "R134a");
+%    props.dH_dT_P
+%
+%    Density derivatives at the states of a pipe discretization:
+%    props = getFluidDerivatives(libLoc, [], ["dD/dP|H", "dD/dH|P"], 'P', P_nodes, 'H', H_nodes, "R134a",...
+%                                Zipped=true);
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function props = getFluidDerivatives(libraryLocation, requestedProperties, requestedDerivatives, inputProperty1,...
+                                     inputProperty1Value, inputProperty2, inputProperty2Value, fluid,...
+                                     fluidComposition, massOrMolar, opts)
+    arguments
+        libraryLocation        (1, :) {mustBeText}
+        requestedProperties    (1, :) string
+        requestedDerivatives   (1, :) string
+        inputProperty1         (1, :) {mustBeText}
+        inputProperty1Value    (1, :) double
+        inputProperty2         (1, :) {mustBeText}
+        inputProperty2Value    (1, :) double
+        fluid                  (1, :) string
+        fluidComposition       (1, :) double  = 1;
+        massOrMolar            (1, 1) double  = 1;
+        opts.Zipped            (1, 1) logical = false;
+        opts.keepLibraryLoaded (1, 1) logical = false;
+    end
+
+    if opts.Zipped && (numel(inputProperty1Value) ~= numel(inputProperty2Value))
+        error("Zipped inputs require inputProperty1Value and inputProperty2Value to have the same number of "...
+              + "elements. Currently, they have %d and %d elements.", numel(inputProperty1Value),...
+              numel(inputProperty2Value));
+    end
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % each derivative "da/db|c" becomes one row [a, b, c] of derivative vars %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    derivTokens = regexp(upper(strrep(requestedDerivatives, " ", "")), "^D([TPDHSE])/D([TPDHSE])\|([TPDHSE])$",...
+                         "tokens", "once");
+    if ~iscell(derivTokens)
+        derivTokens = {derivTokens};
+    end
+    badDeriv = cellfun(@isempty, derivTokens);
+    if any(badDeriv)
+        error("Derivatives must be given as ""da/db|c"" where a, b and c are one of T, P, D, H, S or E. Cannot "...
+              + "read: " + strjoin(requestedDerivatives(badDeriv), ", "));
+    end
+    derivVars = reshape(string([derivTokens{:}]), 3, [])';
+
+    numProp  = numel(requestedProperties);
+    numDeriv = size(derivVars, 1);
+    if opts.Zipped
+        outSize = [numel(inputProperty1Value), 1];
+    else
+        outSize = [numel(inputProperty1Value), numel(inputProperty2Value)];
+    end
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % both libraries return one page per property, then one per derivative %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    if contains(libraryLocation, "REFPROP", "IgnoreCase", true)
+        Composition = validateRefpropInputs(char(fluid), fluidComposition, char(libraryLocation));
+        derivReq    = strjoin(join(derivVars, "", 2)', ";");
+        propVals    = derivativeMexC(char(strjoin(requestedProperties, ";")), char(derivReq),...
+                                     char(string(inputProperty1) + string(inputProperty2)), inputProperty1Value,...
+                                     inputProperty2Value, char(fluid), massOrMolar, Composition,...
+                                     char(libraryLocation), double(opts.Zipped));
+    else
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        % CoolProp names the mass based variables, T and P are as-is %
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        coolpropVars    = ["T", "P", "Dmass", "Hmass", "Smass", "Umass"];
+        [~, derivIndex] = ismember(derivVars, ["T", "P", "D", "H", "S", "E"]);
+
+        if opts.Zipped
+            val1 = inputProperty1Value;
+            val2 = inputProperty2Value;
+        else
+            [val1, val2] = ndgrid(inputProperty1Value, inputProperty2Value);
+        end
+
+        cpObj    = MLCoolProp(libraryLocation, opts.keepLibraryLoaded);
+        vals     = cpObj.getStateDerivatives(requestedProperties, reshape(coolpropVars(derivIndex), [], 3),...
+                                             inputProperty1, val1(:)', inputProperty2, val2(:)', fluid,...
+                                             fluidComposition);
+        propVals = reshape(vals, [outSize, numProp + numDeriv]);
+    end % end if REFPROP, else CoolProp
+
+    fieldNames = [matlab.lang.makeValidName(requestedProperties), "d" + derivVars(:, 1)' + "_d" + derivVars(:, 2)'...
+                  + "_" + derivVars(:, 3)'];
+    fieldNames = matlab.lang.makeUniqueStrings(fieldNames);
+    props = struct();
+    for px = 1:numel(fieldNames)
+        props.(fieldNames(px)) = reshape(propVals(:, :, px), outSize);
+    end % end loop over output properties and derivatives
+end % end function getFluidDerivatives
@@ -0,0 +1,99 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% info = (struct) fixed-point data of the fluid in SI units with the fields:
+%                 molarMass - molar mass (kg/mol)
+%                 Tcrit     - critical temperature (K)
+%                 Pcrit     - critical pressure (Pa)
+%                 rhocrit   - critical density (kg/m^3)
+%                 hcrit     - specific enthalpy at the critical point (J/kg)
+%                 scrit     - specific entropy at the critical point (J/(kg K))
+%                 Ttriple   - triple point temperature (K), NaN for REFPROP mixtures
+%                 Ptriple   - triple point pressure (Pa), NaN for REFPROP mixtures
+%                 Tnbp      - normal boiling point temperature (K), bubble point at 101325 Pa for mixtures
+%                 acentric  - acentric factor (-), NaN for REFPROP mixtures
+%                 Tmin      - minimum temperature of the equation of state (K)
+%                 Tmax      - maximum temperature of the equation of state (K)
+%                 Pmax      - maximum pressure of the equation of state (Pa)
+%                 rhomax    - maximum density of the equation of state (kg/m^3), NaN for CoolProp
+%
+% [INPUTS]:
+% libraryLocation   = (string) the location of the REFPROP or CoolProp library files (dll, exe, etc.)
+% fluid             = (string) indicating the fluid, e.g., "Water", "R32;R125"
+% fluidComposition  = (double) array of size 1xnumSpec species fraction where 1 <= numSpec <= 20, whose values must
+%                              sum to 1; numSpec must match the number of species in the fluid
+% massOrMolar       = [REFPROP only] (int) value to determine input composition units: 0 -> Molar, 1 -> Mass
+% keepLibraryLoaded = [CoolProp optional (name, value) pair] (logical) see getFluidProperty
+%
+% The values are read from the library constants (INFOdll, CRITPdll, LIMITSdll and WMOLdll for REFPROP, Props1SI
+% for CoolProp) rather than from a flash with dummy inputs. They are cached for each library, fluid and composition
+% for the rest of the MATLAB session, so only the first call for a fluid loads the library. To empty the cache type
+% clear getFluidInfo in the MATLAB command line.
+%
+% EXAMPLES:
+%    libLoc = 'C:\Program Files (x86)\REFPROP\';
+%
+%    Critical point of R134a:
+%    info = getFluidInfo(libLoc, "R134a");
+%    [info.Tcrit, info.Pcrit]
+%
+%    Normal boiling point of R410A given as its components on a mass basis:
+%    info = getFluidInfo(libLoc, "R32;R125", [0.5, 0.5], 1);
+%    info.Tnbp
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function info = getFluidInfo(libraryLocation, fluid, fluidComposition, massOrMolar, opts)
+    arguments
+        libraryLocation        (1, :) {mustBeText}
+        fluid                  (1, :) string
+        fluidComposition       (1, :) double  = 1;
+        massOrMolar            (1, 1) double  = 1;
+        opts.keepLibraryLoaded (1, 1) logical = false;
+    end
+
+    persistent infoCache
+    if isempty(infoCache)
+        infoCache = containers.Map('KeyType', 'char', 'ValueType', 'any');
+    end
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % one cache entry per library, fluid and composition (and its basis) %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    isRefprop = contains(libraryLocation, "REFPROP", "IgnoreCase", true);
+    cacheKey  = char(strjoin([string(libraryLocation), fluid, string(num2str(fluidComposition, 17)),...
+                              string(massOrMolar * isRefprop)], "|"));
+    if isKey(infoCache, cacheKey)
+        info = infoCache(cacheKey);
+        return
+    end
+
+    if isRefprop
+        Composition = validateRefpropInputs(char(fluid), fluidComposition, char(libraryLocation));
+        infoVals    = fluidInfoMexC(char(fluid), massOrMolar, Composition, char(libraryLocation));
+    else
+        infoVals = coolPropInfo(libraryLocation, fluid, fluidComposition, opts.keepLibraryLoaded);
+    end % end if REFPROP, else CoolProp
+
+    infoNames = ["molarMass", "Tcrit", "Pcrit", "rhocrit", "hcrit", "scrit", "Ttriple", "Ptriple", "Tnbp",...
+                 "acentric", "Tmin", "Tmax", "Pmax", "rhomax"];
+    info = cell2struct(num2cell(infoVals(:)), cellstr(infoNames), 1);
+
+    infoCache(cacheKey) = info;
+end % end function getFluidInfo
+
+function infoVals = coolPropInfo(libraryLocation, fluid, fluidComposition, keepLibraryLoaded)
+% the same 14 values as fluidInfoMexC, from the CoolProp constants and two flashes
+    cpObj    = MLCoolProp(libraryLocation, keepLibraryLoaded);
+    cpConst  = @(outputVar) cpObj.getCoolPropValues(outputVar, '', [], '', [], fluid, fluidComposition);
+    cpVal    = @(outputVar, in1, val1, in2, val2) cpObj.getCoolPropValues(outputVar, in1, val1, in2, val2, fluid,...
+                                                                          fluidComposition);
+
+    Tcrit   = cpConst('T_critical');
+    rhocrit = cpConst('rhomass_critical');
+
+    infoVals = [cpConst('molar_mass'), Tcrit, cpConst('P_critical'), rhocrit,...
+                cpVal('Hmass', 'T', Tcrit, 'Dmass', rhocrit), cpVal('Smass', 'T', Tcrit, 'Dmass', rhocrit),...
+                cpConst('T_triple'), cpConst('P_triple'), cpVal('T', 'P', 101325, 'Q', 0), cpConst('acentric'),...
+                cpConst('Tmin'), cpConst('Tmax'), cpConst('pmax'), NaN];
+end % end function coolPropInfo
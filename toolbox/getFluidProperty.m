@@ -3,6 +3,11 @@
 % requestedPropertyValue = (double) (MxN) array of values for the requested thermodynamic property as calculated by the 
 %                                   library where M is the number of values for inputProperty1 and N is the number of
 %                                   values for inputProperty2
+% tierInfo               = (struct) [REFPROP only] the accuracy tier used: Tier ("exact", "fast" or "hybrid"),
+%                                   NumPoints and NumRefined, the points re-evaluated with the exact tier
+% pointStatus            = (double) (MxN) array of the status of each point: 0 evaluated, 1 the library failed,
+%                                   [REFPROP only] 2 not selected by Mask, 3 outside the limits of the equation of
+%                                   state, 4 below the melting line; the value is NaN for every status but 0
 % [INPUTS]:                                                                                                        
 % libraryLocation     = (string) the location of the REFPROP or CoolProp library files (dll, exe, etc.)            
 % requestedProperty   = (string) the thermodynamic property name for which the value will be returned              
@@ -32,6 +37,78 @@
 %                                                                                            multiple funciton calls
 %                       NOTE: user should unload the library when finished: in the MATLAB command line type
 %                                                                           unloadlibrary('CoolProp')
+% Server              = [REFPROP optional (name, value) pair] (string) defaults to "" -> load REFPROP in this session
+%                                                                      socket path returned by startPropertyServer ->
+%                                                                      send the request to that server (Linux and
+%                                                                      macOS only)
+% Accuracy            = [REFPROP optional (name, value) pair] (string) defaults to "exact" -> REFPROP's equations of
+%                                                                                           state
+%                                                                      "fast"   -> Peng-Robinson cubic equation of
+%                                                                                  state, for screening runs
+%                                                                      "hybrid" -> "fast", then the points where it
+%                                                                                  failed or RefineMask is true again
+%                                                                                  with "exact"
+% RefineMask          = [REFPROP optional (name, value) pair] (logical) (MxN) array of the points the "hybrid" tier
+%                                                                       re-evaluates with "exact", defaults to none
+%                       NOTE: compareAccuracyTiers measures the speedup and deviation of "fast" on a reference grid
+% InputUnits          = [optional (name, value) pair] (string) (1x2) units of inputProperty1Value and
+%                                                              inputProperty2Value, e.g., ["degC", "bar"], from the
+%                                                              tables of unit_convert_SI; "" for SI units
+% OutputUnit          = [optional (name, value) pair] (string) unit of requestedPropertyValue, e.g., "kJ/kg" or
+%                                                              "kJ/kg/K"; "" for SI units. Enthalpy and entropy
+%                                                              units are per kg, so molar outputs such as Hmolar
+%                                                              are rejected
+%                       NOTE: with InputUnits or OutputUnit, REFPROP flashes in MASS BASE SI (desiredUnits is not
+%                             used) and the values are converted before and after the flash in one vectorized pass
+% Mask                = [REFPROP optional (name, value) pair] (logical) (MxN) array of the points to evaluate, the
+%                                                                       others are NaN, defaults to every point
+% DomainCheck         = [REFPROP optional (name, value) pair] (logical) defaults to false -> evaluate every point
+%                                                                       true -> points of a plain input pair with T,
+%                                                                               P or D outside the limits of the
+%                                                                               equation of state or negative, P with
+%                                                                               Q below the triple-point pressure, or
+%                                                                               T, H or S below the melting (or, under
+%                                                                               the triple-point pressure, the
+%                                                                               sublimation) line at the given P, are
+%                                                                               NaN without calling REFPROP
+% SharedCache         = [REFPROP optional (name, value) pair] (string) defaults to "" -> no cache shared between
+%                                                                                   processes
+%                                                                      name -> look every point up in, and add it to,
+%                                                                              the shared-memory result cache of that
+%                                                                              name, shared by the MATLAB processes on
+%                                                                              this host that use it, e.g., the
+%                                                                              process workers of a parfor loop
+% SharedCacheSize     = [REFPROP optional (name, value) pair] (double) number of results the shared cache holds when
+%                                                                      this call creates it, defaults to 1e6 (64 MB)
+%                       NOTE: the cache is keyed by the REFPROP directory, fluid, composition, units, accuracy tier,
+%                             property names and inputs; a full cache replaces old results rather than growing
+% LeverRule           = [REFPROP optional (name, value) pair] (logical) defaults to false -> one flash per point
+%                                                                       true -> for a pure fluid and an input pair of
+%                                                                               P with H, S, E, D or Q, or of T with
+%                                                                               D or Q, the saturated liquid and
+%                                                                               vapor are evaluated once per P or T
+%                                                                               and the two-phase points get T, P, D,
+%                                                                               E, H, S or Q by the lever rule in the
+%                                                                               quality, e.g., for P-h maps
+% CoolPropBackend     = [CoolProp optional (name, value) pair] (string) defaults to "HEOS" -> CoolProp's equations
+%                                                                                           of state (PropsSI)
+%                                                                       "BICUBIC&HEOS" -> bicubic interpolation in
+%                                                                                         tables built from HEOS
+%                                                                       "TTSE&HEOS"    -> Taylor series extrapolation
+%                                                                                         in tables built from HEOS
+% TableDirectory      = [CoolProp optional (name, value) pair] (string) directory CoolProp saves the tables to and
+%                                                                       loads them from, defaults to "" -> CoolProp's
+%                                                                       ~/.CoolProp/Tables
+% NumThreads          = [CoolProp optional (name, value) pair] (double) defaults to 1 -> points evaluated one after
+%                                                                       another in MATLAB
+%                                                                       N -> points evaluated by N threads, each with
+%                                                                            its own AbstractState (coolpropMexC)
+%                                                                       0 -> one thread per core
+%                       NOTE: the first call for a fluid builds its tables, which can take tens of seconds; use
+%                             buildCoolPropTables beforehand and keepLibraryLoaded=true in simulation loops
+%
+% Calls made between startFluidPropertyTrace and stopFluidPropertyTrace are recorded, with their inputs and timing, to
+% a trace file that replayFluidPropertyTrace replays against another library, backend or accuracy tier.
 %
 % See REFPROP documentation (https://trc.nist.gov/refprop/REFPROP.PDF) and CoolProp documentation 
 % (http://www.coolprop.org/coolprop/HighLevelAPI.html#table-of-string-inputs-to-propssi-function) for allowed values 
@@ -124,17 +201,40 @@
 %    h_min = getFluidProperty(coolPropLib,'H', 'T', T_min, 'P', 800000, 'R410A', 1, keepLibraryLoaded=true);
 %    h_max = getFluidProperty(coolPropLib,'H', 'T', T_max, 'P', 800000, 'R410A', 1, keepLibraryLoaded=true);
 %
+%    interpolate in bicubic tables kept in a project directory - build them once, then keep the library loaded
+%    buildCoolPropTables(coolPropLib, ["Water", "R134a"], TableDirectory="C:\work\tables");
+%    h = getFluidProperty(coolPropLib, 'Hmass', 'T', 300:1:400, 'P', 101325, 'Water', 1, keepLibraryLoaded=true,...
+%                         CoolPropBackend="BICUBIC&HEOS", TableDirectory="C:\work\tables");
+%
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-% Copyright 2019 - 2025 The MathWorks, Inc.
+% Copyright 2019 - 2026 The MathWorks, Inc.
 
 % History:
 %
+% Rev 10: Add the NumThreads option to evaluate CoolProp points on a thread pool.
+%
+% Rev 9: Add the LeverRule option to evaluate two-phase points of pure fluids from their saturation states.
+%
+% Rev 8: Add the SharedCache and SharedCacheSize options for a result cache shared between processes.
+%
+% Rev 7: Record the calls made while a trace started by startFluidPropertyTrace is active.
+%
+% Rev 6: Add the Mask and DomainCheck options and the pointStatus output.
+%
+% Rev 5: Add the CoolPropBackend and TableDirectory options for CoolProp's tabular backends.
+%
+% Rev 4: Add the InputUnits and OutputUnit options, converting around flashes done in SI units.
+%
+% Rev 3: Add the Accuracy and RefineMask options and the tierInfo output.
+%
+% Rev 2: Add the Server option to send REFPROP requests to a running refpropServer.
+%
 % Rev 1: Original version
 % K. McGarrity
 % 29 JAN 2025
 
-function requestedPropertyValue = getFluidProperty(libraryLocation, requestedProperty,... 
+function [requestedPropertyValue, tierInfo, pointStatus] = getFluidProperty(libraryLocation, requestedProperty,... 
                                                    inputProperty1, inputProperty1Value,...
                                                    inputProperty2, inputProperty2Value, fluid,...
                                                    fluidComposition, massOrMolar, desiredUnits,...
@@ -151,6 +251,63 @@ function requestedPropertyValue = getFluidProperty(libraryLocation, requestedPro
         massOrMolar            (1, 1) double       = 0;
         desiredUnits           (1, :) {mustBeText} = "MKS";
         opts.keepLibraryLoaded (1, 1) logical      = false;
+        opts.Server            (1, :) {mustBeText} = "";
+        opts.Accuracy          (1, 1) string {mustBeMember(opts.Accuracy, ["exact", "fast", "hybrid"])} = "exact";
+        opts.RefineMask               logical      = false;
+        opts.InputUnits        (1, 2) string       = ["", ""];
+        opts.OutputUnit        (1, 1) string       = "";
+        opts.CoolPropBackend   (1, 1) string {mustBeMember(opts.CoolPropBackend,...
+                                                           ["HEOS", "BICUBIC&HEOS", "TTSE&HEOS"])} = "HEOS";
+        opts.TableDirectory    (1, :) {mustBeText} = "";
+        opts.NumThreads        (1, 1) double {mustBeInteger, mustBeNonnegative} = 1;
+        opts.Mask                     logical      = true;
+        opts.DomainCheck       (1, 1) logical      = false;
+        opts.SharedCache       (1, :) {mustBeText} = "";
+        opts.SharedCacheSize   (1, 1) double {mustBeInteger, mustBePositive} = 1e6;
+        opts.LeverRule         (1, 1) logical      = false;
+    end
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % a trace records the call as given, before any unit conversion below %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    traceCall = [];
+    if fluidPropertyTrace("isRecording")
+        library   = double(~contains(libraryLocation, "REFPROP", "IgnoreCase", true));
+        library(strlength(opts.Server) > 0) = 2;
+        traceCall = struct("Library", library, "RequestedProperty", string(requestedProperty),...
+                           "InputProperty1", string(inputProperty1), "InputProperty2", string(inputProperty2),...
+                           "Fluid", fluid, "DesiredUnits", string(desiredUnits), "Accuracy", opts.Accuracy,...
+                           "CoolPropBackend", opts.CoolPropBackend, "InputUnits", opts.InputUnits,...
+                           "OutputUnit", opts.OutputUnit, "MassOrMolar", massOrMolar,...
+                           "Composition", fluidComposition, "Values1", inputProperty1Value,...
+                           "Values2", inputProperty2Value, "DomainCheck", opts.DomainCheck, "Timer", tic);
+    end
+
+    localRefprop = contains(libraryLocation, "REFPROP", "IgnoreCase", true) && (strlength(opts.Server) == 0);
+    if (opts.Accuracy ~= "exact") && ~localRefprop
+        error("The " + opts.Accuracy + " accuracy tier is only available when REFPROP is loaded in this session.");
+    end
+    if (~all(opts.Mask, "all") || opts.DomainCheck || (strlength(opts.SharedCache) > 0) || opts.LeverRule) &&...
+            ~localRefprop
+        error("Mask, DomainCheck, SharedCache and LeverRule are only available when REFPROP is loaded in this "...
+              + "session.");
+    end
+    if (opts.CoolPropBackend ~= "HEOS") && contains(libraryLocation, "REFPROP", "IgnoreCase", true)
+        error("CoolPropBackend " + opts.CoolPropBackend + " is only available with the CoolProp library.");
+    end
+    if (opts.NumThreads ~= 1) && contains(libraryLocation, "REFPROP", "IgnoreCase", true)
+        error("NumThreads is only available with the CoolProp library.");
+    end
+    tierInfo = struct("Tier", opts.Accuracy, "NumPoints", numel(inputProperty1Value) * numel(inputProperty2Value),...
+                      "NumRefined", 0);
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % with user units the flash runs in SI and the inputs and output are converted as whole arrays %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    if any(strlength([opts.InputUnits, opts.OutputUnit]) > 0)
+        desiredUnits        = "MASS BASE SI";
+        inputProperty1Value = convertPropertyUnits(inputProperty1Value, inputProperty1, opts.InputUnits(1), 1);
+        inputProperty2Value = convertPropertyUnits(inputProperty2Value, inputProperty2, opts.InputUnits(2), 1);
     end
 
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -162,6 +319,21 @@ function requestedPropertyValue = getFluidProperty(libraryLocation, requestedPro
         %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
         inputProps = string(inputProperty1) + string(inputProperty2);
 
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        % a running refpropServer already has REFPROP loaded, send it the whole request %
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        if strlength(opts.Server) > 0
+            Composition = validateRefpropInputs(char(fluid), fluidComposition, char(libraryLocation));
+            requestedPropertyValue = serverMexC(char(opts.Server), char(requestedProperty), char(inputProps),...
+                                                inputProperty1Value, inputProperty2Value, char(fluid), massOrMolar,...
+                                                Composition, char(desiredUnits), 0);
+            pointStatus            = double(isnan(requestedPropertyValue));
+            requestedPropertyValue = convertPropertyUnits(requestedPropertyValue, requestedProperty,...
+                                                          opts.OutputUnit, -1);
+            recordTrace(traceCall, requestedPropertyValue);
+            return
+        end
+
         %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
         % we can probably remove this input from the function call someday %
         %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -171,18 +343,65 @@ function requestedPropertyValue = getFluidProperty(libraryLocation, requestedPro
         % MLrefprop takes care of all the input value checks, we shouldn't have to do anything %
         % unless we want the user to be able to specify multiple output properties or fluids   %
         %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-        requestedPropertyValue = MLrefprop(requestedProperty, inputProps, inputProperty1Value, inputProperty2Value,...
-                                           fluid, massOrMolar, fluidComposition, desiredUnits, libraryLocation,...
-                                           DebugOutput);
+        model = char(replace(opts.Accuracy, "hybrid", "fast"));
+        mask  = logical.empty;
+        if ~all(opts.Mask, "all")
+            mask = opts.Mask & true(numel(inputProperty1Value), numel(inputProperty2Value));
+        end
+        if (nargout > 2) || ~isempty(mask) || opts.DomainCheck || (strlength(opts.SharedCache) > 0) || opts.LeverRule
+            [requestedPropertyValue, pointStatus] = MLrefprop(requestedProperty, inputProps, inputProperty1Value,...
+                                                              inputProperty2Value, fluid, massOrMolar,...
+                                                              fluidComposition, desiredUnits, libraryLocation,...
+                                                              DebugOutput, model, mask, opts.DomainCheck,...
+                                                              char(opts.SharedCache), opts.SharedCacheSize,...
+                                                              opts.LeverRule);
+        else
+            requestedPropertyValue = MLrefprop(requestedProperty, inputProps, inputProperty1Value,...
+                                               inputProperty2Value, fluid, massOrMolar, fluidComposition,...
+                                               desiredUnits, libraryLocation, DebugOutput, model);
+            pointStatus            = double(isnan(requestedPropertyValue));
+        end
+
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        % hybrid re-evaluates the points the fast tier failed on or the caller selected, exactly %
+        % masked and out-of-domain points stay skipped                                           %
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        if (opts.Accuracy == "hybrid") && ~isempty(requestedPropertyValue)
+            refine = (pointStatus == 1) | (opts.RefineMask & (pointStatus == 0));
+            if any(refine, "all")
+                [val1, val2] = ndgrid(inputProperty1Value, inputProperty2Value);
+                requestedPropertyValue(refine) = getFluidPropertyBatch(libraryLocation, requestedProperty,...
+                                                                       inputProperty1, val1(refine),...
+                                                                       inputProperty2, val2(refine), fluid,...
+                                                                       fluidComposition, massOrMolar, desiredUnits);
+                pointStatus(refine) = double(isnan(requestedPropertyValue(refine)));
+            end
+            tierInfo.NumRefined = nnz(refine);
+        end
     else
         %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
         % shape the output to match REFPROP when given input proprty value arrays, we shouldn't have to do %
         % anything else unless we want the user to be able to specify multiple output properties or fluids %
         %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
         cpObj = MLCoolProp(libraryLocation, opts.keepLibraryLoaded);
+        cpObj.backend    = char(opts.CoolPropBackend);
+        cpObj.numThreads = opts.NumThreads;
+        if strlength(opts.TableDirectory) > 0
+            cpObj.setTableDirectory(opts.TableDirectory);
+        end
 
         requestedPropertyValue = cpObj.getCoolPropValues(requestedProperty, inputProperty1, inputProperty1Value,...
                                                          inputProperty2, inputProperty2Value, fluid, fluidComposition);
+        pointStatus            = double(isnan(requestedPropertyValue));
 
     end % end if REFPROP, else CoolProp
-end % end function getFluidProperty
\ No newline at end of file
+    requestedPropertyValue = convertPropertyUnits(requestedPropertyValue, requestedProperty, opts.OutputUnit, -1);
+    recordTrace(traceCall, requestedPropertyValue);
+end % end function getFluidProperty
+
+function recordTrace(call, values)
+% RECORDTRACE adds the call to the active trace, nothing when none was active as the call started
+    if ~isempty(call)
+        fluidPropertyTrace("record", call, toc(call.Timer), values);
+    end
+end % end function recordTrace
\ No newline at end of file
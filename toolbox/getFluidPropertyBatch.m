@@ -0,0 +1,106 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% values = (double) (Kx1) array, values(k) is requestedProperties(k) at record k, NaN where the library failed
+% status = (double) (Kx1) array, 0 where record k succeeded, else the REFPROP error number (1 for CoolProp)
+%
+% [INPUTS]:
+% libraryLocation     = (string) the location of the REFPROP or CoolProp library files (dll, exe, etc.)
+% requestedProperties = (string) (Kx1) array of the property returned by each record, or a single property for all
+% inputProperty1      = (string) (Kx1) array of the name of the 1st property of each record, or one name for all
+% inputProperty1Value = (double) (Kx1) array of values of the 1st property of each record
+% inputProperty2      = (string) (Kx1) array of the name of the 2nd property of each record, or one name for all
+% inputProperty2Value = (double) (Kx1) array of values of the 2nd property of each record
+% fluid               = (string) indicating the fluid, e.g., "Water", "R32;R125"
+% fluidComposition    = (double) array of size 1xnumSpec species fraction where 1 <= numSpec <= 20, whose values must
+%                                sum to 1; numSpec must match the number of species in the fluid
+% massOrMolar         = [REFPROP only] (int) value to determine input composition units: 0 -> Molar, 1 -> Mass
+% desiredUnits        = [REFPROP only] (char) enum as expected by refprop.dll to determine the units to use
+%                                             e.g., MKS, MASS BASE SI, etc.
+% keepLibraryLoaded   = [CoolProp optional (name, value) pair] (logical) see getFluidProperty
+% CoolPropBackend     = [CoolProp optional (name, value) pair] (string) see getFluidProperty
+% TableDirectory      = [CoolProp optional (name, value) pair] (string) see getFluidProperty
+% NumThreads          = [CoolProp optional (name, value) pair] (double) see getFluidProperty
+%
+% Each record k is the state inputProperty1(k) = inputProperty1Value(k), inputProperty2(k) = inputProperty2Value(k)
+% and returns requestedProperties(k), so a state table mixing TQ, PH, PS and TP flashes costs one call. REFPROP
+% evaluates the records in order with one library load and fluid setup (batchMexC). CoolProp evaluates the records of
+% each input pair together, with one AbstractState update per state point and five requested properties.
+% A record that fails does not stop the others; its value is NaN and its status says why.
+%
+% EXAMPLES:
+%    libLoc = 'C:\Program Files (x86)\REFPROP\';
+%
+%    Evaporator outlet, compressor outlet and condenser outlet of an R134a cycle in one call:
+%    [vals, status] = getFluidPropertyBatch(libLoc, ["H"; "T"; "H"], ["T"; "P"; "P"], [263.15; 1.2e6; 1.2e6],...
+%                                           ["Q"; "S"; "Q"], [1; 1730; 0], "R134a", 1, 1, "MASS BASE SI");
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function [values, status] = getFluidPropertyBatch(libraryLocation, requestedProperties, inputProperty1,...
+                                                  inputProperty1Value, inputProperty2, inputProperty2Value, fluid,...
+                                                  fluidComposition, massOrMolar, desiredUnits, opts)
+    arguments
+        libraryLocation        (1, :) {mustBeText}
+        requestedProperties    (:, 1) string
+        inputProperty1         (:, 1) string
+        inputProperty1Value    (:, 1) double
+        inputProperty2         (:, 1) string
+        inputProperty2Value    (:, 1) double
+        fluid                  (1, :) string
+        fluidComposition       (1, :) double       = 1;
+        massOrMolar            (1, 1) double       = 0;
+        desiredUnits           (1, :) {mustBeText} = "MKS";
+        opts.keepLibraryLoaded (1, 1) logical      = false;
+        opts.CoolPropBackend   (1, 1) string {mustBeMember(opts.CoolPropBackend,...
+                                                           ["HEOS", "BICUBIC&HEOS", "TTSE&HEOS"])} = "HEOS";
+        opts.TableDirectory    (1, :) {mustBeText} = "";
+        opts.NumThreads        (1, 1) double {mustBeInteger, mustBeNonnegative} = 1;
+    end
+
+    numRec = numel(inputProperty1Value);
+    if numel(inputProperty2Value) ~= numRec
+        error("inputProperty1Value and inputProperty2Value must have one value per record. Currently, they have %d "...
+              + "and %d elements.", numRec, numel(inputProperty2Value));
+    end
+    numNames = [numel(requestedProperties), numel(inputProperty1), numel(inputProperty2)];
+    if any((numNames ~= 1) & (numNames ~= numRec))
+        error("requestedProperties, inputProperty1 and inputProperty2 must have 1 or %d elements.", numRec);
+    end
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % REFPROP takes every record in one call, CoolProp one call per input pair %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    if contains(libraryLocation, "REFPROP", "IgnoreCase", true)
+        inputProps = inputProperty1 + inputProperty2;
+        for sx = unique(inputProps)'
+            validateRefpropSpec(char(sx));
+        end % end loop over distinct input pairs
+        Composition = validateRefpropInputs(char(fluid), fluidComposition, char(libraryLocation));
+
+        [values, status] = batchMexC(cellstr(requestedProperties), cellstr(inputProps), inputProperty1Value,...
+                                     inputProperty2Value, char(fluid), massOrMolar, Composition,...
+                                     char(desiredUnits), char(libraryLocation));
+    else
+        requestedProperties = repmat(requestedProperties, numRec / numel(requestedProperties), 1);
+        inputProperty1      = repmat(inputProperty1,      numRec / numel(inputProperty1),      1);
+        inputProperty2      = repmat(inputProperty2,      numRec / numel(inputProperty2),      1);
+
+        values = NaN(numRec, 1);
+        cpObj  = MLCoolProp(libraryLocation, opts.keepLibraryLoaded);
+        cpObj.backend    = char(opts.CoolPropBackend);
+        cpObj.numThreads = opts.NumThreads;
+        if strlength(opts.TableDirectory) > 0
+            cpObj.setTableDirectory(opts.TableDirectory);
+        end
+        [pairs, ~, pairIdx] = unique([inputProperty1, inputProperty2], "rows");
+        for px = 1:size(pairs, 1)
+            recs = find(pairIdx == px);
+            [outNames, ~, outIdx] = unique(requestedProperties(recs));
+            vals = cpObj.getStateValues(outNames', pairs(px, 1), inputProperty1Value(recs)', pairs(px, 2),...
+                                        inputProperty2Value(recs)', fluid, fluidComposition);
+            values(recs) = vals(sub2ind(size(vals), (1:numel(recs))', outIdx));
+        end % end loop over distinct input pairs
+        status = double(isnan(values));
+    end % end if REFPROP, else CoolProp
+end % end function getFluidPropertyBatch
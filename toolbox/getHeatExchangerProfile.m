@@ -0,0 +1,106 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% profile = (struct) with the fields
+%               Hot, Cold    - ((numSegments+1)x7) tables with variables H (J/kg), T (K), Q (kg/kg), D (kg/m^3),
+%                              CP (J/(kg K)), viscosity (Pa s) and conductivity (W/(m K)) at each section. Q is
+%                              -998 for liquid, 998 for vapor and 999 above the critical pressure, as REFPROP
+%                              reports single-phase states. Row k is the k-th section from the hot inlet for both
+%                              streams, so with Flow="counterflow" the cold stream runs from its outlet (row 1) to
+%                              its inlet
+%               DutyFraction - ((numSegments+1)x1) fraction of the duty transferred between the hot inlet and the
+%                              section
+%               Approach     - ((numSegments+1)x1) hot minus cold temperature at each section in K, negative where
+%                              the temperature profiles cross
+% pinch   = (struct) with the fields Index (row of the smallest approach), Approach (the minimum approach
+%                    temperature in K), DutyFraction, THot and TCold at that row
+%
+% [INPUTS]:
+% libraryLocation = (string) the location of the REFPROP library files
+% hotStream       = (struct) with the fields Fluid (string), P (Pa), mdot (kg/s), the inlet state as H (J/kg) or
+%                            T (K), and optionally Composition (double) array of species fractions, defaults to 1
+% coldStream      = (struct) with the same fields for the cold stream
+% duty            = (double) heat transferred from the hot to the cold stream in W
+% numSegments     = (double) number of equal-duty segments the heat exchanger is divided into
+% massOrMolar     = (int) value to determine input composition units: 0 -> Molar, 1 -> Mass
+% Flow            = [optional (name, value) pair] (string) "counterflow" (default) or "parallel"
+%
+% Both streams are marched through the segments by hxMexC in one call, which loads REFPROP once and sets each fluid
+% once. Every single-phase section is solved from the previous section's temperature and density rather than by a
+% new flash, and the transport properties come from the same solved state. Each stream is at constant pressure.
+%
+% EXAMPLES:
+%    libLoc = 'C:\Program Files (x86)\REFPROP\';
+%
+%    Pinch of an R454B evaporator heated by water, in 200 segments:
+%    hot  = struct("Fluid", "Water", "P", 2e5, "T", 285.15, "mdot", 0.5);
+%    cold = struct("Fluid", "R454B.MIX", "P", 6e5, "H", 2.2e5, "mdot", 0.06);
+%    [profile, pinch] = getHeatExchangerProfile(libLoc, hot, cold, 12e3, 200);
+%    plot(profile.DutyFraction, profile.Hot.T, profile.DutyFraction, profile.Cold.T)
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function [profile, pinch] = getHeatExchangerProfile(libraryLocation, hotStream, coldStream, duty, numSegments,...
+                                                    massOrMolar, opts)
+    arguments
+        libraryLocation (1, :) {mustBeText}
+        hotStream       (1, 1) struct
+        coldStream      (1, 1) struct
+        duty            (1, 1) double {mustBeNonnegative}
+        numSegments     (1, 1) double {mustBeInteger, mustBePositive}
+        massOrMolar     (1, 1) double = 1;
+        opts.Flow       (1, 1) string {mustBeMember(opts.Flow, ["counterflow", "parallel"])} = "counterflow";
+    end
+
+    if ~contains(libraryLocation, "REFPROP", "IgnoreCase", true)
+        error("getHeatExchangerProfile is only available with the REFPROP library.");
+    end
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % rows hot and cold of P, inlet H and mass flow rate, as hxMexC expects %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    [hotFluid,  hotComp,  hotRow]  = streamInputs(libraryLocation, hotStream,  "hotStream",  massOrMolar);
+    [coldFluid, coldComp, coldRow] = streamInputs(libraryLocation, coldStream, "coldStream", massOrMolar);
+
+    [profiles, approach, pinchRow] = hxMexC(hotFluid, hotComp, coldFluid, coldComp, massOrMolar, [hotRow; coldRow],...
+                                            duty, numSegments, double(opts.Flow == "counterflow"),...
+                                            char(libraryLocation));
+
+    names = ["H", "T", "Q", "D", "CP", "viscosity", "conductivity"];
+    units = ["J/kg", "K", "kg/kg", "kg/m^3", "J/(kg K)", "Pa s", "W/(m K)"];
+    hot   = array2table(profiles(:, :, 1), VariableNames=names);
+    cold  = array2table(profiles(:, :, 2), VariableNames=names);
+    hot.Properties.VariableUnits  = units;
+    cold.Properties.VariableUnits = units;
+
+    dutyFraction = (0:numSegments)' / numSegments;
+    profile = struct("Hot", hot, "Cold", cold, "DutyFraction", dutyFraction, "Approach", approach);
+
+    pinch = struct("Index", pinchRow(1), "Approach", pinchRow(2), "DutyFraction", NaN, "THot", NaN, "TCold", NaN);
+    if ~isnan(pinchRow(1))
+        pinch.DutyFraction = dutyFraction(pinchRow(1));
+        pinch.THot         = hot.T(pinchRow(1));
+        pinch.TCold        = cold.T(pinchRow(1));
+    end
+end % end function getHeatExchangerProfile
+
+function [fluid, Composition, row] = streamInputs(libraryLocation, stream, name, massOrMolar)
+% STREAMINPUTS checked fluid, 20 element composition and [P, inlet H, mdot] of one stream
+    if ~all(isfield(stream, ["Fluid", "P", "mdot"])) || ~any(isfield(stream, ["H", "T"]))
+        error("%s must have the fields Fluid, P, mdot and either H or T.", name);
+    end
+    fluid       = char(stream.Fluid);
+    composition = 1;
+    if isfield(stream, "Composition")
+        composition = stream.Composition;
+    end
+    Composition = validateRefpropInputs(fluid, composition, char(libraryLocation));
+
+    if isfield(stream, "H")
+        hIn = stream.H;
+    else
+        hIn = getFluidProperty(libraryLocation, 'H', 'T', stream.T, 'P', stream.P, fluid, composition, massOrMolar,...
+                               'MASS BASE SI');
+    end
+    row = [stream.P, hIn, stream.mdot];
+end % end function streamInputs
@@ -0,0 +1,87 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% phase = (struct) with the fields
+%             Value  - (MxN) values of requestedProperty
+%             Q      - (MxN) vapor quality as REFPROP returns it, on the basis of massOrMolar; outside the two-phase
+%                      region REFPROP returns values below 0 or above 1
+%             X      - (MxNxncomp) liquid phase composition
+%             Y      - (MxNxncomp) vapor phase composition
+%             X3     - (MxNxncomp) second liquid phase composition, 0 where there is none
+%             Status - (MxN) 0 where the point was evaluated, 1 where REFPROP failed and the values are NaN
+%         M is the number of values for inputProperty1, N the number for inputProperty2 and ncomp the number of
+%         species in the fluid. With Zipped true the arrays are Kx1 and Kxncomp.
+%
+% [INPUTS]:
+% libraryLocation     = (string) the location of the REFPROP library files
+% requestedProperty   = (string) the thermodynamic property name returned from the same flash, e.g., "H"
+% inputProperty1      = (string) name of the 1st property used as the state point
+% inputProperty1Value = (double) (1xM) array of values of the 1st property used as the state point
+% inputProperty2      = (string) name of the 2nd property used as the state point
+% inputProperty2Value = (double) (1xN) array of values of the 2nd property used as the state point
+% fluid               = (string) indicating the fluid, e.g., "R32;R125", "R454B.MIX"
+% fluidComposition    = (double) array of size 1xnumSpec species fraction, see getFluidProperty
+% massOrMolar         = (int) value to determine input composition units: 0 -> Molar, 1 -> Mass
+% desiredUnits        = (char) enum as expected by refprop.dll to determine the units to use
+% Zipped              = [optional (name, value) pair] (logical) defaults to false -> every pair of input values
+%                                                                       true  -> inputProperty1Value(k) with
+%                                                                                inputProperty2Value(k) only
+%
+% Each state point is flashed once and the quality and compositions REFPROPdll solved for are kept, rather than
+% repeating the flash with the XLIQ, XVAP and QMASS outputs.
+%
+% EXAMPLES:
+%    libLoc = 'C:\Program Files (x86)\REFPROP\';
+%
+%    Liquid and vapor compositions of R32/R1234yf across the two-phase region at 1 MPa:
+%    phase = getPhaseCompositions(libLoc, 'H', 'P', 1000, 'Q', 0:0.1:1, "R32;R1234yf", [0.5, 0.5], 0, 'MKS');
+%    plot(phase.Q, squeeze(phase.X(1, :, 1)), phase.Q, squeeze(phase.Y(1, :, 1)))
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function phase = getPhaseCompositions(libraryLocation, requestedProperty, inputProperty1, inputProperty1Value,...
+                                      inputProperty2, inputProperty2Value, fluid, fluidComposition, massOrMolar,...
+                                      desiredUnits, opts)
+    arguments
+        libraryLocation     (1, :) {mustBeText}
+        requestedProperty   (1, :) {mustBeText}
+        inputProperty1      (1, :) {mustBeText}
+        inputProperty1Value (1, :) double
+        inputProperty2      (1, :) {mustBeText}
+        inputProperty2Value (1, :) double
+        fluid               (1, :) string
+        fluidComposition    (1, :) double       = 1;
+        massOrMolar         (1, 1) double       = 0;
+        desiredUnits        (1, :) {mustBeText} = "MKS";
+        opts.Zipped         (1, 1) logical      = false;
+    end
+
+    if ~contains(libraryLocation, "REFPROP", "IgnoreCase", true)
+        error("getPhaseCompositions is only available with the REFPROP library.");
+    end
+    if opts.Zipped && (numel(inputProperty1Value) ~= numel(inputProperty2Value))
+        error("Zipped inputs require inputProperty1Value and inputProperty2Value to have the same number of "...
+              + "elements. Currently, they have %d and %d elements.", numel(inputProperty1Value),...
+              numel(inputProperty2Value));
+    end
+
+    spec = char(string(inputProperty1) + string(inputProperty2));
+    validateRefpropSpec(spec);
+    Composition = validateRefpropInputs(char(fluid), fluidComposition, char(libraryLocation));
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % a column against a row expands to the MxN grid, two columns pair the values one to one %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    if opts.Zipped
+        inputProperty2Value = inputProperty2Value(:);
+    end
+    [value, status, q, x, y, x3] = hiLevelMexC(char(requestedProperty), spec, inputProperty1Value(:),...
+                                               inputProperty2Value, char(fluid), massOrMolar, Composition,...
+                                               char(desiredUnits), char(libraryLocation), 0, 'exact',...
+                                               logical.empty, 0);
+    if opts.Zipped
+        [x, y, x3] = deal(reshape(x, numel(value), []), reshape(y, numel(value), []), reshape(x3, numel(value), []));
+    end
+
+    phase = struct("Value", value, "Q", q, "X", x, "Y", y, "X3", x3, "Status", status);
+end % end function getPhaseCompositions
@@ -0,0 +1,114 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% props = (struct) one field per requested property (named as requested, made a valid MATLAB name) followed by the
+%                  fields viscosity (Pa s), conductivity (W/(m K)) and surfaceTension (N/m). Each field is an MxN
+%                  array, where M is the number of values for inputProperty1 and N is the number of values for
+%                  inputProperty2, or a Kx1 array when Zipped is true
+%
+% [INPUTS]:
+% libraryLocation     = (string) the location of the REFPROP or CoolProp library files (dll, exe, etc.)
+% requestedProperties = (string) array of thermodynamic property names returned from the same flash as the transport
+%                                properties, e.g., ["H", "S", "CP"] for REFPROP, ["Hmass", "Smass"] for CoolProp;
+%                                may be empty
+% inputProperty1      = (string) name of the 1st property used as the state point
+% inputProperty1Value = (double) (1xM) array of values of the 1st property in SI units (K, Pa, kg/m^3, J/kg)
+% inputProperty2      = (string) name of the 2nd property used as the state point
+% inputProperty2Value = (double) (1xN) array of values of the 2nd property in SI units (K, Pa, kg/m^3, J/kg)
+% fluid               = (string) indicating the fluid, e.g., "Water", "R32;R125"
+% fluidComposition    = (double) array of size 1xnumSpec species fraction where 1 <= numSpec <= 20, whose values must
+%                                sum to 1; numSpec must match the number of species in the fluid
+% massOrMolar         = [REFPROP only] (int) value to determine input composition units: 0 -> Molar, 1 -> Mass
+% Zipped              = [optional (name, value) pair] (logical) defaults to false -> every pair of input values
+%                                                                       true  -> inputProperty1Value(k) with
+%                                                                                inputProperty2Value(k) only
+% keepLibraryLoaded   = [CoolProp optional (name, value) pair] (logical) see getFluidProperty
+%
+% Each state point is flashed once. The requested thermodynamic properties come from that flash and the transport
+% properties are evaluated on the solved state (TRNPRPdll and SURTENdll for REFPROP, one AbstractState update per
+% five outputs for CoolProp), rather than repeating the flash for every property as separate getFluidProperty calls
+% would.
+% All values are in SI units (MASS BASE SI for REFPROP). The viscosity and conductivity are NaN for two-phase
+% states. The surface tension is taken at saturation at the state temperature, NaN above the critical temperature.
+%
+% EXAMPLES:
+%    libLoc = 'C:\Program Files (x86)\REFPROP\';
+%
+%    Enthalpy, heat capacity and transport properties of R134a along a 1 MPa isobar:
+%    props = getTransportProperties(libLoc, ["H", "CP"], 'T', 300:10:350, 'P', 1e6, "R134a");
+%    props.viscosity
+%
+%    Transport properties at the states of a heat-exchanger discretization:
+%    props = getTransportProperties(libLoc, "T", 'P', P_nodes, 'H', H_nodes, "R134a", Zipped=true);
+%
+%    The same with CoolProp, whose AbstractState takes the P-H pair as HmassP_INPUTS:
+%    props = getTransportProperties('C:\Program Files\CoolProp\', "T", 'P', P_nodes, 'H', H_nodes, "R134a",...
+%                                   Zipped=true);
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function props = getTransportProperties(libraryLocation, requestedProperties, inputProperty1, inputProperty1Value,...
+                                        inputProperty2, inputProperty2Value, fluid, fluidComposition, massOrMolar,...
+                                        opts)
+    arguments
+        libraryLocation        (1, :) {mustBeText}
+        requestedProperties    (1, :) string
+        inputProperty1         (1, :) {mustBeText}
+        inputProperty1Value    (1, :) double
+        inputProperty2         (1, :) {mustBeText}
+        inputProperty2Value    (1, :) double
+        fluid                  (1, :) string
+        fluidComposition       (1, :) double  = 1;
+        massOrMolar            (1, 1) double  = 1;
+        opts.Zipped            (1, 1) logical = false;
+        opts.keepLibraryLoaded (1, 1) logical = false;
+    end
+
+    if opts.Zipped && (numel(inputProperty1Value) ~= numel(inputProperty2Value))
+        error("Zipped inputs require inputProperty1Value and inputProperty2Value to have the same number of "...
+              + "elements. Currently, they have %d and %d elements.", numel(inputProperty1Value),...
+              numel(inputProperty2Value));
+    end
+
+    numProp = numel(requestedProperties);
+    if opts.Zipped
+        outSize = [numel(inputProperty1Value), 1];
+    else
+        outSize = [numel(inputProperty1Value), numel(inputProperty2Value)];
+    end
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % both libraries return one page per property, transport last %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    if contains(libraryLocation, "REFPROP", "IgnoreCase", true)
+        Composition = validateRefpropInputs(char(fluid), fluidComposition, char(libraryLocation));
+        propVals    = transportMexC(char(strjoin(requestedProperties, ";")),...
+                                    char(string(inputProperty1) + string(inputProperty2)),...
+                                    inputProperty1Value, inputProperty2Value, char(fluid), massOrMolar, Composition,...
+                                    char(libraryLocation), double(opts.Zipped));
+    else
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        % expand a grid to its pairs, the state temperature is read back for the surface tension %
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        if opts.Zipped
+            val1 = inputProperty1Value;
+            val2 = inputProperty2Value;
+        else
+            [val1, val2] = ndgrid(inputProperty1Value, inputProperty2Value);
+        end
+
+        cpObj = MLCoolProp(libraryLocation, opts.keepLibraryLoaded);
+        vals  = cpObj.getStateValues([requestedProperties, "viscosity", "conductivity", "T"], inputProperty1,...
+                                     val1(:)', inputProperty2, val2(:)', fluid, fluidComposition);
+        sigma = cpObj.getStateValues("surface_tension", 'Q', zeros(1, size(vals, 1)), 'T', vals(:, end)', fluid,...
+                                     fluidComposition);
+        propVals = reshape([vals(:, 1:(end - 1)), sigma], [outSize, numProp + 3]);
+    end % end if REFPROP, else CoolProp
+
+    fieldNames = [matlab.lang.makeValidName(requestedProperties), "viscosity", "conductivity", "surfaceTension"];
+    fieldNames = matlab.lang.makeUniqueStrings(fieldNames);
+    props = struct();
+    for px = 1:numel(fieldNames)
+        props.(fieldNames(px)) = reshape(propVals(:, :, px), outSize);
+    end % end loop over output properties
+end % end function getTransportProperties
@@ -0,0 +1,106 @@
+classdef FluidPropertyJob < handle
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % FluidPropertyJob
+    %   Handle to a getFluidProperty evaluation running on the workers of a parallel pool, returned by
+    %   submitFluidProperty. The rows of the MxN output (the values of inputProperty1) are split into chunks and each
+    %   chunk is one parfeval future, so the MATLAB session stays free while the chunks run.
+    %
+    %   Methods:
+    %       status = progress(job) - (struct) with fields
+    %                                    State            - "running", "finished", "cancelled" or "failed"
+    %                                    FractionComplete - fraction of the state points in finished chunks
+    %                                    PointsPerSecond  - state points in finished chunks per second since submit
+    %                                    ElapsedTime      - seconds since submit
+    %       output = fetch(job)    - waits for every chunk and returns the MxN array of getFluidProperty
+    %       cancel(job)            - cancels the chunks that have not finished, finished chunks are kept
+    %       wait(job)              - waits for every chunk to finish or be cancelled
+    %
+    %   Deleting the job cancels the chunks that have not finished.
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+    % Copyright 2026 The MathWorks, Inc.
+
+    properties (SetAccess = private)
+        Futures    (:, 1)                             % one parallel.FevalFuture per chunk of rows
+        RowEdges   (1, :) double                      % chunk cx holds rows RowEdges(cx)+1 to RowEdges(cx+1)
+        OutputSize (1, 2) double                      % size of the getFluidProperty output, MxN
+        SubmitTime (1, 1) uint64                      % tic value when the chunks were submitted
+        Cancelled  (1, 1) logical = false;
+    end
+
+    methods
+        function obj = FluidPropertyJob(futures, rowEdges, outputSize)
+            arguments
+                futures    (:, 1)
+                rowEdges   (1, :) double
+                outputSize (1, 2) double
+            end
+            obj.Futures    = futures;
+            obj.RowEdges   = rowEdges;
+            obj.OutputSize = outputSize;
+            obj.SubmitTime = tic;
+        end % end constructor
+
+        function status = progress(obj)
+        % PROGRESS fraction of the state points complete and the throughput so far, does not wait
+            chunkDone  = strcmp({obj.Futures.State}, 'finished')' & cellfun(@isempty, {obj.Futures.Error})';
+            chunkRows  = diff(obj.RowEdges)';
+            pointsDone = sum(chunkRows(chunkDone)) * obj.OutputSize(2);
+
+            status.ElapsedTime      = toc(obj.SubmitTime);
+            status.FractionComplete = pointsDone / max(1, prod(obj.OutputSize));
+            status.PointsPerSecond  = pointsDone / status.ElapsedTime;
+            status.State            = obj.jobState();
+        end % end method progress
+
+        function output = fetch(obj)
+        % FETCH waits for the job and assembles the MxN output from the chunks in row order
+            if obj.Cancelled
+                error("The job was cancelled before it finished, there is no complete output to fetch.");
+            end
+
+            output = NaN(obj.OutputSize);
+            for cx = 1:numel(obj.Futures)
+                %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+                % MLrefprop returns [] when the REFPROP call fails, keep those rows NaN %
+                %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+                chunkOutput = fetchOutputs(obj.Futures(cx));
+                if ~isempty(chunkOutput)
+                    output((obj.RowEdges(cx) + 1):obj.RowEdges(cx + 1), :) = chunkOutput;
+                end
+            end % end loop over chunks
+        end % end method fetch
+
+        function cancel(obj)
+        % CANCEL stops the chunks that are queued or running
+            cancel(obj.Futures);
+            obj.Cancelled = true;
+        end % end method cancel
+
+        function wait(obj)
+        % WAIT blocks until every chunk has finished or been cancelled
+            wait(obj.Futures);
+        end % end method wait
+
+        function delete(obj)
+            if ~isempty(obj.Futures)
+                cancel(obj.Futures);
+            end
+        end % end destructor
+    end % end public methods
+
+    methods (Access = private)
+        function state = jobState(obj)
+            states = string({obj.Futures.State});
+            if obj.Cancelled
+                state = "cancelled";
+            elseif any(~cellfun(@isempty, {obj.Futures.Error}))
+                state = "failed";
+            elseif all(states == "finished")
+                state = "finished";
+            else
+                state = "running";
+            end
+        end % end method jobState
+    end % end private methods
+end % end classdef FluidPropertyJob
@@ -78,10 +78,23 @@ classdef MLCoolProp < handle
     %
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
     
-    % Copyright 2019 - 2025 The MathWorks, Inc.
+    % Copyright 2019 - 2026 The MathWorks, Inc.
     
     % History:
     %
+    % Rev 6: Add the numThreads property to evaluate state points on a thread pool through coolpropMexC.
+    %
+    % Rev 5: Add the backend property, setTableDirectory and buildTables for the BICUBIC&HEOS and TTSE&HEOS tabular
+    %        backends.
+    %
+    % Rev 4: Add getStateDerivatives for analytic first partial derivatives from one update per state point.
+    %
+    % Rev 3: Add getStateValues to read several outputs from one AbstractState update per state point. Look up the
+    %        AbstractState input pair from the mass-based names of the PropsSI inputs, e.g. P and Hmass for P and H,
+    %        through coolpropInputName.
+    %
+    % Rev 2: Switch back to PropsSI after a Props1SI call so one object can return both constants and state values.
+    %
     % Rev 1: Original version
     % K. McGarrity
     % 29 JAN 2025
@@ -93,6 +106,9 @@ classdef MLCoolProp < handle
         hErr          (1, :) char    = char(1:1:1000);
         libName       (1, :) char    = 'CoolProp';
         keepLibLoaded (1, 1) logical = false;
+        backend       (1, :) char    = 'HEOS';
+        numThreads    (1, 1) double {mustBeInteger, mustBeNonnegative} = 1;  % 0 -> one thread per core
+        libPath       (1, :) char    = '';
     end
 
     methods
@@ -106,6 +122,7 @@ classdef MLCoolProp < handle
             % set the value in the object - needed for destructor %
             %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
             obj.keepLibLoaded = keepLibraryLoaded;
+            obj.libPath       = CoolPropDLLpath;
 
             %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
             % Check CoolPropDLLpath validity %
@@ -166,6 +183,18 @@ classdef MLCoolProp < handle
                        + num2str(sum(FluidComposition)));
             end % end if sum of fluid composition not equal to 1
         
+            %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+            % PropsSI always uses HEOS, the tabular backends are only reached through AbstractState %
+            % and so is the thread pool, which gives each thread an AbstractState of its own        %
+            %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+            if (~strcmp(obj.backend, 'HEOS') || (obj.numThreads ~= 1)) && ~isempty([Input1, Input2])
+                [val1, val2] = ndgrid(Input1Val, Input2Val);
+                outVals      = obj.getStateValues(string(outputVars), Input1, val1(:)', Input2, val2(:)', Fluid,...
+                                                  FluidComposition);
+                outVals      = reshape(outVals, size(val1));
+                return
+            end
+
             %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
             % put the user-defined fluid together in the required format %
             % e.g., given the default fluid and fluidComposition         %
@@ -216,6 +245,8 @@ classdef MLCoolProp < handle
         
             if strcmp(inputPair, ";")
                 obj.libMethod = 'Props1SI';
+            elseif strcmp(obj.libMethod, 'Props1SI')
+                obj.libMethod = 'PropsSI';
             end
         
             if strcmp(obj.libMethod, 'PropsSI')
@@ -254,6 +285,82 @@ classdef MLCoolProp < handle
             end % end if high-, else low-, level interface
         end % end method getCoolPropValues
         
+        function outVals = getStateValues(obj, outputVars, Input1, Input1Val, Input2, Input2Val, Fluid,...
+                                          FluidComposition)
+        % GETSTATEVALUES updates a CoolProp AbstractState once per state point and reads every output parameter from
+        %                that state, so the state is solved once for all outputs. Input1Val and Input2Val are paired
+        %                element by element. Returns a KxnumOut array, NaN where CoolProp could not return a value.
+        %                With numThreads other than 1 the points are evaluated by coolpropMexC on a thread pool.
+            arguments
+                obj
+                outputVars       (1, :) string
+                Input1           (1, :) char
+                Input1Val        (1, :) double
+                Input2           (1, :) char
+                Input2Val        (1, :) double
+                Fluid            (1, :) string
+                FluidComposition (1, :) double
+            end
+
+            if obj.numThreads ~= 1
+                species = strsplit(Fluid, ";");
+                if numel(species) ~= numel(FluidComposition)
+                    error(   "Fluid must have the same number of elements as the specified composition. "...
+                           + "Currently, you have specified " + num2str(numel(species)) + " Fluids: "...
+                           + strjoin(species, ", ") + " and " + num2str(numel(FluidComposition)) + " compositions.");
+                end
+                outVals = coolpropMexC(obj.libPath, obj.backend, char(strjoin(species, "&")), FluidComposition,...
+                                       char(strjoin(outputVars, ";")), coolpropInputName(Input1), Input1Val,...
+                                       coolpropInputName(Input2), Input2Val, obj.numThreads);
+                return
+            end
+
+            numPts  = numel(Input1Val);
+            numOut  = numel(outputVars);
+            outVals = NaN(numPts, numOut);
+
+            [fluidHandle, inputPairIdx, Input1Val, Input2Val] = obj.newAbstractState(Input1, Input1Val, Input2,...
+                                                                                     Input2Val, Fluid,...
+                                                                                     FluidComposition);
+            freeHandle = onCleanup(@() calllib(obj.libName, 'AbstractState_free', fluidHandle, obj.iErr, obj.hErr,...
+                                               obj.sizeErr));
+
+            outputIdx = obj.getParamIndex(outputVars);
+
+            %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+            % up to five outputs are read per update. CoolProp stops the whole batch at the first bad %
+            % point, so a failed batch is repeated one point at a time to keep the good points        %
+            %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+            for gx = 1:5:numOut
+                groupCols = gx:min(gx + 4, numOut);
+                groupIdx  = outputIdx([groupCols, repmat(groupCols(1), 1, 5 - numel(groupCols))]);
+
+                [groupVals, failed] = obj.updateAnd5Out(fluidHandle, inputPairIdx, Input1Val, Input2Val, groupIdx);
+                if failed
+                    for px = 1:numPts
+                        [pointVals, failed] = obj.updateAnd5Out(fluidHandle, inputPairIdx, Input1Val(px),...
+                                                                Input2Val(px), groupIdx);
+                        if ~failed
+                            groupVals(px, :) = pointVals;
+                            continue
+                        end
+
+                        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+                        % e.g. a transport property in the two-phase region, keep the outputs that exist %
+                        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+                        for ox = 1:numel(groupCols)
+                            [pointVals, failed] = obj.updateAnd5Out(fluidHandle, inputPairIdx, Input1Val(px),...
+                                                                    Input2Val(px), repmat(groupIdx(ox), 1, 5));
+                            if ~failed
+                                groupVals(px, ox) = pointVals(1);
+                            end
+                        end % end loop over outputs of the group
+                    end % end loop over points
+                end % end if the batch failed
+                outVals(:, groupCols) = groupVals(:, 1:numel(groupCols));
+            end % end loop over groups of five outputs
+        end % end method getStateValues
+
         function outData = getOutputValue(obj, outputParam, opts)
         % GETOUTPUTVALUE calls the CoolProp library method given by libMethod. It returns the specified output parameter
         %                based on the given input values
@@ -373,6 +480,174 @@ classdef MLCoolProp < handle
             obj.coolpropErrorCheck(opts.Species)
         end % end method makeLibCall
         
+        function [outVals, failed] = updateAnd5Out(obj, fluidHandle, inputPairIdx, input1, input2, outputIdx)
+        % UPDATEAND5OUT one call to AbstractState_update_and_5_out, returns a numel(input1)x5 array that is NaN and
+        %               failed = true when CoolProp reports an error for any point
+            len     = numel(input1);
+            outVals = NaN(len, 5);
+            [~, ~, ~, out1, out2,...
+                      out3, out4, out5, obj.iErr, obj.hErr] = calllib(obj.libName, 'AbstractState_update_and_5_out',...
+                                                                      fluidHandle, inputPairIdx, input1, input2, len,...
+                                                                      outputIdx, zeros(1, len), zeros(1, len),...
+                                                                      zeros(1, len), zeros(1, len), zeros(1, len),...
+                                                                      obj.iErr, obj.hErr, obj.sizeErr);
+            failed = (obj.iErr ~= 0);
+            if failed
+                obj.iErr = 0;
+            else
+                outVals = [out1(:), out2(:), out3(:), out4(:), out5(:)];
+            end
+        end % end method updateAnd5Out
+
+        function outVals = getStateDerivatives(obj, outputVars, derivatives, Input1, Input1Val, Input2, Input2Val,...
+                                               Fluid, FluidComposition)
+        % GETSTATEDERIVATIVES updates a CoolProp AbstractState once per state point and reads the output parameters
+        %                     and the analytic first partial derivatives from that state. derivatives is a numDerivx3
+        %                     string array of [Of, Wrt, Constant] parameter names, e.g. ["Hmass", "P", "T"]. Input1Val
+        %                     and Input2Val are paired element by element. Returns a Kx(numOut + numDeriv) array, NaN
+        %                     where CoolProp could not return a value.
+            arguments
+                obj
+                outputVars       (1, :) string
+                derivatives      (:, 3) string
+                Input1           (1, :) char
+                Input1Val        (1, :) double
+                Input2           (1, :) char
+                Input2Val        (1, :) double
+                Fluid            (1, :) string
+                FluidComposition (1, :) double
+            end
+
+            numPts   = numel(Input1Val);
+            numOut   = numel(outputVars);
+            numDeriv = size(derivatives, 1);
+            outVals  = NaN(numPts, numOut + numDeriv);
+
+            [fluidHandle, inputPairIdx, Input1Val, Input2Val] = obj.newAbstractState(Input1, Input1Val, Input2,...
+                                                                                     Input2Val, Fluid,...
+                                                                                     FluidComposition);
+            freeHandle = onCleanup(@() calllib(obj.libName, 'AbstractState_free', fluidHandle, obj.iErr, obj.hErr,...
+                                               obj.sizeErr));
+
+            outputIdx = obj.getParamIndex(outputVars);
+            derivIdx  = reshape(obj.getParamIndex(derivatives(:)'), [], 3);
+
+            for px = 1:numPts
+                [obj.iErr, obj.hErr] = calllib(obj.libName, 'AbstractState_update', fluidHandle, inputPairIdx,...
+                                               Input1Val(px), Input2Val(px), obj.iErr, obj.hErr, obj.sizeErr);
+                if obj.iErr ~= 0
+                    obj.iErr = 0;
+                    continue
+                end % end if the state could not be solved
+
+                for ox = 1:numOut
+                    [val, obj.iErr, obj.hErr] = calllib(obj.libName, 'AbstractState_keyed_output', fluidHandle,...
+                                                        outputIdx(ox), obj.iErr, obj.hErr, obj.sizeErr);
+                    if obj.iErr == 0
+                        outVals(px, ox) = val;
+                    end
+                    obj.iErr = 0;
+                end % end loop over output parameters
+
+                for dx = 1:numDeriv
+                    [val, obj.iErr, obj.hErr] = calllib(obj.libName, 'AbstractState_first_partial_deriv', fluidHandle,...
+                                                        derivIdx(dx, 1), derivIdx(dx, 2), derivIdx(dx, 3), obj.iErr,...
+                                                        obj.hErr, obj.sizeErr);
+                    if obj.iErr == 0
+                        outVals(px, numOut + dx) = val;
+                    end
+                    obj.iErr = 0;
+                end % end loop over derivatives
+            end % end loop over points
+        end % end method getStateDerivatives
+
+        function [fluidHandle, inputPairIdx, Input1Val, Input2Val] = newAbstractState(obj, Input1, Input1Val, Input2,...
+                                                                                      Input2Val, Fluid, FluidComposition)
+        % NEWABSTRACTSTATE creates an AbstractState of the backend for the fluid and finds the CoolProp input pair. The
+        %                  input values are swapped when CoolProp only accepts the pair in the other order. The caller
+        %                  must free the returned handle with AbstractState_free.
+            if numel(Input1Val) ~= numel(Input2Val)
+                error("Input1Val and Input2Val must have the same number of elements. Currently, they have %d and %d.",...
+                      numel(Input1Val), numel(Input2Val));
+            end
+
+            %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+            % the AbstractState takes the species joined by & and the mole fractions %
+            % separately rather than the bracketed fluid string used by PropsSI      %
+            %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+            species = strsplit(Fluid, ";");
+            if numel(species) ~= numel(FluidComposition)
+                error(   "Fluid must have the same number of elements as the specified composition. "...
+                       + "Currently, you have specified " + num2str(numel(species)) + " Fluids: "...
+                       + strjoin(species, ", ") + " and " + num2str(numel(FluidComposition)) + " compositions.");
+            end
+
+            prevMethod    = obj.libMethod;
+            restoreMethod = onCleanup(@() resetLibMethod(obj, prevMethod));
+            obj.libMethod = 'AbstractState_factory';
+            fluidHandle   = obj.getOutputValue('handle', Species=char(strjoin(species, "&")),...
+                                               CoolPropBackend=obj.backend);
+            if numel(species) > 1
+                obj.libMethod = 'AbstractState_set_fractions';
+                [~, obj.iErr, obj.hErr] = calllib(obj.libName, obj.libMethod, fluidHandle, FluidComposition,...
+                                                  numel(FluidComposition), obj.iErr, obj.hErr, obj.sizeErr);
+                if obj.iErr ~= 0
+                    calllib(obj.libName, 'AbstractState_free', fluidHandle, 0, obj.hErr, obj.sizeErr);
+                end
+                obj.coolpropErrorCheck(Fluid);
+            end
+
+            %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+            % the input pairs name the H, S, D and U of PropsSI Hmass, Smass, Dmass and Umass, and %
+            % CoolProp only accepts each input pair in one order, e.g. PT_INPUTS but not TP_INPUTS %
+            %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+            Input1       = coolpropInputName(Input1);
+            Input2       = coolpropInputName(Input2);
+            inputPairIdx = calllib(obj.libName, 'get_input_pair_index', [Input1, Input2, '_INPUTS']);
+            if inputPairIdx < 0
+                inputPairIdx = calllib(obj.libName, 'get_input_pair_index', [Input2, Input1, '_INPUTS']);
+                [Input1Val, Input2Val] = deal(Input2Val, Input1Val);
+            end
+            if inputPairIdx < 0
+                calllib(obj.libName, 'AbstractState_free', fluidHandle, obj.iErr, obj.hErr, obj.sizeErr);
+                error("CoolProp does not accept the input pair " + Input1 + " and " + Input2 + ".");
+            end
+        end % end method newAbstractState
+
+        function setTableDirectory(obj, tableDirectory)
+        % SETTABLEDIRECTORY makes CoolProp save and load the tables of the tabular backends in tableDirectory instead of
+        %                   its default ~/.CoolProp/Tables. Applies to tables built after the call while the library
+        %                   stays loaded.
+            if ~exist(tableDirectory, 'dir')
+                mkdir(tableDirectory);
+            end
+            calllib(obj.libName, 'set_config_string', 'ALTERNATIVE_TABLES_DIRECTORY', char(tableDirectory));
+        end % end method setTableDirectory
+
+        function buildTime = buildTables(obj, Fluid)
+        % BUILDTABLES creates an AbstractState of the tabular backend for Fluid, which builds its tables or loads them
+        %             from the table directory, and returns the time that took in seconds
+            prevMethod    = obj.libMethod;
+            restoreMethod = onCleanup(@() resetLibMethod(obj, prevMethod));
+            obj.libMethod = 'AbstractState_factory';
+
+            timer       = tic;
+            fluidHandle = obj.getOutputValue('handle', Species=char(Fluid), CoolPropBackend=obj.backend);
+            buildTime   = toc(timer);
+            calllib(obj.libName, 'AbstractState_free', fluidHandle, obj.iErr, obj.hErr, obj.sizeErr);
+        end % end method buildTables
+
+        function paramIdx = getParamIndex(obj, paramNames)
+        % GETPARAMINDEX CoolProp parameter index of each name in paramNames
+            paramIdx = zeros(size(paramNames));
+            for ox = 1:numel(paramNames)
+                paramIdx(ox) = calllib(obj.libName, 'get_param_index', char(paramNames(ox)));
+                if paramIdx(ox) < 0
+                    error("CoolProp does not recognize the parameter " + paramNames(ox) + ".");
+                end
+            end % end loop over parameter names
+        end % end method getParamIndex
+
         function cleanupDLL(obj)
             if libisloaded(obj.libName)
                 unloadlibrary(obj.libName)
@@ -392,3 +667,8 @@ classdef MLCoolProp < handle
         end % method coolpropErrorCheck
     end % end public methods
 end % end class def MLCoolProp
+
+function resetLibMethod(obj, libMethod)
+% put back the library method once getStateValues is done with the AbstractState
+    obj.libMethod = libMethod;
+end % end function resetLibMethod
@@ -3,7 +3,11 @@
 %   hiLevelMexC.cpp - function written with MEX C api (rather than C++) but since REFPROP requires C++, the file is C++.                    
 %                                                                                         
 %   From MATLAB(R):                                                                          
-%        output = MLrefprop(propReq, spec, Value1, Value2, fluid, MassOrMole, DesiredUnits, Path2Refprop, DebugOutput)                    
+%        output = MLrefprop(propReq, spec, Value1, Value2, fluid, MassOrMole, DesiredUnits, Path2Refprop, DebugOutput)
+%        output = MLrefprop(..., DebugOutput, Model)
+%        [output, status] = MLrefprop(..., DebugOutput, Model, Mask, DomainCheck)                    
+%        [output, status] = MLrefprop(..., DomainCheck, SharedCache, CacheEntries)
+%        [output, status] = MLrefprop(..., CacheEntries, LeverRule)
 %                                                                                         
 %   Where (see: https://refprop-docs.readthedocs.io/en/latest/DLL/high_level.html)        
 %                                                                                         
@@ -20,6 +24,17 @@
 %  DesiredUnits = CHAR value to determine units to use (enum as expected by refprop.dll)  
 %  Path2Refprop = CHAR path to Refprop directory (e.g. C:\\ProgramFiles (x86)\\REFPROP)   
 %  DebugOutput  = DOUBLE value (0 to suppress, 1 to show) debug output in MATLAB console  
+%  Model        = [optional] CHAR 'exact' (default) for REFPROP's equations of state, 'fast' for Peng-Robinson
+%  Mask         = [optional] LOGICAL (array of size MxN) of the points to evaluate, [] (default) for all of them
+%  DomainCheck  = [optional] LOGICAL true to return NaN without calling REFPROP for points outside the limits of the
+%                            equation of state or below the melting line, defaults to false
+%  SharedCache  = [optional] CHAR name of the shared-memory result cache shared with the other MATLAB processes on the
+%                            host, '' (default) for none
+%  CacheEntries = [optional] DOUBLE number of results the shared cache holds when this call creates it, defaults to 1e6
+%  LeverRule    = [optional] LOGICAL true to evaluate the two-phase points of a pure fluid by the lever rule from the
+%                            saturation states at each P or T, defaults to false
+%       status  = DOUBLE (array of size MxN) status of each point: 0 evaluated, 1 REFPROP failed, 2 masked,
+%                         3 outside the limits of the equation of state, 4 below the melting line
 %                                                                                         
 %  Examples:     
 %    refpropPath = 'C:\Program Files (x86)\REFPROP\';
@@ -62,10 +77,27 @@
 %                                                                                         
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-% Copyright 2019 - 2025 The MathWorks, Inc.
+% Copyright 2019 - 2026 The MathWorks, Inc.
 
 % History:
 %
+% Rev 15: Call hiLevelMexC once with every optional input rather than once per combination of them.
+%
+% Rev 14: Add the optional LeverRule input.
+%
+% Rev 13: Add the optional SharedCache and CacheEntries inputs.
+%
+% Rev 12: Add the optional Mask and DomainCheck inputs and the status output.
+%
+% Rev 11: Add the optional Model input to evaluate with the fast (Peng-Robinson) model.
+%
+% Rev 10: Pass Value1 as a column, hiLevelMexC now applies implicit expansion to its value inputs.
+%
+% Rev 9: Move the Spec checks to validateRefpropSpec so prepareFluidProperty can run them once per prepared query.
+%
+% Rev 8: Move the REFPROP path, Fluid and Composition checks to validateRefpropInputs so they are shared with the
+% cycle kernel.
+%
 % Rev 7: Use arguements to ensure the correct data type is coming through 
 % K. McGarrity
 % 29 JAN 2025
@@ -95,7 +127,7 @@
 % K. McGarrity
 % 16 JAN 2020
 
-function output = MLrefprop(PropReq, Spec, Value1, Value2, Fluid, MassOrMolar, Composition, DesiredUnits, Path2Refprop, DebugOutput)
+function [output, status] = MLrefprop(PropReq, Spec, Value1, Value2, Fluid, MassOrMolar, Composition, DesiredUnits, Path2Refprop, DebugOutput, Model, Mask, DomainCheck, SharedCache, CacheEntries, LeverRule)
     arguments
         PropReq       (1, :)char;
         Spec          (1, :)char;
@@ -107,15 +139,14 @@ function output = MLrefprop(PropReq, Spec, Value1, Value2, Fluid, MassOrMolar, C
         DesiredUnits  (1, :)char;
         Path2Refprop  (1, :)char;
         DebugOutput   (1, 1)double;
+        Model         (1, :)char {mustBeMember(Model, {'exact', 'fast'})} = 'exact';
+        Mask                logical = logical.empty;
+        DomainCheck   (1, 1)logical = false;
+        SharedCache   (1, :)char = '';
+        CacheEntries  (1, 1)double {mustBeInteger, mustBePositive} = 1e6;
+        LeverRule     (1, 1)logical = false;
     end
     
-    PossibleSpecs  = {'T', 'P', 'D', 'E', 'H', 'S', 'Q'};   % Temperature, Pressure, Density, Energy, Enthalpy, Entropy, Quality
-    AddonsAfter1   = {'MELT', 'SUBL'};                      % Melting or sublimation point given the input properties
-    AddonsAfter2   = {'L', '>', '<', 'V'};                  % Single phase liquid (L, >), Single Phase Vaopor (<, V)
-
-    SupportedSpecFlags   = {'NBP', 'CRIT', 'TRIP', 'DSAT', 'HSAT', 'HSAT2', 'SSAT', 'SSAT2', 'SSAT3'};
-    UnsupportedSpecFlags = {'FLAGS', 'EOSMIN', 'EOSMAX', 'SETREF', 'SETREFOFF', 'PATH', 'SATSPLN'};
-
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
     % Checking ProprReq Validity %
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -133,98 +164,30 @@ function output = MLrefprop(PropReq, Spec, Value1, Value2, Fluid, MassOrMolar, C
     %     error('PropReq was given as %s, but MLrefprop does not support use of these flags at this time.', PropReq);
     % end
 
-    %%%%%%%%%%%%%%%%%%%%%%%%%%
-    % Checking Spec Validity %
-    %%%%%%%%%%%%%%%%%%%%%%%%%%
-    mainMessage = 'it should be a pair of unique letters from the following: T, P, D, E, H, S, Q.';
-    enhcMessage = 'It may be enhanced with one of the following: L, <, >, V, MELT, SUBL.';
-    flagMessage = 'it may be one of the following supported flags: CRIT, TRIP, DSAT, NBP, HSAT, HSAT2, SSAT, SSAT2, SSAT3.';
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % Checking Spec validity, shared with prepareFluidProperty in validateRefpropSpec %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    validateRefpropSpec(Spec);
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % Checking the REFPROP path, Fluid and Composition, padding Composition to 20 elements %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    Composition = validateRefpropInputs(Fluid, Composition, Path2Refprop);
 
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    % Checking Path2Refprop validity %
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    if ~exist(Path2Refprop, 'dir')
-        error(Path2Refprop + " does not exist. Please specify the path to your RefProp installation.");
-    else
-        rpDir = struct2table(dir(Path2Refprop));
-        if ~any(strcmp(rpDir.name, "REFPRP64.DLL"))
-            error(Path2Refprop + " does not contain ""REFPRP64.DLL"". Please specify the path to your RefProp installation.")
-        end % end if the directory does not contain REFPROP.EXE
-    end % end if not, else, refprop directory exists
-  
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    % Must have at least two characters %
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    if (size(Spec, 2) < 2) 
-        error('Spec was given as %s, but %s\n%s\nOr %s', Spec, mainMessage, enhcMessage, flagMessage)
-    elseif (size(Spec, 2) == 2)
-        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-        % if there are two characters,                      %
-        % they must both be from the allowed character list %
-        % and must be different from each other             %
-        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-        if strcmp(Spec, '  ')
-           % noop (Two blank spaces allows for critical and triple point reqs.)
-        elseif (    (~(    any(strcmpi(Spec(1), PossibleSpecs))    ...
-                    && any(strcmpi(Spec(2), PossibleSpecs)) ) )...
-             || (          strcmpi(Spec(1), Spec(2)      )    ) )
-            error('Spec was given as %s, but %s\n%s\nOr %s', Spec, mainMessage, enhcMessage, flagMessage)
-        end
-    elseif (size(Spec, 2) == 3) 
-        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-        % if there are three characters,                                              %
-        %   Either: the first two characters must be from the allowed character list  %
-        %           and the third character must be from the add-on character list    %
-        %           and the first two characters must be different from each other    %
-        %     OR    it can be "NBP" -> one of the supported flags                     %
-        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-        if(    (    (~(    any(strcmpi(Spec(1), PossibleSpecs  ))     ...
-                        && any(strcmpi(Spec(2), PossibleSpecs  ))     ...
-                        && any(strcmpi(Spec(3), AddonsAfter2   ))) )  ...
-                || (           strcmpi(Spec(1), Spec(2)        )   ) )...
-            && (          ~any(strcmpi(Spec, SupportedSpecFlags))    ) )
-            error('Spec was given as %s, but %s\n%s\nOr %s', Spec, mainMessage, enhcMessage, flagMessage)
-        end
-    else % (size(Spec, 2)  > 3)
-        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-        % if there are four or more characters,                                       %
-        %   Either: the first character must be from the allowed character list       %
-        %           and the rest of the entry must be from the add-on character list  %
-        %     OR    it can one of the supported flags (NOT one of the unsupported)    %
-        %    ELSE   if it is of the supported flags, send a message about it          %
-        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-        if(    (~(    any(strcmpi(Spec(1),     PossibleSpecs))    ...
-                   && any(strcmpi(Spec(2:end), AddonsAfter1 ))) ) ...
-            && (     ~any(strcmpi(Spec, SupportedSpecFlags  ))  ) ...
-            && (     ~any(strcmpi(Spec, UnsupportedSpecFlags))  ) )
-            error('Spec was given as %s, but %s\n%s\nOr %s', Spec, mainMessage, enhcMessage, flagMessage)
-        elseif any(strcmpi(Spec, UnsupportedSpecFlags))
-            error('Spec was given as %s, but MLrefprop does not support use of this flag at this time.', Spec);
-        end 
-    end
-    
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    % Checking validity of Composition and Fluid since there must be one fluid for every  %
-    % composition entry, we want to make sure they match in size. Also, Composition must  %
-    % have at least one and no more than twenty elements, and the elements must sum to 1. %
-    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    nelCmp = numel(Composition);
-    nelFld = numel(strsplit(Fluid, ';'));
-    if nelCmp ~= nelFld
-        error('Fluid must contain the same number of elements as the specified composition. Currently, you have specified %d fluids: %s, and %d compositions', nelFld, Fluid, nelCmp);
-    end
-    if (sum(Composition) < (1 - 0.0001)) || (sum(Composition) > (1 + 0.0001)) || any(Composition < 0)
-        error('Composition must contain positive values between 0 and 1, which sum to 1. Currently, your composition sums to %d', sum(Composition));
-    end
-    if nelCmp > 20
-        error('Composition and Fluid cannot have more than 20 elements. Currently, your Composition and Fluid arrays contains %d elements.', nelCmp);
-    end
-    Composition = [Composition, zeros(1, (20 - nelCmp))];
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
     % call to the mex function that queries refprop %
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
     try
-      output = hiLevelMexC(PropReq, Spec, Value1, Value2, Fluid, MassOrMolar, Composition, DesiredUnits, Path2Refprop, DebugOutput);
+      % Value1 as a column expands against the row Value2 to the MxN grid of every pair. Every optional input is
+      % passed, its default evaluates as hiLevelMexC does without it, and status is only returned when requested
+      args    = {PropReq, Spec, Value1(:), Value2, Fluid, MassOrMolar, Composition, DesiredUnits, Path2Refprop,...
+                 DebugOutput, Model, Mask, double(DomainCheck), SharedCache, CacheEntries, double(LeverRule)};
+      results = cell(1, max(nargout, 1));
+      [results{:}] = hiLevelMexC(args{:});
+      output  = results{1};
+      if nargout > 1
+          status = results{2};
+      end
     catch ME
         %%%%%%%%%%%%%%%%%%%%%%%%%
         % Get the error message %
@@ -249,5 +212,6 @@ function output = MLrefprop(PropReq, Spec, Value1, Value2, Fluid, MassOrMolar, C
         warning('Error in REFPROP call. Check message below.');
         disp(msg)
         output = [];
+        status = [];
     end % end try/catch block
 end % end function MLrefprop
\ No newline at end of file
@@ -0,0 +1,189 @@
+/*=============================================================================================*
+ *  batchMexC.cpp - heterogeneous batch of REFPROP records written with the MEX C api.         *
+ *                  Each record has its own input pair and output, so a state table mixing     *
+ *                  TQ, PH, PS and TP flashes is evaluated by one call with one fluid setup.   *
+ *                                                                                             *
+ *  From MATLAB(R):                                                                               *
+ *       [output, ierr] = batchMexC(propReq, spec, value1, value2, fluid, iMass, z, unit_char, *
+ *                                  path)                                                      *
+ *                                                                                             *
+ *  Where (see: https://refprop-docs.readthedocs.io/en/latest/DLL/high_level.html)             *
+ *    output    = DOUBLE (array of size Kx1) output from RefProp of record k, NaN if it failed *
+ *    ierr      = DOUBLE (array of size Kx1) REFPROP error of record k, 0 if it succeeded      *
+ *    propReq   = CELL of CHAR values accepted by REFPROP as 'hOut' values, 1 or K of them     *
+ *    spec      = CELL of CHAR values accepted by REFPROP as 'hIn'  values, 1 or K of them     *
+ *    value1    = DOUBLE (array of K elements) of values related to the first character in     *
+ *                the spec of each record                                                      *
+ *    value2    = DOUBLE (array of K elements) of values related to the second character in    *
+ *                the spec of each record                                                      *
+ *    fluid     = CHAR value accepted by REFPROP as 'hFld' values                              *
+ *    iMass     = INT value to determine input units: 0 -> Molar, 1 -> Mass (sets iMass)       *
+ *    z         = DOUBLE (array of size 1x20) of species fractions                             *
+ *    unit_char = CHAR value to determine units to use (enum as expected by refprop.dll)       *
+ *    path      = CHAR path to Refprop directory (e.g. C:\\ProgramFiles (x86)\\REFPROP)        *
+ *                                                                                             *
+ *  The records are evaluated in order by refpropEngine.cpp, which this file is compiled with. *
+ *=============================================================================================*/
+
+// Copyright 2026 The MathWorks, Inc.
+
+#include "refpropEngine.h"
+
+#include <string>
+#include <vector>
+#include "mex.h"
+
+////////////////////////////////////////////////////////////////////////////////////////
+// libut routine that reports a pending Ctrl-C, the mex file must be linked with -lut //
+////////////////////////////////////////////////////////////////////////////////////////
+extern "C" bool utIsInterruptPending(void);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// function to check that the number and type of arguments, in and out, are as expected //
+//////////////////////////////////////////////////////////////////////////////////////////
+void checkArguments(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
+{
+    int expectedIn = 9;   // expected number of input variables
+
+    if(numOutArg > 2)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:batchMexC:nlhs", "Incorrect number of outputs were given, at most 2 outputs are allowed");
+    }
+
+    if(numInArg != expectedIn)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:batchMexC:nrhs", "%i inputs were given, but %i are expected.", numInArg, expectedIn);
+    }
+    else if(!mxIsCell(inputs[0]) || !mxIsCell(inputs[1]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:batchMexC:prhs", "Input variables propReq and spec expected to be CELL arrays of CHAR.");
+    }
+    else if(!mxIsDouble(inputs[2]) || mxIsComplex(inputs[2]) || !mxIsDouble(inputs[3]) || mxIsComplex(inputs[3]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:batchMexC:prhs", "Input variables value1 and value2 expected to be of type DOUBLE (real).");
+    }
+    else if(mxGetNumberOfElements(inputs[2]) != mxGetNumberOfElements(inputs[3]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:batchMexC:prhs", "Input variables value1 and value2 must have one element per record, %zu and %zu were given.",
+                          mxGetNumberOfElements(inputs[2]), mxGetNumberOfElements(inputs[3]));
+    }
+    else if(!mxIsChar(inputs[4]) || !mxIsChar(inputs[7]) || !mxIsChar(inputs[8]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:batchMexC:prhs", "Input variables fluid, unit_char and path expected to be of type CHAR.");
+    }
+    else if(!mxIsDouble(inputs[5]) || !mxIsDouble(inputs[6]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:batchMexC:prhs", "Input variables iMass and z expected to be of type DOUBLE.");
+    }
+    else if(mxGetNumberOfElements(inputs[6]) != 20)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:batchMexC:prhs", "Input variable z expected to have 20 elements, %zu were given.", mxGetNumberOfElements(inputs[6]));
+    }
+} // end function checkArguments
+
+/////////////////////////////////////////////////////////////////////////////////
+// read a cell of 1 or numRecords strings into text, one pointer per record in //
+// names, so a single propReq or spec is shared by every record                //
+/////////////////////////////////////////////////////////////////////////////////
+static void readRecordStrings(const mxArray *cell, const char *name, size_t numRecords,
+                              std::vector<std::string> &text, std::vector<const char *> &names)
+{
+    size_t numCell = mxGetNumberOfElements(cell);
+    if ((numCell != 1) && (numCell != numRecords))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:batchMexC:prhs", "Input variable %s has %zu elements, 1 or %zu were expected.", name, numCell, numRecords);
+    }
+
+    text.resize(numCell);
+    for (size_t itc = 0; itc < numCell; itc++)
+    {
+        const mxArray *entry = mxGetCell(cell, itc);
+        if ((entry == NULL) || !mxIsChar(entry))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:batchMexC:prhs", "Element %zu of input variable %s expected to be of type CHAR.", itc + 1, name);
+        }
+        char *value = mxArrayToString(entry);
+        text[itc]   = value;
+        mxFree(value);
+    } // end loop over cell elements
+
+    names.resize(numRecords);
+    for (size_t itr = 0; itr < numRecords; itr++)
+    {
+        names[itr] = text[(numCell == 1) ? 0 : itr].c_str();
+    } // end loop over records
+} // end function readRecordStrings
+
+static int mexInterrupted(void *)
+{
+    return utIsInterruptPending() ? 1 : 0;
+} // end function mexInterrupted
+
+void mexFunction(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
+{
+    checkArguments(numOutArg, outputs, numInArg, inputs);
+
+    size_t                    numRecords = mxGetNumberOfElements(inputs[2]);   // one record per value1 entry
+    std::vector<std::string>  propReqText;                                     // propReq strings as given
+    std::vector<std::string>  specText;                                        // spec strings as given
+    std::vector<const char *> propReq;                                         // propReq of each record
+    std::vector<const char *> spec;                                            // spec of each record
+    readRecordStrings(inputs[0], "propReq", numRecords, propReqText, propReq);
+    readRecordStrings(inputs[1], "spec",    numRecords, specText,    spec);
+
+    char fluid    [RPE_FLUID_LENGTH];                    // String for fluid type
+    char unit_char[RPE_STRING_LENGTH];                   // Sets up which units to use -> molar or mass, SI or English
+    char path     [RPE_FLUID_LENGTH];                    // location of reprop dll
+    mxGetString(inputs[4], fluid,     sizeof(fluid));
+    mxGetString(inputs[7], unit_char, sizeof(unit_char));
+    mxGetString(inputs[8], path,      sizeof(path));
+    int           iMass = int(mxGetScalar(inputs[5]));   // Specifies mole or mass based input composition -> 0 = mole, 1 = mass
+    const double *z     = mxGetPr(inputs[6]);            // Composition on a mole or mass basis depending on iMass
+
+    outputs[0] = mxCreateDoubleMatrix(numRecords, 1, mxREAL);
+    std::vector<int> ierr(numRecords, 0);                // REFPROP error of each record
+
+    int         status;                                  // rpeStatus of the last engine call
+    rpeSession *session = rpeOpen(path, &status);
+    if (session == NULL)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:batchMexC:load", "%s", rpeLastError(NULL));
+    }
+    status = rpeSetFluid(session, fluid, z, iMass);
+    if (status == RPE_OK)
+    {
+        status = rpeSetUnits(session, unit_char);
+    }
+    if (status == RPE_OK)
+    {
+        rpeSetInterruptCheck(session, mexInterrupted, NULL);
+        status = rpeEvaluateRecords(session, numRecords, propReq.data(), spec.data(), mxGetPr(inputs[2]),
+                                    mxGetPr(inputs[3]), mxGetPr(outputs[0]), ierr.data());
+    }
+    size_t      numFailed = rpeNumFailed(session);
+    std::string msg(rpeLastError(session));
+    rpeClose(session);
+
+    if (status == RPE_ERR_INTERRUPTED)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:batchMexC:interrupt", "%s", msg.c_str());
+    }
+    else if (status != RPE_OK)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:batchMexC:refprop", "%s", msg.c_str());
+    }
+    else if ((numFailed > 0) && (numOutArg < 2))
+    {
+        mexWarnMsgIdAndTxt("MyToolbox:batchMexC:refprop", "%zu of %zu records failed and returned NaN, the last: %s", numFailed, numRecords, msg.c_str());
+    } // end if interrupted, else if failed, else if some records failed without ierr requested
+
+    if (numOutArg > 1)
+    {
+        outputs[1] = mxCreateDoubleMatrix(numRecords, 1, mxREAL);
+        double *ierrOut = mxGetPr(outputs[1]);
+        for (size_t itr = 0; itr < numRecords; itr++)
+        {
+            ierrOut[itr] = double(ierr[itr]);
+        } // end loop over records
+    } // end if the errors are requested
+} // end function mexFunction
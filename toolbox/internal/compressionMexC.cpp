@@ -0,0 +1,569 @@
+/*=============================================================================================*
+ *  compressionMexC.cpp - compression and expansion path integrator written with the MEX C api *
+ *                        Marches a batch of operating points from their inlet state to their  *
+ *                        outlet pressure in small pressure steps with one REFPROP load and    *
+ *                        one fluid setup, optionally in stages with intercooling.             *
+ *                                                                                             *
+ *  From MATLAB(R):                                                                               *
+ *       [path, summary] = compressionMexC(fluid, z, iMass, points, numSteps, numStages,       *
+ *                                         TIntercool, polytropic, refpropPath)                *
+ *                                                                                             *
+ *  Where (see: https://refprop-docs.readthedocs.io/en/latest/DLL/legacy.html)                 *
+ *    path       = DOUBLE (array of size (numStages*(numSteps+1))x6xK) node values of          *
+ *                 operating point k on page k with columns P (Pa), H (J/kg), T (K),           *
+ *                 S (J/(kg K)), D (kg/m^3) and Q (kg/kg). Each stage has its inlet and        *
+ *                 numSteps nodes, the inlet of a stage after the first is the intercooler     *
+ *                 outlet. Nodes from the one REFPROP failed on are NaN                        *
+ *    summary    = DOUBLE (array of size Kx3) with columns head, work and intercooler heat     *
+ *                 (J/kg), head and work are positive for compression and negative for         *
+ *                 expansion, the heat is the heat removed by the intercoolers, negative when  *
+ *                 they reheat between expansion stages                                        *
+ *    fluid      = CHAR value accepted by REFPROP as 'hFld' values (for mulit-species,         *
+ *                 list numSpec fluids separated by a semicolon (;), where 1 < numSpec <= 20   *
+ *    z          = DOUBLE (array of size 1x20) of species fractions                            *
+ *    iMass      = INT value to determine input units: 0 -> Molar, 1 -> Mass (sets iMass)      *
+ *    points     = DOUBLE (array of size Kx4) with columns inlet pressure (Pa), inlet enthalpy *
+ *                 (J/kg), outlet pressure (Pa) and efficiency, one row per operating point    *
+ *    numSteps   = DOUBLE number of pressure steps per stage, of equal pressure ratio          *
+ *    numStages  = DOUBLE number of stages, of equal pressure ratio                            *
+ *    TIntercool = DOUBLE temperature (K) the intercoolers bring the fluid to between stages,  *
+ *                 NaN for none                                                                *
+ *    polytropic = DOUBLE (1 -> the efficiency is polytropic, 0 -> isentropic per stage)       *
+ *    refpropPath = CHAR path to Refprop directory (e.g. C:\\ProgramFiles (x86)\\REFPROP)      *
+ *                                                                                             *
+ *  A polytropic path integrates dh = v dp / eta for compression and dh = eta v dp for         *
+ *  expansion by Heun's method, and the head is the integral of v dp. With isentropic          *
+ *  efficiency each node lies at the stage inlet enthalpy plus the isentropic change from the  *
+ *  stage inlet to its pressure, scaled by the efficiency. Single-phase nodes are solved by    *
+ *  Newton iterations on T started from the previous node's T and density, a full flash is     *
+ *  only used for two-phase nodes and where the phase changes. Q of a single-phase node        *
+ *  follows REFPROP: -998 for liquid, 998 for vapor and 999 above the critical pressure, so it *
+ *  is never taken for a saturated state.                                                      *
+ *=============================================================================================*/
+
+// Copyright 2026 The MathWorks, Inc.
+
+#define REFPROP_IMPLEMENTATION
+#define REFPROP_FUNCTION_MODIFIER
+#undef UNICODE
+#include "REFPROP_lib.h"
+#undef REFPROP_FUNCTION_MODIFIER
+#undef REFPROP_IMPLEMENTATION
+#include "refpropMexHelpers.h"
+
+#include <string>
+#include <math.h>
+#include "mex.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// libut routine that reports a pending Ctrl-C, the mex file must be linked with -lut   //
+//////////////////////////////////////////////////////////////////////////////////////////
+extern "C" bool utIsInterruptPending(void);
+
+static const size_t numPath    = 6;       // P, H, T, S, D, Q
+static const size_t numSummary = 3;       // head, work, intercooler heat
+static const int    maxNewton  = 20;      // Newton iterations before a node falls back to a full flash
+static const double newtonTol  = 1.0e-9;  // relative tolerance of the Newton iterations on H or S
+
+////////////////////////////////////////////////////////////////////////////////
+// a solved node in molar units, kph is the phase it was solved in: 1 liquid, //
+// 2 vapor, 0 two-phase or not solved, so the next node needs a full flash    //
+////////////////////////////////////////////////////////////////////////////////
+struct PathNode
+{
+    double T   = 0.0;   // K
+    double D   = 0.0;   // mol/L
+    double h   = 0.0;   // J/mol
+    double s   = 0.0;   // J/(mol K)
+    double cp  = 0.0;   // J/(mol K)
+    double q   = NAN;   // kg/kg
+    int    kph = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// enthalpy and entropy of the saturated liquid (bubble) and vapor (dew) at a //
+// pressure, valid is false above the critical pressure                       //
+////////////////////////////////////////////////////////////////////////////////
+struct SaturationBounds
+{
+    bool   valid = false;
+    double h[2];
+    double s[2];
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// function to check that the number and type of arguments, in and out, are as expected //
+//////////////////////////////////////////////////////////////////////////////////////////
+void checkArguments(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
+{
+    int expectedIn = 9;  // expected number of input variables
+    int inputInt;
+    double inputDouble;
+
+    if(numOutArg > 2)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:compressionMexC:nlhs", "Incorrect number of outputs were given, no more than 2 outputs are allowed");
+    }
+
+    if(numInArg != expectedIn)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:compressionMexC:nrhs", "%i inputs were given, but %i are expected.", numInArg, expectedIn);
+    }
+    else if(!mxIsChar(inputs[0]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:compressionMexC:prhs", "Input variable FluidType expected to be of type CHAR.");
+    }
+    else if(!mxIsDouble(inputs[1]) || (mxGetNumberOfElements(inputs[1]) != 20))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:compressionMexC:prhs", "Input variable z expected to be of type DOUBLE with 20 elements.");
+    }
+    else if(!mxIsDouble(inputs[2]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:compressionMexC:prhs", "Input variable MassOrMolar expected to be of type DOUBLE with values of 0 or 1.");
+    }
+    else if(!mxIsDouble(inputs[3]) || (mxGetN(inputs[3]) != 4))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:compressionMexC:prhs", "Input variable Points expected to be of type DOUBLE of size Kx4.");
+    }
+    else if(!mxIsDouble(inputs[4]) || !mxIsDouble(inputs[5]) || !mxIsDouble(inputs[6]) || !mxIsDouble(inputs[7]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:compressionMexC:prhs", "Input variables NumSteps, NumStages, TIntercool and Polytropic expected to be of type DOUBLE.");
+    }
+    else if(!mxIsChar(inputs[8]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:compressionMexC:prhs", "Input variable PathToRefPropDll expected to be of type CHAR.");
+    }
+    else
+    {
+        inputDouble = mxGetScalar(inputs[2]);
+        inputInt    = int(inputDouble);
+        if ((double(inputInt) != inputDouble) || ((inputInt != 0) && (inputInt != 1)))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:compressionMexC:prhs",
+                              "MassOrMolar input of %f is invalid. Acceptable values are 0 for Molar and 1 for Mass to select desired units.", inputDouble);
+        } // end if MassOrMolar is invalid
+
+        for (int itn = 4; itn < 6; itn++)
+        {
+            inputDouble = mxGetScalar(inputs[itn]);
+            if ((inputDouble < 1.0) || (inputDouble != floor(inputDouble)))
+            {
+                mexErrMsgIdAndTxt("MyToolbox:compressionMexC:prhs", "%s input of %f is invalid. It must be a positive integer.",
+                                  (itn == 4) ? "NumSteps" : "NumStages", inputDouble);
+            } // end if the number is invalid
+        } // end loop over NumSteps and NumStages
+
+        const double *points    = mxGetPr(inputs[3]);
+        size_t        numPoints = mxGetM(inputs[3]);
+        for (size_t itk = 0; itk < numPoints; itk++)
+        {
+            double eta = points[numPoints * 3 + itk];
+            if (!(points[itk] > 0.0) || !(points[numPoints * 2 + itk] > 0.0) || !(eta > 0.0) || (eta > 1.0))
+            {
+                mexErrMsgIdAndTxt("MyToolbox:compressionMexC:prhs",
+                                  "Operating point %zu is invalid. The pressures must be positive and the efficiency in (0, 1].", itk + 1);
+            } // end if the operating point is invalid
+        } // end loop over operating points
+    } // end if input types not as expected, else check values
+} // end function checkArguments
+
+////////////////////////////////////////////////////////////////////////////////////
+// saturated liquid and vapor enthalpy and entropy at Pk (kPa). A pure fluid gets //
+// both phases from one SATPdll call, a mixture needs its bubble and dew points   //
+////////////////////////////////////////////////////////////////////////////////////
+static void saturationBounds(double Pk, double *z, bool pure, SaturationBounds &sat, char *herr)
+{
+    int    ierr = 0;
+    int    kph  = 1;
+    double T, Dl, Dv, x[20], y[20], p, e, cv, cp, w, hjt;
+
+    sat.valid = false;
+    SATPdll(Pk, z, kph, T, Dl, Dv, x, y, ierr, herr, herr_length);
+    if (ierr > 0)
+    {
+        return;
+    }
+    THERMdll(T, Dl, z, p, e, sat.h[0], sat.s[0], cv, cp, w, hjt);
+    if (!pure)
+    {
+        kph = 2;
+        SATPdll(Pk, z, kph, T, Dl, Dv, x, y, ierr, herr, herr_length);
+        if (ierr > 0)
+        {
+            return;
+        }
+    } // end if the dew point needs its own call
+    THERMdll(T, Dv, z, p, e, sat.h[1], sat.s[1], cv, cp, w, hjt);
+    sat.valid = true;
+} // end function saturationBounds
+
+/////////////////////////////////////////////////////////////////////////////////////
+// T and molar density at Pk (kPa) where h (or s when byEntropy) equals target, by //
+// Newton iterations on T started from T and D of node, whose cp gives the first   //
+// step. node is only updated when the iterations converge, so the caller can      //
+// flash instead                                                                   //
+/////////////////////////////////////////////////////////////////////////////////////
+static bool newtonPX(double Pk, double target, bool byEntropy, double *z, int kph, PathNode &node)
+{
+    int    ierr   = 0;
+    int    kguess = 1;      // TPRHOdll starts from the density in D
+    char   herr[herr_length];
+    double T      = node.T;
+    double D      = node.D;
+    double cp     = node.cp;
+    double value  = byEntropy ? node.s : node.h;
+    double p, e, h, s, cv, w, hjt;
+
+    for (int itn = 0; itn < maxNewton; itn++)
+    {
+        T = T + (target - value) / (byEntropy ? (cp / T) : cp);
+        if (!(T > 0.0))
+        {
+            return false;
+        }
+        TPRHOdll(T, Pk, z, kph, kguess, D, ierr, herr, herr_length);
+        if (ierr > 0)
+        {
+            return false;
+        }
+        THERMdll(T, D, z, p, e, h, s, cv, cp, w, hjt);
+        value = byEntropy ? s : h;
+        if (fabs(target - value) <= newtonTol * (1.0 + fabs(target)))
+        {
+            node.T  = T;
+            node.D  = D;
+            node.h  = h;
+            node.s  = s;
+            node.cp = cp;
+            return true;
+        }
+    } // end loop over Newton iterations
+    return false;
+} // end function newtonPX
+
+/////////////////////////////////////////////////////////////////////////
+// quality of a single-phase node as REFPROP reports it: -998 liquid,  //
+// 998 vapor and 999 above the critical pressure                       //
+/////////////////////////////////////////////////////////////////////////
+static double singlePhaseQuality(const SaturationBounds &sat, int kph)
+{
+    if (!sat.valid)
+    {
+        return 999.0;
+    }
+    return (kph == 2) ? 998.0 : -998.0;
+} // end function singlePhaseQuality
+
+////////////////////////////////////////////////////////////////////////////////////////
+// solve node at Pk (kPa) for the molar enthalpy target, or entropy when byEntropy.   //
+// Single-phase nodes are warm started from node when it was solved in the same phase //
+// and flashed otherwise, two-phase nodes are flashed. Returns false when REFPROP     //
+// fails, with its message in herr                                                    //
+////////////////////////////////////////////////////////////////////////////////////////
+static bool solveNode(double Pk, double target, bool byEntropy, double *z, const SaturationBounds &sat, PathNode &node,
+                      char *herr)
+{
+    int           ierr   = 0;
+    int           kph    = 0;
+    const double *bounds = byEntropy ? sat.s : sat.h;
+    double        Dl, Dv, x[20], y[20], q, e, cv, w;
+
+    if (sat.valid && (target > bounds[0]) && (target < bounds[1]))
+    {
+        kph = 0;
+    }
+    else
+    {
+        kph = (sat.valid && (target >= bounds[1])) ? 2 : 1;
+        if ((node.kph == kph) && newtonPX(Pk, target, byEntropy, z, kph, node))
+        {
+            node.q = singlePhaseQuality(sat, kph);
+            return true;
+        }
+    } // end if two-phase, else try the warm start
+
+    if (byEntropy)
+    {
+        node.s = target;
+        PSFLSHdll(Pk, target, z, node.T, node.D, Dl, Dv, x, y, q, e, node.h, cv, node.cp, w, ierr, herr, herr_length);
+    }
+    else
+    {
+        node.h = target;
+        PHFLSHdll(Pk, target, z, node.T, node.D, Dl, Dv, x, y, q, e, node.s, cv, node.cp, w, ierr, herr, herr_length);
+    } // end if entropy, else enthalpy flash
+    node.kph = (ierr > 0) ? 0 : kph;
+    if (ierr > 0)
+    {
+        return false;
+    }
+    if (kph == 0)
+    {
+        double qkg, xkg[20], ykg[20], wliq, wvap;
+        QMASSdll(q, x, y, qkg, xkg, ykg, wliq, wvap, ierr, herr, herr_length);
+        node.q = (ierr <= 0) ? qkg : NAN;
+    }
+    else
+    {
+        node.q = singlePhaseQuality(sat, kph);
+    } // end if two-phase, else single-phase
+    return true;
+} // end function solveNode
+
+/////////////////////////////////////////////////////////////////////////
+// write node at Pk (kPa) to row r of a numRows x numPath path page in //
+// mass-based SI units                                                 //
+/////////////////////////////////////////////////////////////////////////
+static void writeNode(double *page, size_t numRows, size_t r, double Pk, const PathNode &node, double wmm)
+{
+    page[r]               = Pk * 1000.0;              // kPa -> Pa
+    page[numRows + r]     = node.h * 1000.0 / wmm;    // J/mol -> J/kg
+    page[numRows * 2 + r] = node.T;
+    page[numRows * 3 + r] = node.s * 1000.0 / wmm;    // J/(mol K) -> J/(kg K)
+    page[numRows * 4 + r] = node.D * wmm;             // mol/L -> kg/m^3
+    page[numRows * 5 + r] = node.q;
+} // end function writeNode
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// march one operating point {Pin, Hin, Pout, eta} through numStages stages of numSteps  //
+// steps, writing its nodes to page and head, work and intercooler heat (J/mol) to sums. //
+// The fluid is set once and the legacy routines reuse it for every node. Returns false  //
+// when a node fails, with the REFPROP error in lastError                                //
+///////////////////////////////////////////////////////////////////////////////////////////
+static bool marchPoint(double *z, bool pure, double wmm, const double *point, size_t numSteps, size_t numStages,
+                       double TIntercool, bool polytropic, double *page, double *sums, std::string &lastError)
+{
+    int    ierr        = 0;
+    char   herr[herr_length];
+    size_t numRows     = numStages * (numSteps + 1);
+    double Pin         = point[0] / 1000.0;            // Pa -> kPa
+    double Pout        = point[2] / 1000.0;
+    double eta         = point[3];
+    bool   compression = (Pout > Pin);
+    double stageRatio  = pow(Pout / Pin, 1.0 / double(numStages));
+    double Dl, Dv, x[20], y[20], q, e, h, s, cv, cp, w;
+    SaturationBounds sat;
+    PathNode         node, isentrope, stageIn;
+
+    sums[0] = 0.0;
+    sums[1] = 0.0;
+    sums[2] = 0.0;
+    saturationBounds(Pin, z, pure, sat, herr);
+    if (!solveNode(Pin, point[1] * wmm / 1000.0, false, z, sat, node, herr))   // J/kg -> J/mol
+    {
+        lastError = herr;
+        return false;
+    }
+
+    for (size_t itg = 0; itg < numStages; itg++)
+    {
+        double Pa = Pin * pow(stageRatio, double(itg));
+        double Pb = (itg + 1 == numStages) ? Pout : Pa * stageRatio;
+        size_t r  = itg * (numSteps + 1);
+        writeNode(page, numRows, r, Pa, node, wmm);
+        stageIn   = node;
+        isentrope = node;
+
+        double factor = compression ? (1.0 / eta) : eta;   // actual over reversible enthalpy change
+        double Pprev  = Pa;
+        for (size_t itj = 1; itj <= numSteps; itj++)
+        {
+            double Pk = (itj == numSteps) ? Pb : Pa * pow(Pb / Pa, double(itj) / double(numSteps));
+            double hNext;
+            saturationBounds(Pk, z, pure, sat, herr);
+
+            if (polytropic)
+            {
+                ////////////////////////////////////////////////////////////////////////////
+                // dh = factor v dp by Heun's method: the predictor takes v of the        //
+                // previous node, the corrector the mean v of both ends of the step. The  //
+                // corrector is warm started from the predictor, (L/mol) kPa is J/mol     //
+                ////////////////////////////////////////////////////////////////////////////
+                PathNode predictor = node;
+                if (!solveNode(Pk, node.h + factor * (Pk - Pprev) / node.D, false, z, sat, predictor, herr))
+                {
+                    lastError = herr;
+                    return false;
+                }
+                double vdp = 0.5 * (Pk - Pprev) * (1.0 / node.D + 1.0 / predictor.D);
+                sums[0]   += vdp;
+                hNext      = node.h + factor * vdp;
+                node       = predictor;
+            }
+            else
+            {
+                ////////////////////////////////////////////////////////////////////////
+                // the isentrope from the stage inlet to Pk, scaled by the efficiency //
+                ////////////////////////////////////////////////////////////////////////
+                if (!solveNode(Pk, stageIn.s, true, z, sat, isentrope, herr))
+                {
+                    lastError = herr;
+                    return false;
+                }
+                hNext = stageIn.h + factor * (isentrope.h - stageIn.h);
+            } // end if polytropic, else isentropic efficiency
+            Pprev = Pk;
+
+            if (!solveNode(Pk, hNext, false, z, sat, node, herr))
+            {
+                lastError = herr;
+                return false;
+            }
+            writeNode(page, numRows, r + itj, Pk, node, wmm);
+        } // end loop over steps
+        if (!polytropic)
+        {
+            sums[0] += isentrope.h - stageIn.h;
+        }
+        sums[1] += node.h - stageIn.h;
+
+        ///////////////////////////////////////////////////////////////////////////
+        // the intercooler takes the stage outlet to TIntercool at the stage     //
+        // outlet pressure, the next stage starts from its enthalpy with a flash //
+        ///////////////////////////////////////////////////////////////////////////
+        if ((itg + 1 < numStages) && !isnan(TIntercool))
+        {
+            double T = TIntercool;
+            double D;
+            TPFLSHdll(T, Pb, z, D, Dl, Dv, x, y, q, e, h, s, cv, cp, w, ierr, herr, herr_length);
+            if (ierr > 0)
+            {
+                lastError = herr;
+                return false;
+            }
+            sums[2] += node.h - h;
+            node.kph = 0;
+            if (!solveNode(Pb, h, false, z, sat, node, herr))
+            {
+                lastError = herr;
+                return false;
+            }
+        } // end if intercooled
+    } // end loop over stages
+    return true;
+} // end function marchPoint
+
+void mexFunction(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
+{
+    ///////////////////////////////////////////////////////////////////////
+    // check that the input and output variables have the correct format //
+    ///////////////////////////////////////////////////////////////////////
+    checkArguments(numOutArg, outputs, numInArg, inputs);
+
+    ///////////////////////////////
+    // getting the actual inputs //
+    ///////////////////////////////
+    char         *fluid      = mxArrayToString(inputs[0]);                // String for fluid type
+    const double *zIn        = mxGetPr(inputs[1]);                        // composition as given
+          int     iMass      = int(mxGetScalar(inputs[2]));               // Specifies mole or mass based input composition -> 0 = mole, 1 = mass
+    const double *points     = mxGetPr(inputs[3]);                        // rows of Pin, Hin, Pout, efficiency
+          size_t  numPoints  = mxGetM(inputs[3]);                         // operating points
+          size_t  numSteps   = size_t(mxGetScalar(inputs[4]));            // pressure steps per stage
+          size_t  numStages  = size_t(mxGetScalar(inputs[5]));            // stages
+          double  TIntercool = mxGetScalar(inputs[6]);                    // intercooler outlet temperature, NaN for none
+          bool    polytropic = (mxGetScalar(inputs[7]) != 0.0);           // polytropic, else isentropic efficiency
+    std::string   path       = std::string(mxArrayToString(inputs[8]));   // location of reprop dll
+          size_t  numRows    = numStages * (numSteps + 1);                // nodes of each operating point
+
+    //////////////////////////////////////////////
+    // Allocate memory for the output variables //
+    //////////////////////////////////////////////
+    mwSize pathDims[3] = {numRows, numPath, numPoints};
+    outputs[0] = mxCreateNumericArray(3, pathDims, mxDOUBLE_CLASS, mxREAL);           // [rows x 6 x K] paths
+    mxArray *summaryArray = mxCreateNumericMatrix(numPoints, numSummary, mxDOUBLE_CLASS, mxREAL);  // [K x 3] summary
+    double  *pathOut      = mxGetPr(outputs[0]);
+    double  *summaryOut   = mxGetPr(summaryArray);
+    std::fill(pathOut, pathOut + numRows * numPath * numPoints, NAN);
+    std::fill(summaryOut, summaryOut + numPoints * numSummary, NAN);
+
+    ///////////////////////////
+    // Setup local variables //
+    ///////////////////////////
+    int    ierr      = 0;                       // OUTPUT: error flag -> 0 = successful, !0 = unsuccessful
+    int    mixFlag   = 0;                       // flag to determine whether input is mixture
+    size_t numFailed = 0;                       // operating points REFPROP could not march to their outlet
+    double zFluid[20];                          // composition as given, a .MIX file fills it in
+    double z[20];                               // Composition on a mole basis
+    double wmm;                                 // molar mass of the fluid (g/mol)
+    double sums[numSummary];                    // head, work and intercooler heat of a point (J/mol)
+    std::string lastError;                      // error of the last operating point that failed
+#if defined(_WIN32)
+    std::string DLL_name = "REFPRP64.DLL";      // Refprop dll used on Windows
+#else
+    std::string DLL_name = "";                  // librefprop.so or librefprop.dylib
+#endif
+    std::string serr;                           // load_REFPROP requires the error variable to be a string
+
+    /////////////////////////////
+    // loading the Refprop dll //
+    /////////////////////////////
+    if (!load_REFPROP(serr, path, DLL_name))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:compressionMexC:load", "REFPROP failed to load from: %s -> %s", path.c_str(), serr.c_str());
+    }
+    SETPATHdll(const_cast<char*>(path.c_str()), 255);
+
+    std::copy(zIn, zIn + 20, zFluid);
+    setRefpropFluid(fluid, zFluid, mixFlag, ierr);
+    if (ierr != 0)
+    {
+        unload_REFPROP(serr);
+        mexErrMsgIdAndTxt("MyToolbox:compressionMexC:prhs", "Fluid %s failed to set.", fluid);
+    }
+    if ((iMass == 1) && !isMixFile(fluid))
+    {
+        XMOLEdll(zFluid, z, wmm);
+    }
+    else
+    {
+        std::copy(zFluid, zFluid + 20, z);
+    } // end if mass, else molar composition
+    WMOLdll(z, wmm);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // the fluid stays set for every operating point, each one is marched on //
+    // its own since its nodes warm start from the previous node of its path //
+    ///////////////////////////////////////////////////////////////////////////
+    for (size_t itk = 0; itk < numPoints; itk++)
+    {
+        if (utIsInterruptPending())
+        {
+            unload_REFPROP(serr);
+            mexErrMsgIdAndTxt("MyToolbox:compressionMexC:interrupt", "Interrupted after %zu of %zu operating points.", itk, numPoints);
+        }
+        double point[4] = {points[itk], points[numPoints + itk], points[numPoints * 2 + itk], points[numPoints * 3 + itk]};
+        if (!marchPoint(z, (mixFlag == 0), wmm, point, numSteps, numStages, TIntercool, polytropic,
+                        pathOut + numRows * numPath * itk, sums, lastError))
+        {
+            numFailed++;
+            continue;
+        }
+        for (size_t its = 0; its < numSummary; its++)
+        {
+            summaryOut[numPoints * its + itk] = sums[its] * 1000.0 / wmm;   // J/mol -> J/kg
+        } // end loop over summary columns
+    } // end loop over operating points
+
+    if (numFailed > 0)
+    {
+        mexWarnMsgIdAndTxt("MyToolbox:compressionMexC:refprop", "%zu of %zu operating points failed, their paths are NaN from the failed node: %s",
+                           numFailed, numPoints, lastError.c_str());
+    } // end if operating points failed
+
+    //////////////////////////////////////////
+    // Unload refprop to release the memory //
+    //////////////////////////////////////////
+    if (!unload_REFPROP(serr))
+    {
+        mexWarnMsgIdAndTxt("MyToolbox:compressionMexC:unload", "REFPROP failed to unload properly.");
+    } // if REFPROP failed to unload
+
+    if (numOutArg > 1)
+    {
+        outputs[1] = summaryArray;
+    }
+    else
+    {
+        mxDestroyArray(summaryArray);
+    } // end if summary requested
+} // end function mexFunction -> entry point
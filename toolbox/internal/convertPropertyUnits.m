@@ -0,0 +1,61 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% convertPropertyUnits
+%   Converts a whole array of property values between Unit and SI units in one vectorized pass. The flashes run in
+%   SI units, so the conversion costs one multiply and add per value whatever the flash path.
+%
+%   From MATLAB:
+%        Values = convertPropertyUnits(Values, Property, Unit, Direction)
+%
+%   Where
+%
+%       Values    = DOUBLE array of values of Property
+%       Property  = CHAR property name, its first letter selects the unit type: T, P, H or S (e.g. 'H', 'Hmass').
+%                        Every H and S unit is per kg, so H and S are only converted for the names H, Hmass, S and
+%                        Smass, not for molar names such as Hmolar and Smolar
+%       Unit      = CHAR unit from the tables of unit_convert_SI, e.g. 'kPa', 'degC', 'kJ/kg'. Specific entropy
+%                        units are an enthalpy unit and a temperature unit separated by '/', e.g. 'kJ/kg/degC'.
+%                        "" leaves Values unchanged
+%       Direction = DOUBLE 1 from Unit to SI, -1 from SI to Unit
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function Values = convertPropertyUnits(Values, Property, Unit, Direction)
+    arguments
+        Values                 double;
+        Property      (1, :) {mustBeText};
+        Unit          (1, :) {mustBeText};
+        Direction     (1, 1) double {mustBeMember(Direction, [-1, 1])};
+    end
+
+    if strlength(Unit) == 0
+        return
+    end
+
+    Type = upper(extractBefore(string(Property), 2));
+    if any(Type == ["H", "S"]) && ~any(strcmpi(Property, Type + ["", "mass"]))
+        error("Units can be converted for the specific (per kg) enthalpy and entropy only, not for " + Property...
+              + ". Request H, Hmass, S or Smass for an output in " + Unit + ".");
+    end
+    if Type == "S"
+        sx = find(char(Unit) == '/', 1, 'last');
+        if isempty(sx)
+            error("Specific entropy units are an enthalpy unit and a temperature unit, e.g. kJ/kg/K, not " + Unit + ".");
+        end
+        Unit = char(Unit);
+        [ScaleH, ~] = siUnitFactors(Unit(1:(sx - 1)), 'S');
+        [ScaleT, ~] = siUnitFactors(Unit((sx + 1):end), 'S');
+        Scale  = ScaleH * ScaleT;
+        Offset = 0;
+    elseif any(Type == ["T", "P", "H"])
+        [Scale, Offset] = siUnitFactors(Unit, Type);
+    else
+        error("Units can be converted for T, P, H and S only, not for " + Property + ".");
+    end
+
+    if Direction > 0
+        Values = Values*Scale + Offset;
+    else
+        Values = (Values - Offset)/Scale;
+    end
+end % end function convertPropertyUnits
@@ -0,0 +1,36 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% coolpropInputName
+%   Returns the name CoolProp's AbstractState input pairs use for a PropsSI input name. PropsSI accepts H, S, D and U
+%   on a mass basis, but the input pairs name them Hmass, Smass, Dmass and Umass, e.g. HmassP_INPUTS, so 'P' with
+%   'H' must be looked up as P and Hmass. T, P, Q and names that already carry their basis are returned as they are.
+%
+%   From MATLAB:
+%        Name = coolpropInputName(Input)
+%
+%   Where
+%
+%       Input   = CHAR PropsSI input name, e.g. 'P', 'H', 'Smass', 'Dmolar'; case is ignored
+%       Name    = CHAR the AbstractState input name, e.g. 'P', 'Hmass', 'Smass', 'Dmolar'
+%
+%   Example, the input pair of a P-H state point:
+%        pair = [coolpropInputName('H'), coolpropInputName('P'), '_INPUTS'];   % 'HmassP_INPUTS'
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function Name = coolpropInputName(Input)
+    arguments
+        Input         (1, :) {mustBeText};
+    end
+
+    PropsSINames       = ["T", "P", "Q", "H",     "S",     "D",     "U",     "HMASS", "SMASS", "DMASS", "UMASS",...
+                          "HMOLAR", "SMOLAR", "DMOLAR", "UMOLAR"];
+    AbstractStateNames = ["T", "P", "Q", "Hmass", "Smass", "Dmass", "Umass", "Hmass", "Smass", "Dmass", "Umass",...
+                          "Hmolar", "Smolar", "Dmolar", "Umolar"];
+
+    Name  = char(Input);
+    match = find(strcmpi(Name, PropsSINames), 1);
+    if ~isempty(match)
+        Name = char(AbstractStateNames(match));
+    end
+end % end function coolpropInputName
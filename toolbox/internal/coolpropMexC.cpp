@@ -0,0 +1,400 @@
+/*=============================================================================================*
+ *  coolpropMexC.cpp - multithreaded CoolProp state evaluation written with the MEX C api.     *
+ *                     Each thread owns one CoolProp AbstractState of the fluid, so the points *
+ *                     of a batch are solved on every core rather than in the MATLAB thread.   *
+ *                                                                                             *
+ *  From MATLAB(R):                                                                               *
+ *       output = coolpropMexC(path, backend, species, fractions, outputs, input1, value1,     *
+ *                             input2, value2, numThreads)                                     *
+ *                                                                                             *
+ *  Where (see: http://www.coolprop.org/coolprop/LowLevelAPI.html)                             *
+ *    output     = DOUBLE (array of size KxnumOut) output parameter j of point k in column j,  *
+ *                 NaN where CoolProp could not solve the point or return the parameter        *
+ *    path       = CHAR path to the CoolProp directory holding the shared library              *
+ *                 (CoolProp.dll, libCoolProp.so or libCoolProp.dylib)                         *
+ *    backend    = CHAR CoolProp backend, e.g. 'HEOS', 'BICUBIC&HEOS' or 'TTSE&HEOS'           *
+ *    species    = CHAR species of the fluid joined by &, e.g. 'Water' or 'R32&R125'           *
+ *    fractions  = DOUBLE (array of size 1xnumSpec) mole fractions, used for mixtures only     *
+ *    outputs    = CHAR output parameters separated by semicolons, e.g. 'Hmass;Smass;Dmass'    *
+ *    input1     = CHAR first input parameter as the input pairs name it, e.g. 'P'             *
+ *    value1     = DOUBLE (array of K elements) of values of input1                            *
+ *    input2     = CHAR second input parameter, e.g. 'Hmass' rather than the 'H' of PropsSI;   *
+ *                 coolpropInputName.m maps the PropsSI names                                  *
+ *    value2     = DOUBLE (array of K elements) of values of input2, paired with value1        *
+ *    numThreads = DOUBLE number of threads, 0 for one per core                                *
+ *                                                                                             *
+ *  The AbstractStates are created and freed in the MATLAB thread, as CoolProp keeps their     *
+ *  handles in one table; the threads only update them. The points are split into chunks of    *
+ *  chunkPoints, dealt to the threads in contiguous ranges; a thread that finishes its range   *
+ *  takes chunks from the end of the others' ranges, so uneven solve times (two-phase or near  *
+ *  critical points) do not leave cores idle. Ctrl-C stops the threads after their current     *
+ *  chunk.                                                                                     *
+ *=============================================================================================*/
+
+// Copyright 2026 The MathWorks, Inc.
+
+#if defined(_WIN32)
+#include <windows.h>
+#define CP_CALL __stdcall
+#else
+#include <dlfcn.h>
+#define CP_CALL
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <math.h>
+#include "mex.h"
+
+////////////////////////////////////////////////////////////////////////////////////////
+// libut routine that reports a pending Ctrl-C, the mex file must be linked with -lut //
+////////////////////////////////////////////////////////////////////////////////////////
+extern "C" bool utIsInterruptPending(void);
+
+static const size_t chunkPoints  = 256;    // points per chunk, the inputs and outputs of a chunk stay in cache
+static const long   errorLength  = 1000;   // length of the CoolProp error message buffers
+
+///////////////////////////////////////////////////////////////////////////
+// the functions of CoolProp's C interface (CoolPropLib.h) that are used //
+///////////////////////////////////////////////////////////////////////////
+typedef long   (CP_CALL *FactoryFn)(const char *, const char *, long *, char *, const long);
+typedef void   (CP_CALL *FreeFn)(const long, long *, char *, const long);
+typedef void   (CP_CALL *FractionsFn)(const long, const double *, const long, long *, char *, const long);
+typedef void   (CP_CALL *UpdateFn)(const long, const long, const double, const double, long *, char *, const long);
+typedef double (CP_CALL *KeyedOutputFn)(const long, const long, long *, char *, const long);
+typedef long   (CP_CALL *IndexFn)(const char *);
+
+struct CoolPropLibrary
+{
+#if defined(_WIN32)
+    HMODULE       module = NULL;
+#else
+    void         *module = NULL;
+#endif
+    FactoryFn     factory;
+    FreeFn        free;
+    FractionsFn   setFractions;
+    UpdateFn      update;
+    KeyedOutputFn keyedOutput;
+    IndexFn       inputPairIndex;
+    IndexFn       paramIndex;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// the chunks [next, end) a thread has left. The owner takes from next, other threads //
+// take from end                                                                      //
+////////////////////////////////////////////////////////////////////////////////////////
+struct ChunkRange
+{
+    std::mutex lock;
+    size_t     next = 0;
+    size_t     end  = 0;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// function to check that the number and type of arguments, in and out, are as expected //
+//////////////////////////////////////////////////////////////////////////////////////////
+void checkArguments(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
+{
+    int expectedIn = 10;  // expected number of input variables
+
+    if(numOutArg > 1)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:coolpropMexC:nlhs", "Incorrect number of outputs were given, only 1 output is allowed");
+    }
+
+    if(numInArg != expectedIn)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:coolpropMexC:nrhs", "%i inputs were given, but %i are expected.", numInArg, expectedIn);
+    }
+    else if(!mxIsChar(inputs[0]) || !mxIsChar(inputs[1]) || !mxIsChar(inputs[2]) || !mxIsChar(inputs[4]) ||
+            !mxIsChar(inputs[5]) || !mxIsChar(inputs[7]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:coolpropMexC:prhs", "Input variables path, backend, species, outputs, input1 and input2 expected to be of type CHAR.");
+    }
+    else if(!mxIsDouble(inputs[3]) || mxIsComplex(inputs[3]) || mxIsEmpty(inputs[3]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:coolpropMexC:prhs", "Input variable fractions expected to be of type DOUBLE (real).");
+    }
+    else if(!mxIsDouble(inputs[6]) || mxIsComplex(inputs[6]) || !mxIsDouble(inputs[8]) || mxIsComplex(inputs[8]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:coolpropMexC:prhs", "Input variables value1 and value2 expected to be of type DOUBLE (real).");
+    }
+    else if(mxGetNumberOfElements(inputs[6]) != mxGetNumberOfElements(inputs[8]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:coolpropMexC:prhs", "Input variables value1 and value2 must have one element per point, %zu and %zu were given.",
+                          mxGetNumberOfElements(inputs[6]), mxGetNumberOfElements(inputs[8]));
+    }
+    else if(!mxIsDouble(inputs[9]) || (mxGetScalar(inputs[9]) < 0.0))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:coolpropMexC:prhs", "Input variable numThreads expected to be a DOUBLE of 0 or more.");
+    }
+} // end function checkArguments
+
+static std::string getString(const mxArray *input)
+{
+    char       *chars = mxArrayToString(input);
+    std::string text(chars);
+    mxFree(chars);
+    return text;
+} // end function getString
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// open the CoolProp shared library in path. It is usually loaded already by MLCoolProp //
+// through loadlibrary, in which case this only takes another reference to it           //
+//////////////////////////////////////////////////////////////////////////////////////////
+static bool openCoolProp(const std::string &path, CoolPropLibrary &lib)
+{
+    std::string dir = (path.empty() || (path.back() == '/') || (path.back() == '\\')) ? path : path + "/";
+#if defined(_WIN32)
+    lib.module = LoadLibraryA((dir + "CoolProp.dll").c_str());
+#define CP_SYMBOL(name) GetProcAddress(lib.module, name)
+#else
+#if defined(__APPLE__)
+    const char *names[2] = {"libCoolProp.dylib", "CoolProp.dylib"};
+#else
+    const char *names[2] = {"libCoolProp.so", "CoolProp.so"};
+#endif
+    for (int itn = 0; (itn < 2) && (lib.module == NULL); itn++)
+    {
+        lib.module = dlopen((dir + names[itn]).c_str(), RTLD_NOW);
+    } // end loop over library names
+#define CP_SYMBOL(name) dlsym(lib.module, name)
+#endif
+    if (lib.module == NULL)
+    {
+        return false;
+    }
+    lib.factory        = reinterpret_cast<FactoryFn>(CP_SYMBOL("AbstractState_factory"));
+    lib.free           = reinterpret_cast<FreeFn>(CP_SYMBOL("AbstractState_free"));
+    lib.setFractions   = reinterpret_cast<FractionsFn>(CP_SYMBOL("AbstractState_set_fractions"));
+    lib.update         = reinterpret_cast<UpdateFn>(CP_SYMBOL("AbstractState_update"));
+    lib.keyedOutput    = reinterpret_cast<KeyedOutputFn>(CP_SYMBOL("AbstractState_keyed_output"));
+    lib.inputPairIndex = reinterpret_cast<IndexFn>(CP_SYMBOL("get_input_pair_index"));
+    lib.paramIndex     = reinterpret_cast<IndexFn>(CP_SYMBOL("get_param_index"));
+#undef CP_SYMBOL
+    return (lib.factory != NULL) && (lib.free != NULL) && (lib.setFractions != NULL) && (lib.update != NULL) &&
+           (lib.keyedOutput != NULL) && (lib.inputPairIndex != NULL) && (lib.paramIndex != NULL);
+} // end function openCoolProp
+
+static void closeCoolProp(CoolPropLibrary &lib)
+{
+    if (lib.module != NULL)
+    {
+#if defined(_WIN32)
+        FreeLibrary(lib.module);
+#else
+        dlclose(lib.module);
+#endif
+        lib.module = NULL;
+    }
+} // end function closeCoolProp
+
+/////////////////////////////////////////////////////////////////////////////////////
+// the next chunk for thread self: its own next chunk, else the last chunk of the  //
+// first other thread that has any left. False when no chunk is left anywhere      //
+/////////////////////////////////////////////////////////////////////////////////////
+static bool takeChunk(std::vector<ChunkRange> &ranges, size_t self, size_t &chunk)
+{
+    {
+        std::lock_guard<std::mutex> guard(ranges[self].lock);
+        if (ranges[self].next < ranges[self].end)
+        {
+            chunk = ranges[self].next++;
+            return true;
+        }
+    }
+    for (size_t offset = 1; offset < ranges.size(); offset++)
+    {
+        ChunkRange                 &victim = ranges[(self + offset) % ranges.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (victim.next < victim.end)
+        {
+            chunk = --victim.end;
+            return true;
+        }
+    } // end loop over the other threads
+    return false;
+} // end function takeChunk
+
+/////////////////////////////////////////////////////////////////////////////////////
+// evaluate chunks with the AbstractState of thread self until none is left or the //
+// evaluation is stopped. Each point is updated once and every output read from it //
+/////////////////////////////////////////////////////////////////////////////////////
+static void evaluateChunks(const CoolPropLibrary &lib, long handle, long inputPair, const std::vector<long> &outputIdx,
+                           const double *value1, const double *value2, size_t numPoints, double *output,
+                           std::vector<ChunkRange> &ranges, size_t self, const std::atomic<bool> &stop)
+{
+    long   ierr;
+    char   herr[errorLength];
+    size_t chunk;
+    while (!stop.load(std::memory_order_relaxed) && takeChunk(ranges, self, chunk))
+    {
+        size_t last = std::min(numPoints, (chunk + 1) * chunkPoints);
+        for (size_t itk = chunk * chunkPoints; itk < last; itk++)
+        {
+            ierr = 0;
+            lib.update(handle, inputPair, value1[itk], value2[itk], &ierr, herr, errorLength);
+            for (size_t ito = 0; ito < outputIdx.size(); ito++)
+            {
+                double value = NAN;
+                if (ierr == 0)
+                {
+                    long outErr = 0;
+                    value       = lib.keyedOutput(handle, outputIdx[ito], &outErr, herr, errorLength);
+                    value       = (outErr == 0) ? value : NAN;
+                }
+                output[ito * numPoints + itk] = value;
+            } // end loop over outputs
+        } // end loop over points of the chunk
+    } // end loop over chunks
+} // end function evaluateChunks
+
+void mexFunction(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
+{
+    checkArguments(numOutArg, outputs, numInArg, inputs);
+
+    std::string   path      = getString(inputs[0]);
+    std::string   backend   = getString(inputs[1]);
+    std::string   species   = getString(inputs[2]);
+    std::string   outText   = getString(inputs[4]);
+    std::string   input1    = getString(inputs[5]);
+    std::string   input2    = getString(inputs[7]);
+    const double *fractions = mxGetPr(inputs[3]);
+    long          numSpec   = long(mxGetNumberOfElements(inputs[3]));
+    const double *value1    = mxGetPr(inputs[6]);
+    const double *value2    = mxGetPr(inputs[8]);
+    size_t        numPoints = mxGetNumberOfElements(inputs[6]);
+    size_t        numChunks = (numPoints + chunkPoints - 1) / chunkPoints;
+    size_t        numThreads = size_t(mxGetScalar(inputs[9]));
+    if (numThreads == 0)
+    {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    numThreads = std::max(size_t(1), std::min(numThreads, numChunks));
+
+    CoolPropLibrary lib;
+    if (!openCoolProp(path, lib))
+    {
+        closeCoolProp(lib);
+        mexErrMsgIdAndTxt("MyToolbox:coolpropMexC:load", "CoolProp failed to load from: %s", path.c_str());
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    // the inputs come named as the pairs name them (coolpropInputName.m), and  //
+    // CoolProp only accepts each input pair in one order, e.g. PT_INPUTS but   //
+    // not TP_INPUTS, so the values are swapped when the other order is known   //
+    //////////////////////////////////////////////////////////////////////////////
+    long inputPair = lib.inputPairIndex((input1 + input2 + "_INPUTS").c_str());
+    if (inputPair < 0)
+    {
+        inputPair = lib.inputPairIndex((input2 + input1 + "_INPUTS").c_str());
+        std::swap(value1, value2);
+    }
+    std::vector<long> outputIdx;
+    size_t            start = 0;
+    while (start <= outText.size())
+    {
+        size_t      end  = std::min(outText.find(';', start), outText.size());
+        std::string name = outText.substr(start, end - start);
+        outputIdx.push_back(lib.paramIndex(name.c_str()));
+        if (outputIdx.back() < 0)
+        {
+            closeCoolProp(lib);
+            mexErrMsgIdAndTxt("MyToolbox:coolpropMexC:prhs", "CoolProp does not recognize the parameter %s.", name.c_str());
+        }
+        start = end + 1;
+    } // end loop over output parameters
+    if (inputPair < 0)
+    {
+        closeCoolProp(lib);
+        mexErrMsgIdAndTxt("MyToolbox:coolpropMexC:prhs", "CoolProp does not accept the input pair %s and %s.", input1.c_str(), input2.c_str());
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    // one AbstractState per thread, created here since CoolProp's handle table //
+    // is not guarded against threads adding to it                              //
+    //////////////////////////////////////////////////////////////////////////////
+    long              ierr = 0;
+    char              herr[errorLength] = "";
+    std::vector<long> handles;
+    for (size_t itt = 0; (itt < numThreads) && (ierr == 0); itt++)
+    {
+        long handle = lib.factory(backend.c_str(), species.c_str(), &ierr, herr, errorLength);
+        if (ierr == 0)
+        {
+            handles.push_back(handle);
+            if (numSpec > 1)
+            {
+                lib.setFractions(handle, fractions, numSpec, &ierr, herr, errorLength);
+            }
+        }
+    } // end loop over threads
+    if (ierr != 0)
+    {
+        long freeErr;
+        char freeMsg[errorLength];
+        for (long handle : handles)
+        {
+            lib.free(handle, &freeErr, freeMsg, errorLength);
+        } // end loop over created states
+        std::string msg(herr);
+        closeCoolProp(lib);
+        mexErrMsgIdAndTxt("MyToolbox:coolpropMexC:coolprop", "CoolProp could not create the %s state of %s: %s", backend.c_str(), species.c_str(), msg.c_str());
+    }
+
+    outputs[0]     = mxCreateDoubleMatrix(numPoints, outputIdx.size(), mxREAL);
+    double *output = mxGetPr(outputs[0]);
+
+    /////////////////////////////////////////////////////////////////////////////////
+    // deal the chunks to the threads in contiguous ranges, then wait for them in  //
+    // the MATLAB thread, which is the only one allowed to check for Ctrl-C        //
+    /////////////////////////////////////////////////////////////////////////////////
+    std::vector<ChunkRange>  ranges(numThreads);
+    std::vector<std::thread> workers;
+    std::atomic<bool>        stop(false);
+    std::atomic<size_t>      numRunning(numThreads);
+    for (size_t itt = 0; itt < numThreads; itt++)
+    {
+        ranges[itt].next = (numChunks * itt) / numThreads;
+        ranges[itt].end  = (numChunks * (itt + 1)) / numThreads;
+    } // end loop over threads
+    for (size_t itt = 0; itt < numThreads; itt++)
+    {
+        workers.emplace_back([&, itt]() {
+            evaluateChunks(lib, handles[itt], inputPair, outputIdx, value1, value2, numPoints, output, ranges, itt,
+                           stop);
+            numRunning--;
+        });
+    } // end loop over threads
+    bool interrupted = false;
+    while (numRunning.load() > 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        if (!interrupted && utIsInterruptPending())
+        {
+            interrupted = true;
+            stop.store(true);
+        }
+    } // end loop until the threads are done
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    } // end loop over threads
+
+    for (long handle : handles)
+    {
+        lib.free(handle, &ierr, herr, errorLength);
+    } // end loop over states
+    closeCoolProp(lib);
+
+    if (interrupted)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:coolpropMexC:interrupt", "Interrupted before all %zu points were evaluated.", numPoints);
+    }
+} // end function mexFunction
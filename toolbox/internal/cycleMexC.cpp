@@ -0,0 +1,351 @@
+/*=============================================================================================*
+ *  cycleMexC.cpp - single-stage vapor-compression cycle kernel written with the MEX C api.    *
+ *                  Evaluates every state point of the cycle for a batch of designs with one   *
+ *                  REFPROP load and one fluid setup.                                          *
+ *                                                                                             *
+ *  From MATLAB(R):                                                                               *
+ *       [states, perf] = cycleMexC(fluid, iMass, z, designs, path)                            *
+ *                                                                                             *
+ *  Where (see: https://refprop-docs.readthedocs.io/en/latest/DLL/high_level.html)             *
+ *    states    = DOUBLE (array of size 8x5xK) state table for each of the K designs. Rows are *
+ *                the 8 cycle states of designCycleSingle_REFPROP.m, columns are P, H, S, T, Q *
+ *                in MASS BASE SI units (Pa, J/kg, J/(kg K), K, kg/kg)                         *
+ *    perf      = DOUBLE (array of size Kx4) with columns: COP, specific cooling capacity      *
+ *                (h1 - h6), specific compressor work (h2 - h1), specific condenser heat       *
+ *                (h2 - h5); capacities in J/kg                                                *
+ *    fluid     = CHAR value accepted by REFPROP as 'hFld' values (for mulit-species,          *
+ *                list numSpec fluids separated by a semicolon (;), where 1 < numSpec <= 20    *
+ *    iMass     = INT value to determine input units: 0 -> Molar, 1 -> Mass (sets iMass)       *
+ *    z         = DOUBLE (array of size 1x20) of species fractions                             *
+ *    designs   = DOUBLE (array of size Kx5) one design per row with columns:                  *
+ *                saturated evaporating temperature (K), saturated condensing temperature (K), *
+ *                subcooling (K), superheat (K), compressor isentropic efficiency (-)          *
+ *    path      = CHAR path to Refprop directory (e.g. C:\\ProgramFiles (x86)\\REFPROP)        *
+ *=============================================================================================*/
+
+// Copyright 2026 The MathWorks, Inc.
+
+#define REFPROP_IMPLEMENTATION
+#define REFPROP_FUNCTION_MODIFIER
+#undef UNICODE
+#include "REFPROP_lib.h"
+#undef REFPROP_FUNCTION_MODIFIER
+#undef REFPROP_IMPLEMENTATION
+#include "refpropMexHelpers.h"
+
+#include <string>
+#include <math.h>
+#include "mex.h"
+
+static const size_t numStates = 8;  // states of the single-stage cycle
+static const size_t numCols   = 5;  // P, H, S, T, Q
+static const size_t numPerf   = 4;  // COP, cooling capacity, compressor work, condenser heat
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// function to check that the number and type of arguments, in and out, are as expected //
+//////////////////////////////////////////////////////////////////////////////////////////
+void checkArguments(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
+{
+    int expectedIn = 5;   // expected number of input variables
+    int inputInt;
+    double inputDouble;
+
+    if(numOutArg > 2)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:cycleMexC:nlhs", "Incorrect number of outputs were given, no more than 2 outputs are allowed");
+    }
+
+    if(numInArg != expectedIn)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:cycleMexC:nrhs", "%i inputs were given, but %i are expected.", numInArg, expectedIn);
+    }
+    else if(!mxIsChar(inputs[0]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:cycleMexC:prhs", "Input variable substance (or mixture) expected to be of type CHAR.");
+    }
+    else if(!mxIsDouble(inputs[1]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:cycleMexC:prhs", "Input variable MassOrMolar expected to be of type DOUBLE with values of 0 or 1.");
+    }
+    else if(!mxIsDouble(inputs[2]) || (mxGetNumberOfElements(inputs[2]) != 20))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:cycleMexC:prhs", "Input variable Composition expected to be of type DOUBLE with 20 elements.");
+    }
+    else if(!mxIsDouble(inputs[3]) || (mxGetN(inputs[3]) != numCols))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:cycleMexC:prhs", "Input variable Designs expected to be of type DOUBLE with %zu columns.", numCols);
+    }
+    else if(!mxIsChar(inputs[4]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:cycleMexC:prhs", "Input variable PathToRefPropDll expected to be of type CHAR.");
+    }
+    else
+    {
+        inputDouble = mxGetScalar(inputs[1]);
+        inputInt    = int(inputDouble);
+        if ((double(inputInt) != inputDouble) || ((inputInt != 0) && (inputInt != 1)))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:cycleMexC:prhs",
+                              "MassOrMolar input of %f is invalid. Acceptable values are 0 for Molar and 1 for Mass to select desired units.", inputDouble);
+        } // end if MassOrMolar is invalid
+    } // end if input types not as expected, else check values
+} // end function checkArguments
+
+////////////////////////////////////////////////////////////////////////////////////////
+// evaluate one design, filling the 8x5 state table and the performance values.       //
+// Returns the first non-zero REFPROP error flag (0 if every state was evaluated).     //
+////////////////////////////////////////////////////////////////////////////////////////
+static int evaluateDesign(const char *fluid, int iUnits, int mixFlag, double *z, const double *design,
+                          double *P, double *H, double *S, double *T, double *Q, double *perf, char *herr)
+{
+    double T_sat_evap = design[0];  // saturated evaporating temperature
+    double T_sat_cond = design[1];  // saturated condensing temperature
+    double T_sc       = design[2];  // subcooling at the condenser outlet
+    double T_sh       = design[3];  // superheat at the evaporator outlet
+    double eta_s      = design[4];  // compressor isentropic efficiency
+    double hOutput[200];            // OUTPUT: Array of properties specified by hOut
+    double q;                       // OUTPUT: Vapor quality
+    double x[20];                   // OUTPUT: Composition of liquid phase
+    double y[20];                   // OUTPUT: Composition of vapor phase
+    int    ierr;
+    size_t itr;
+
+    //////////////////////////////////////////////////////////////////////////////////
+    // every call below uses iMass = 0 since the composition is already converted   //
+    // to mole fractions; the order of the calls matches designCycleSingle_REFPROP.m //
+    //////////////////////////////////////////////////////////////////////////////////
+
+    // saturation pressures at the evaporating and condensing temperatures
+    ierr = callREFPROPdll(fluid, "QT", "P", iUnits, 0, mixFlag, 1.0, T_sat_evap, z, hOutput, q, x, y, herr);
+    if (ierr > 0)
+    {
+        return ierr;
+    }
+    P[0] = hOutput[0];
+
+    ierr = callREFPROPdll(fluid, "QT", "P", iUnits, 0, mixFlag, 1.0, T_sat_cond, z, hOutput, q, x, y, herr);
+    if (ierr > 0)
+    {
+        return ierr;
+    }
+    P[1] = hOutput[0];
+    P[2] = P[1];  // condenser, saturated vapor
+    P[3] = P[1];  // condenser, saturated liquid
+    P[4] = P[1];  // condenser outlet, subcooled liquid
+    P[5] = P[0];  // expansion valve outlet, mixture
+    P[6] = P[0];  // evaporator, saturated vapor
+    P[7] = P[0];  // evaporator outlet, superheated vapor
+
+    // enthalpy at each state
+    ierr = callREFPROPdll(fluid, "PT", "H", iUnits, 0, mixFlag, P[0], T_sat_evap + T_sh, z, hOutput, q, x, y, herr);
+    if (ierr > 0)
+    {
+        return ierr;
+    }
+    H[0] = hOutput[0];
+
+    ierr = callREFPROPdll(fluid, "PH", "S", iUnits, 0, mixFlag, P[0], H[0], z, hOutput, q, x, y, herr);
+    if (ierr > 0)
+    {
+        return ierr;
+    }
+    S[0] = hOutput[0];
+
+    ierr = callREFPROPdll(fluid, "PS", "H", iUnits, 0, mixFlag, P[1], S[0], z, hOutput, q, x, y, herr);
+    if (ierr > 0)
+    {
+        return ierr;
+    }
+    H[1] = (hOutput[0] - H[0]) / eta_s + H[0];
+
+    ierr = callREFPROPdll(fluid, "PQ", "H", iUnits, 0, mixFlag, P[2], 1.0, z, hOutput, q, x, y, herr);
+    if (ierr > 0)
+    {
+        return ierr;
+    }
+    H[2] = hOutput[0];
+
+    ierr = callREFPROPdll(fluid, "PQ", "H", iUnits, 0, mixFlag, P[3], 0.0, z, hOutput, q, x, y, herr);
+    if (ierr > 0)
+    {
+        return ierr;
+    }
+    H[3] = hOutput[0];
+
+    ierr = callREFPROPdll(fluid, "PT", "H", iUnits, 0, mixFlag, P[4], T_sat_cond - T_sc, z, hOutput, q, x, y, herr);
+    if (ierr > 0)
+    {
+        return ierr;
+    }
+    H[4] = hOutput[0];
+    H[5] = H[4];  // isenthalpic expansion
+    ierr = callREFPROPdll(fluid, "PQ", "H", iUnits, 0, mixFlag, P[6], 1.0, z, hOutput, q, x, y, herr);
+    if (ierr > 0)
+    {
+        return ierr;
+    }
+    H[6] = hOutput[0];
+    H[7] = H[0];
+
+    // temperature and entropy at each state from one flash on (P, H)
+    for (itr = 0; itr < numStates; itr++)
+    {
+        ierr = callREFPROPdll(fluid, "PH", "T;S;QMASS", iUnits, 0, mixFlag, P[itr], H[itr], z, hOutput, q, x, y, herr);
+        if (ierr > 0)
+        {
+            return ierr;
+        }
+        T[itr] = hOutput[0];
+        S[itr] = hOutput[1];
+        Q[itr] = hOutput[2];
+    } // end loop over states
+
+    /////////////////////////////////////////////////////////////////////////////
+    // the example script fixes the quality at the saturated and single-phase  //
+    // states, only the mixture leaving the expansion valve is taken as solved //
+    /////////////////////////////////////////////////////////////////////////////
+    Q[0] = 1.0;  Q[1] = 1.0;  Q[2] = 1.0;  Q[6] = 1.0;  Q[7] = 1.0;
+    Q[3] = 0.0;  Q[4] = 0.0;
+
+    perf[1] = H[0] - H[5];      // specific cooling capacity
+    perf[2] = H[1] - H[0];      // specific compressor work
+    perf[3] = H[1] - H[4];      // specific condenser heat rejection
+    perf[0] = perf[1] / perf[2];
+    return 0;
+} // end function evaluateDesign
+
+void mexFunction(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
+{
+    ///////////////////////////////////////////////////////////////////////
+    // check that the input and output variables have the correct format //
+    ///////////////////////////////////////////////////////////////////////
+    checkArguments(numOutArg, outputs, numInArg, inputs);
+
+    ///////////////////////////////
+    // getting the actual inputs //
+    ///////////////////////////////
+    const char   *fluid     = mxArrayToString(inputs[0]);               // String for fluid type
+          int     iMass     = int(mxGetScalar(inputs[1]));              // Specifies mole or mass based input composition -> 0 = mole, 1 = mass
+          double *zIn       = mxGetPr(        inputs[2]);               // Composition on a mole or mass basis depending on iMass
+    const double *designs   = mxGetPr(        inputs[3]);               // one design per row
+    std::string   path      = std::string(mxArrayToString(inputs[4]));  // location of reprop dll
+          size_t  numDesign = mxGetM(inputs[3]);                        // number of designs (K)
+
+    ////////////////////////////////////////////////
+    // Allocate memory for the output variables   //
+    ////////////////////////////////////////////////
+    mwSize stateDims[3] = {numStates, numCols, numDesign};
+    outputs[0] = mxCreateNumericArray(3, stateDims, mxDOUBLE_CLASS, mxREAL);           // [8 x 5 x K] state tables
+    mxArray *perfArray = mxCreateNumericMatrix(numDesign, numPerf, mxDOUBLE_CLASS, mxREAL); // [K x 4] performance
+    double  *stateOut  = mxGetPr(outputs[0]);
+    double  *perfOut   = mxGetPr(perfArray);
+
+    ///////////////////////////
+    // Setup local variables //
+    ///////////////////////////
+    size_t itd        = 0;                      // iterator over designs
+    size_t itc        = 0;                      // iterator over design columns
+    int    ierr       = 0;                      // OUTPUT: error flag -> 0 = successful, !0 = unsuccessful
+    int    iUnits     = 0;                      // INPUT:  Enumeration to denote which unit system to use
+    int    mixFlag    = 0;                      // flag to determine whether input is mixture
+    int    iFlag      = 0;                      // INPUT:  GETENUMdll checks all possible strings
+    double z[20];                               // Composition on a mole basis
+    double wmm;                                 // molar mass of the mixture (not used)
+    double design[numCols];                     // one row of the design matrix
+    double perf[numPerf];                       // performance of one design
+    char   herr[255];                           // OUTPUT: Error string
+    char   unitString[] = "MASS BASE SI";       // all cycle values are returned in SI units
+#if defined(_WIN32)
+    std::string DLL_name = "REFPRP64.DLL";      // Refprop dll used on Windows
+#else
+    std::string DLL_name = "";                  // librefprop.so or librefprop.dylib
+#endif
+    std::string serr;                           // load_REFPROP requires the error variable to be a string
+
+    /////////////////////////////
+    // loading the Refprop dll //
+    /////////////////////////////
+    if (!load_REFPROP(serr, path, DLL_name))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:cycleMexC:load", "REFPROP failed to load from: %s -> %s", path.c_str(), serr.c_str());
+    }
+    SETPATHdll(const_cast<char*>(path.c_str()), 255);
+
+    ////////////////////////////////////
+    // setting the fluid only once    //
+    ////////////////////////////////////
+    setRefpropFluid(fluid, zIn, mixFlag, ierr);
+    if (ierr != 0)
+    {
+        unload_REFPROP(serr);
+        mexErrMsgIdAndTxt("MyToolbox:cycleMexC:prhs", "Fluid %s failed to set: Error %d", fluid, ierr);
+    }
+
+    ///////////////////////////////////////////////////////////////////////
+    // convert a mass based composition once rather than on every call.  //
+    // A .MIX file has already returned its composition in mole fraction //
+    ///////////////////////////////////////////////////////////////////////
+    if ((iMass == 1) && !isMixFile(fluid))
+    {
+        XMOLEdll(zIn, z, wmm);
+    }
+    else
+    {
+        std::copy(zIn, zIn + 20, z);
+    } // end if mass, else molar composition
+
+    GETENUMdll(iFlag, unitString, iUnits, ierr, herr, hUnits_length, herr_length);
+    if (ierr != 0)
+    {
+        unload_REFPROP(serr);
+        mexErrMsgIdAndTxt("MyToolbox:cycleMexC:prhs", "Converting %s to enum failed: Error %d -> %s", unitString, ierr, herr);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // loop over the designs. After the fluid has been set in the first call, the //
+    // fluid string is passed as blank so REFPROP keeps the loaded fluid          //
+    ////////////////////////////////////////////////////////////////////////////////
+    for (itd = 0; itd < numDesign; itd++)
+    {
+        for (itc = 0; itc < numCols; itc++)
+        {
+            design[itc] = designs[(numDesign * itc) + itd];
+        } // end loop over design columns
+
+        double *P = stateOut + (numStates * numCols * itd);
+        double *H = P + numStates;
+        double *S = H + numStates;
+        double *T = S + numStates;
+        double *Q = T + numStates;
+
+        ierr = evaluateDesign((itd == 0) ? fluid : " ", iUnits, mixFlag, z, design, P, H, S, T, Q, perf, herr);
+        if (ierr != 0)
+        {
+            mexWarnMsgIdAndTxt("MyToolbox:cycleMexC:refprop", "Design %zu failed: WARNING %d %s", itd + 1, ierr, herr);
+            std::fill(P, P + (numStates * numCols), NAN);
+            std::fill(perf, perf + numPerf, NAN);
+        }
+
+        for (itc = 0; itc < numPerf; itc++)
+        {
+            perfOut[(numDesign * itc) + itd] = perf[itc];
+        } // end loop over performance columns
+    } // end loop over designs
+
+    //////////////////////////////////////////
+    // Unload refprop to release the memory //
+    //////////////////////////////////////////
+    if (!unload_REFPROP(serr))
+    {
+        mexWarnMsgIdAndTxt("MyToolbox:cycleMexC:unload", "REFPROP failed to unload properly.");
+    } // if REFPROP failed to unload
+
+    if (numOutArg > 1)
+    {
+        outputs[1] = perfArray;
+    }
+    else
+    {
+        mxDestroyArray(perfArray);
+    } // end if performance requested
+} // end function mexFunction -> entry point
@@ -0,0 +1,372 @@
+/*=============================================================================================*
+ *  derivativeMexC.cpp - property values and analytic partial derivatives from one flash per   *
+ *                       state point, written with the MEX C api.                              *
+ *                                                                                             *
+ *  From MATLAB(R):                                                                               *
+ *       output = derivativeMexC(propReq, derivReq, spec, value1, value2, fluid, iMass, z,     *
+ *                               path, zipped)                                                 *
+ *                                                                                             *
+ *  Where (see: https://refprop-docs.readthedocs.io/en/latest/DLL/legacy.html)                 *
+ *    output    = DOUBLE (array of size MxNx(numProp+numDeriv)) in MASS BASE SI units. The     *
+ *                first numProp pages hold the properties in propReq, followed by one page     *
+ *                per derivative in derivReq. When zipped is 1 the array is of size            *
+ *                Mx1x(numProp+numDeriv)                                                       *
+ *    propReq   = CHAR semicolon separated list of 'hOut' values (may be empty)                *
+ *    derivReq  = CHAR semicolon separated list of derivatives, each given by three letters    *
+ *                abc for (da/db) at constant c, where a, b and c are one of T, P, D, H, S, E  *
+ *                e.g. "HPT;DTP;THP" for dh/dP|T, drho/dT|P and dT/dh|P                        *
+ *    spec      = CHAR value accepted by REFPROP as 'hIn'  values                              *
+ *    value1    = DOUBLE (array of size 1xM) of values related to the first character in spec  *
+ *    value2    = DOUBLE (array of size 1xN) of values related to the second character in spec *
+ *    fluid     = CHAR value accepted by REFPROP as 'hFld' values (for mulit-species,          *
+ *                list numSpec fluids separated by a semicolon (;), where 1 < numSpec <= 20    *
+ *    iMass     = INT value to determine input units: 0 -> Molar, 1 -> Mass (sets iMass)       *
+ *    z         = DOUBLE (array of size 1x20) of species fractions                             *
+ *    path      = CHAR path to Refprop directory (e.g. C:\\ProgramFiles (x86)\\REFPROP)        *
+ *    zipped    = DOUBLE value (0 for every pair of value1 and value2, 1 for value1(k) with    *
+ *                value2(k) only, in which case M must equal N)                                *
+ *                                                                                             *
+ *  Every derivative is built from the partials with respect to temperature and density that   *
+ *  THERM2dll returns for the solved state, so no derivative needs another flash. The          *
+ *  derivatives are single-phase derivatives and are NaN for two-phase states.                 *
+ *=============================================================================================*/
+
+// Copyright 2026 The MathWorks, Inc.
+
+#define REFPROP_IMPLEMENTATION
+#define REFPROP_FUNCTION_MODIFIER
+#undef UNICODE
+#include "REFPROP_lib.h"
+#undef REFPROP_FUNCTION_MODIFIER
+#undef REFPROP_IMPLEMENTATION
+#include "refpropMexHelpers.h"
+
+#include <string>
+#include <vector>
+#include <math.h>
+#include "mex.h"
+
+static const size_t numFlash    = 2;         // T and D are always requested from the flash
+static const char   derivVars[] = "TPDHSE";  // variables a derivative can be taken of, with respect to, or at constant
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// function to check that the number and type of arguments, in and out, are as expected //
+//////////////////////////////////////////////////////////////////////////////////////////
+void checkArguments(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
+{
+    int expectedIn = 10;   // expected number of input variables
+    int inputInt;
+    double inputDouble;
+
+    if(numOutArg > 1)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:derivativeMexC:nlhs", "Incorrect number of outputs were given, only 1 output is allowed");
+    }
+
+    if(numInArg != expectedIn)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:derivativeMexC:nrhs", "%i inputs were given, but %i are expected.", numInArg, expectedIn);
+    }
+    else if(!mxIsChar(inputs[0]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:derivativeMexC:prhs", "Input variable propReq expected to be of type CHAR.");
+    }
+    else if(!mxIsChar(inputs[1]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:derivativeMexC:prhs", "Input variable derivReq expected to be of type CHAR.");
+    }
+    else if(!mxIsChar(inputs[2]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:derivativeMexC:prhs", "Input variable spec expected to be of type CHAR.");
+    }
+    else if(!mxIsDouble(inputs[3]) || !mxIsDouble(inputs[4]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:derivativeMexC:prhs", "Input variables value1 and value2 expected to be of type DOUBLE.");
+    }
+    else if(!mxIsChar(inputs[5]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:derivativeMexC:prhs", "Input variable substance (or mixture) expected to be of type CHAR.");
+    }
+    else if(!mxIsDouble(inputs[6]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:derivativeMexC:prhs", "Input variable MassOrMolar expected to be of type DOUBLE with values of 0 or 1.");
+    }
+    else if(!mxIsDouble(inputs[7]) || (mxGetNumberOfElements(inputs[7]) != 20))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:derivativeMexC:prhs", "Input variable Composition expected to be of type DOUBLE with 20 elements.");
+    }
+    else if(!mxIsChar(inputs[8]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:derivativeMexC:prhs", "Input variable PathToRefPropDll expected to be of type CHAR.");
+    }
+    else if(!mxIsDouble(inputs[9]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:derivativeMexC:prhs", "Input variable Zipped expected to be of type DOUBLE with values of 0 or 1.");
+    }
+    else
+    {
+        inputDouble = mxGetScalar(inputs[6]);
+        inputInt    = int(inputDouble);
+        if ((double(inputInt) != inputDouble) || ((inputInt != 0) && (inputInt != 1)))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:derivativeMexC:prhs",
+                              "MassOrMolar input of %f is invalid. Acceptable values are 0 for Molar and 1 for Mass to select desired units.", inputDouble);
+        } // end if MassOrMolar is invalid
+
+        if ((mxGetScalar(inputs[9]) != 0.0) && (mxGetNumberOfElements(inputs[3]) != mxGetNumberOfElements(inputs[4])))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:derivativeMexC:prhs",
+                              "Zipped inputs require value1 and value2 to have the same number of elements: %zu and %zu were given.",
+                              mxGetNumberOfElements(inputs[3]), mxGetNumberOfElements(inputs[4]));
+        } // end if zipped inputs differ in size
+    } // end if input types not as expected, else check values
+} // end function checkArguments
+
+////////////////////////////////////////////////////////////////////////////////////////
+// split derivReq into (of, wrt, constant) triples of indices into derivVars. Returns //
+// false and the offending entry in badEntry if an entry is not three valid letters.  //
+////////////////////////////////////////////////////////////////////////////////////////
+static bool parseDerivatives(const std::string &derivReq, std::vector<int> &derivIdx, std::string &badEntry)
+{
+    size_t bgn = 0;
+    while (bgn <= derivReq.length())
+    {
+        size_t      nnd   = derivReq.find(';', bgn);
+        std::string entry = derivReq.substr(bgn, (nnd == std::string::npos) ? std::string::npos : (nnd - bgn));
+
+        entry.erase(std::remove(entry.begin(), entry.end(), ' '), entry.end());
+        if (!entry.empty())
+        {
+            if (entry.length() != 3)
+            {
+                badEntry = entry;
+                return false;
+            }
+            for (size_t itv = 0; itv < 3; itv++)
+            {
+                const char *found = strchr(derivVars, toupper(entry[itv]));
+                if ((found == NULL) || (*found == '\0'))
+                {
+                    badEntry = entry;
+                    return false;
+                }
+                derivIdx.push_back(int(found - derivVars));
+            } // end loop over the letters of the entry
+        } // end if entry is not empty
+
+        if (nnd == std::string::npos)
+        {
+            break;
+        }
+        bgn = nnd + 1;
+    } // end loop over entries
+    return true;
+} // end function parseDerivatives
+
+void mexFunction(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
+{
+    ///////////////////////////////////////////////////////////////////////
+    // check that the input and output variables have the correct format //
+    ///////////////////////////////////////////////////////////////////////
+    checkArguments(numOutArg, outputs, numInArg, inputs);
+
+    ///////////////////////////////
+    // getting the actual inputs //
+    ///////////////////////////////
+    const char   *propReq   = mxArrayToString(inputs[0]);               // Properties requested for output
+    const char   *derivReq  = mxArrayToString(inputs[1]);               // Derivatives requested for output
+    const char   *specSum   = mxArrayToString(inputs[2]);               // characters encoding spec variables
+    const double *value1    = mxGetPr(        inputs[3]);               // values for first  spec variable
+    const double *value2    = mxGetPr(        inputs[4]);               // values for second spec variable
+    const char   *fluid     = mxArrayToString(inputs[5]);               // String for fluid type
+          int     iMass     = int(mxGetScalar(inputs[6]));              // Specifies mole or mass based input composition -> 0 = mole, 1 = mass
+          double *zIn       = mxGetPr(        inputs[7]);               // Composition on a mole or mass basis depending on iMass
+    std::string   path      = std::string(mxArrayToString(inputs[8]));  // location of reprop dll
+          bool    zipped    = (mxGetScalar(inputs[9]) != 0.0);          // pair value1(k) with value2(k) only
+          size_t  numelVal1 = mxGetNumberOfElements(inputs[3]);         // number of values for the first spec
+          size_t  numelVal2 = mxGetNumberOfElements(inputs[4]);         // number of values for the second spec
+
+    std::vector<int> derivIdx;
+    std::string      badEntry;
+    if (!parseDerivatives(std::string(derivReq), derivIdx, badEntry))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:derivativeMexC:prhs",
+                          "Derivative %s is invalid. Each derivative must be three of the letters %s.", badEntry.c_str(), derivVars);
+    }
+    size_t numDeriv = derivIdx.size() / 3;
+
+    ///////////////////////////////////////////////////////////////////
+    // the flash always returns T and D ahead of the requested props //
+    ///////////////////////////////////////////////////////////////////
+    std::string props(propReq);
+    size_t      numProp  = 0;
+    std::string flashOut = "T;D";
+    if (props.find_first_not_of(" ") != std::string::npos)
+    {
+        numProp   = 1 + std::count(props.begin(), props.end(), ';');
+        flashOut += ";" + props;
+    } // end if thermodynamic properties were requested
+
+    /////////////////////////////////////////////
+    // Allocate memory for the output variable //
+    /////////////////////////////////////////////
+    size_t numCols   = zipped ? 1 : numelVal2;
+    size_t numPoints = numelVal1 * numCols;
+    mwSize outDims[3] = {numelVal1, numCols, numProp + numDeriv};
+    outputs[0] = mxCreateNumericArray(3, outDims, mxDOUBLE_CLASS, mxREAL);
+    double *propOut = mxGetPr(outputs[0]);
+
+    ///////////////////////////
+    // Setup local variables //
+    ///////////////////////////
+    size_t itr        = 0;                      // iterator over rows
+    size_t itc        = 0;                      // iterator over columns
+    size_t itp        = 0;                      // iterator over output properties
+    int    ierr       = 0;                      // OUTPUT: error flag -> 0 = successful, !0 = unsuccessful
+    int    iUnits     = 0;                      // INPUT:  Enumeration to denote which unit system to use
+    int    mixFlag    = 0;                      // flag to determine whether input is mixture
+    int    iFlag      = 0;                      // INPUT:  GETENUMdll checks all possible strings
+    double z[20];                               // Composition on a mole basis
+    double x[20];                               // OUTPUT: Composition of liquid phase
+    double y[20];                               // OUTPUT: Composition of vapor phase
+    double wmm;                                 // molar mass of the fluid (g/mol)
+    double q;                                   // OUTPUT: Vapor quality
+    double hOutput[200];                        // OUTPUT: Array of properties specified by hOut
+    double dXdT[6];                             // partials of T, P, D, H, S, E with respect to T at constant D
+    double dXdD[6];                             // partials of T, P, D, H, S, E with respect to D at constant T
+    double toSI[6];                             // factors from REFPROP molar units to MASS BASE SI for T, P, D, H, S, E
+    double T, D, P, e, h, s, Cv, Cp, w, Zf, hjt, A, G, xkappa, beta, dPdD, d2PdD2, dPdT, dDdT, dDdP, d2PdT2, d2PdTD, spare3, spare4;
+    char   herr[herr_length];                   // OUTPUT: Error string
+    char   unitString[] = "MASS BASE SI";       // all values are returned in SI units
+#if defined(_WIN32)
+    std::string DLL_name = "REFPRP64.DLL";      // Refprop dll used on Windows
+#else
+    std::string DLL_name = "";                  // librefprop.so or librefprop.dylib
+#endif
+    std::string serr;                           // load_REFPROP requires the error variable to be a string
+
+    /////////////////////////////
+    // loading the Refprop dll //
+    /////////////////////////////
+    if (!load_REFPROP(serr, path, DLL_name))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:derivativeMexC:load", "REFPROP failed to load from: %s -> %s", path.c_str(), serr.c_str());
+    }
+    SETPATHdll(const_cast<char*>(path.c_str()), 255);
+
+    setRefpropFluid(fluid, zIn, mixFlag, ierr);
+    if (ierr != 0)
+    {
+        unload_REFPROP(serr);
+        mexErrMsgIdAndTxt("MyToolbox:derivativeMexC:prhs", "Fluid %s failed to set: Error %d", fluid, ierr);
+    }
+
+    ///////////////////////////////////////////////////////////////////////
+    // THERM2dll expects a mole fraction composition.                    //
+    // A .MIX file has already returned its composition in mole fraction //
+    ///////////////////////////////////////////////////////////////////////
+    if ((iMass == 1) && !isMixFile(fluid))
+    {
+        XMOLEdll(zIn, z, wmm);
+    }
+    else
+    {
+        std::copy(zIn, zIn + 20, z);
+    } // end if mass, else molar composition
+    WMOLdll(z, wmm);
+
+    toSI[0] = 1.0;             // K
+    toSI[1] = 1000.0;          // kPa     -> Pa
+    toSI[2] = wmm;             // mol/L   -> kg/m^3
+    toSI[3] = 1000.0 / wmm;    // J/mol   -> J/kg
+    toSI[4] = 1000.0 / wmm;    // J/mol/K -> J/(kg K)
+    toSI[5] = 1000.0 / wmm;    // J/mol   -> J/kg
+
+    GETENUMdll(iFlag, unitString, iUnits, ierr, herr, hUnits_length, herr_length);
+    if (ierr != 0)
+    {
+        unload_REFPROP(serr);
+        mexErrMsgIdAndTxt("MyToolbox:derivativeMexC:prhs", "Converting %s to enum failed: Error %d -> %s", unitString, ierr, herr);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // one flash per state point, THERM2dll reuses the solved (T, D) state.      //
+    // After the first call the fluid string is passed as blank so REFPROP keeps //
+    // the loaded fluid                                                          //
+    ///////////////////////////////////////////////////////////////////////////////
+    for (itc = 0; itc < numCols; itc++)
+    {
+        for (itr = 0; itr < numelVal1; itr++)
+        {
+            size_t idx = (numelVal1 * itc) + itr;
+            double a   = value1[itr];
+            double b   = zipped ? value2[itr] : value2[itc];
+
+            ierr = callREFPROPdll((idx == 0) ? fluid : " ", specSum, flashOut.c_str(), iUnits, 0, mixFlag, a, b, z,
+                                  hOutput, q, x, y, herr);
+            if (ierr > 0)
+            {
+                mexWarnMsgIdAndTxt("MyToolbox:derivativeMexC:refprop", "Refprop call failed: WARNING %s = (%f, %f) -> %d %s", specSum, a, b, ierr, herr);
+                for (itp = 0; itp < (numProp + numDeriv); itp++)
+                {
+                    propOut[(numPoints * itp) + idx] = NAN;
+                } // end loop over output properties
+                continue;
+            } // end if the flash failed
+
+            for (itp = 0; itp < numProp; itp++)
+            {
+                propOut[(numPoints * itp) + idx] = hOutput[numFlash + itp];
+            } // end loop over thermodynamic properties
+
+            if ((q > 0.0) && (q < 1.0))
+            {
+                for (itp = 0; itp < numDeriv; itp++)
+                {
+                    propOut[(numPoints * (numProp + itp)) + idx] = NAN;
+                } // end loop over derivatives
+                continue;
+            } // end if two-phase
+
+            ////////////////////////////////////////////////////////////////////
+            // partials in the natural variables of the EOS, in REFPROP units //
+            // (K, kPa, mol/L, J/mol): de/dD|T = (P - T dP/dT|D) / D^2,       //
+            // ds/dD|T = -dP/dT|D / D^2 and h = e + P/D                       //
+            ////////////////////////////////////////////////////////////////////
+            T = hOutput[0];
+            D = hOutput[1] / wmm;
+            THERM2dll(T, D, z, P, e, h, s, Cv, Cp, w, Zf, hjt, A, G, xkappa, beta, dPdD, d2PdD2, dPdT, dDdT, dDdP,
+                      d2PdT2, d2PdTD, spare3, spare4);
+
+            dXdT[0] = 1.0;                dXdD[0] = 0.0;
+            dXdT[1] = dPdT;               dXdD[1] = dPdD;
+            dXdT[2] = 0.0;                dXdD[2] = 1.0;
+            dXdT[3] = Cv + (dPdT / D);    dXdD[3] = (dPdD / D) - (T * dPdT / (D * D));
+            dXdT[4] = Cv / T;             dXdD[4] = -dPdT / (D * D);
+            dXdT[5] = Cv;                 dXdD[5] = (P - (T * dPdT)) / (D * D);
+
+            ////////////////////////////////////////////////////////////////////////
+            // (da/db)_c = (a_T c_D - a_D c_T) / (b_T c_D - b_D c_T), then scaled //
+            // from REFPROP molar units to MASS BASE SI                           //
+            ////////////////////////////////////////////////////////////////////////
+            for (itp = 0; itp < numDeriv; itp++)
+            {
+                int    ia  = derivIdx[(3 * itp)];
+                int    ib  = derivIdx[(3 * itp) + 1];
+                int    ic  = derivIdx[(3 * itp) + 2];
+                double num = (dXdT[ia] * dXdD[ic]) - (dXdD[ia] * dXdT[ic]);
+                double den = (dXdT[ib] * dXdD[ic]) - (dXdD[ib] * dXdT[ic]);
+
+                propOut[(numPoints * (numProp + itp)) + idx] = (num / den) * (toSI[ia] / toSI[ib]);
+            } // end loop over derivatives
+        } // end loop over spec 1 (itr)
+    } // end loop over spec 2 (itc)
+
+    //////////////////////////////////////////
+    // Unload refprop to release the memory //
+    //////////////////////////////////////////
+    if (!unload_REFPROP(serr))
+    {
+        mexWarnMsgIdAndTxt("MyToolbox:derivativeMexC:unload", "REFPROP failed to unload properly.");
+    } // if REFPROP failed to unload
+} // end function mexFunction -> entry point
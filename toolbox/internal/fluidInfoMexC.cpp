@@ -0,0 +1,227 @@
+/*=============================================================================================*
+ *  fluidInfoMexC.cpp - fixed-point data of a fluid written with the MEX C api.                *
+ *                      Returns the critical, triple and normal boiling points, molar mass     *
+ *                      and equation of state limits from one REFPROP load without a flash.    *
+ *                                                                                             *
+ *  From MATLAB(R):                                                                               *
+ *       info = fluidInfoMexC(fluid, iMass, z, path)                                           *
+ *                                                                                             *
+ *  Where (see: https://refprop-docs.readthedocs.io/en/latest/DLL/legacy.html)                 *
+ *    info      = DOUBLE (array of size 1x14) in MASS BASE SI units with the values:           *
+ *                 1 molar mass (kg/mol)            8 triple point pressure (Pa)               *
+ *                 2 critical temperature (K)       9 normal boiling point temperature (K)     *
+ *                 3 critical pressure (Pa)        10 acentric factor (-)                      *
+ *                 4 critical density (kg/m^3)     11 minimum EOS temperature (K)              *
+ *                 5 critical enthalpy (J/kg)      12 maximum EOS temperature (K)              *
+ *                 6 critical entropy (J/(kg K))   13 maximum EOS pressure (Pa)                *
+ *                 7 triple point temperature (K)  14 maximum EOS density (kg/m^3)             *
+ *                the triple point and acentric factor are NaN for mixtures and the normal     *
+ *                boiling point of a mixture is its bubble point at 101.325 kPa                *
+ *    fluid     = CHAR value accepted by REFPROP as 'hFld' values (for mulit-species,          *
+ *                list numSpec fluids separated by a semicolon (;), where 1 < numSpec <= 20    *
+ *    iMass     = INT value to determine input units: 0 -> Molar, 1 -> Mass (sets iMass)       *
+ *    z         = DOUBLE (array of size 1x20) of species fractions                             *
+ *    path      = CHAR path to Refprop directory (e.g. C:\\ProgramFiles (x86)\\REFPROP)        *
+ *=============================================================================================*/
+
+// Copyright 2026 The MathWorks, Inc.
+
+#define REFPROP_IMPLEMENTATION
+#define REFPROP_FUNCTION_MODIFIER
+#undef UNICODE
+#include "REFPROP_lib.h"
+#undef REFPROP_FUNCTION_MODIFIER
+#undef REFPROP_IMPLEMENTATION
+#include "refpropMexHelpers.h"
+
+#include <string>
+#include <math.h>
+#include "mex.h"
+
+static const size_t numInfo = 14;  // number of values returned in info
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// function to check that the number and type of arguments, in and out, are as expected //
+//////////////////////////////////////////////////////////////////////////////////////////
+void checkArguments(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
+{
+    int expectedIn = 4;   // expected number of input variables
+    int inputInt;
+    double inputDouble;
+
+    if(numOutArg > 1)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:fluidInfoMexC:nlhs", "Incorrect number of outputs were given, only 1 output is allowed");
+    }
+
+    if(numInArg != expectedIn)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:fluidInfoMexC:nrhs", "%i inputs were given, but %i are expected.", numInArg, expectedIn);
+    }
+    else if(!mxIsChar(inputs[0]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:fluidInfoMexC:prhs", "Input variable substance (or mixture) expected to be of type CHAR.");
+    }
+    else if(!mxIsDouble(inputs[1]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:fluidInfoMexC:prhs", "Input variable MassOrMolar expected to be of type DOUBLE with values of 0 or 1.");
+    }
+    else if(!mxIsDouble(inputs[2]) || (mxGetNumberOfElements(inputs[2]) != 20))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:fluidInfoMexC:prhs", "Input variable Composition expected to be of type DOUBLE with 20 elements.");
+    }
+    else if(!mxIsChar(inputs[3]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:fluidInfoMexC:prhs", "Input variable PathToRefPropDll expected to be of type CHAR.");
+    }
+    else
+    {
+        inputDouble = mxGetScalar(inputs[1]);
+        inputInt    = int(inputDouble);
+        if ((double(inputInt) != inputDouble) || ((inputInt != 0) && (inputInt != 1)))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:fluidInfoMexC:prhs",
+                              "MassOrMolar input of %f is invalid. Acceptable values are 0 for Molar and 1 for Mass to select desired units.", inputDouble);
+        } // end if MassOrMolar is invalid
+    } // end if input types not as expected, else check values
+} // end function checkArguments
+
+void mexFunction(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
+{
+    ///////////////////////////////////////////////////////////////////////
+    // check that the input and output variables have the correct format //
+    ///////////////////////////////////////////////////////////////////////
+    checkArguments(numOutArg, outputs, numInArg, inputs);
+
+    ///////////////////////////////
+    // getting the actual inputs //
+    ///////////////////////////////
+    const char   *fluid = mxArrayToString(inputs[0]);               // String for fluid type
+          int     iMass = int(mxGetScalar(inputs[1]));              // Specifies mole or mass based input composition -> 0 = mole, 1 = mass
+          double *zIn   = mxGetPr(        inputs[2]);               // Composition on a mole or mass basis depending on iMass
+    std::string   path  = std::string(mxArrayToString(inputs[3]));  // location of reprop dll
+
+    /////////////////////////////////////////////
+    // Allocate memory for the output variable //
+    /////////////////////////////////////////////
+    outputs[0] = mxCreateNumericMatrix(1, numInfo, mxDOUBLE_CLASS, mxREAL);
+    double *info = mxGetPr(outputs[0]);
+
+    ///////////////////////////
+    // Setup local variables //
+    ///////////////////////////
+    int    ierr    = 0;                         // OUTPUT: error flag -> 0 = successful, !0 = unsuccessful
+    int    mixFlag = 0;                         // flag to determine whether input is mixture
+    int    icomp   = 1;                         // INPUT:  component number for INFOdll
+    int    kph     = 1;                         // INPUT:  saturation routines return the bubble point
+    double z[20];                               // Composition on a mole basis
+    double x[20];                               // OUTPUT: Composition of liquid phase
+    double y[20];                               // OUTPUT: Composition of vapor phase
+    double wmm     = 0.0;                       // molar mass (g/mol)
+    double tc, pc, Dc;                          // critical point (K, kPa, mol/L)
+    double tmin, tmax, Dmax, pmax;              // EOS limits (K, K, mol/L, kPa)
+    double hc, sc;                              // critical enthalpy and entropy (J/mol, J/(mol K))
+    double ttrp    = NAN;                       // triple point temperature (K)
+    double ptrp    = NAN;                       // triple point pressure (kPa)
+    double tnbp    = NAN;                       // normal boiling point temperature (K)
+    double acf     = NAN;                       // acentric factor
+    double wmmInfo, Zc, dip, Rgas, tcInfo, pcInfo, DcInfo, Dl, Dv;
+    double pAtm    = 101.325;                   // atmospheric pressure (kPa)
+    char   herr[herr_length];                   // OUTPUT: Error string
+    char   htyp[] = "EOS";                      // INPUT:  LIMITSdll returns the equation of state limits
+#if defined(_WIN32)
+    std::string DLL_name = "REFPRP64.DLL";      // Refprop dll used on Windows
+#else
+    std::string DLL_name = "";                  // librefprop.so or librefprop.dylib
+#endif
+    std::string serr;                           // load_REFPROP requires the error variable to be a string
+
+    /////////////////////////////
+    // loading the Refprop dll //
+    /////////////////////////////
+    if (!load_REFPROP(serr, path, DLL_name))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:fluidInfoMexC:load", "REFPROP failed to load from: %s -> %s", path.c_str(), serr.c_str());
+    }
+    SETPATHdll(const_cast<char*>(path.c_str()), 255);
+
+    setRefpropFluid(fluid, zIn, mixFlag, ierr);
+    if (ierr != 0)
+    {
+        unload_REFPROP(serr);
+        mexErrMsgIdAndTxt("MyToolbox:fluidInfoMexC:prhs", "Fluid %s failed to set: Error %d", fluid, ierr);
+    }
+
+    ///////////////////////////////////////////////////////////////////////
+    // the legacy routines below all expect a mole fraction composition. //
+    // A .MIX file has already returned its composition in mole fraction //
+    ///////////////////////////////////////////////////////////////////////
+    if ((iMass == 1) && !isMixFile(fluid))
+    {
+        XMOLEdll(zIn, z, wmm);
+    }
+    else
+    {
+        std::copy(zIn, zIn + 20, z);
+    } // end if mass, else molar composition
+
+    WMOLdll(z, wmm);
+    CRITPdll(z, tc, pc, Dc, ierr, herr, herr_length);
+    if (ierr > 0)
+    {
+        unload_REFPROP(serr);
+        mexErrMsgIdAndTxt("MyToolbox:fluidInfoMexC:refprop", "Critical point of %s failed: Error %d -> %s", fluid, ierr, herr);
+    }
+    LIMITSdll(htyp, z, tmin, tmax, Dmax, pmax, 3);
+    ENTHALdll(tc, Dc, z, hc);
+    ENTROdll( tc, Dc, z, sc);
+
+    /////////////////////////////////////////////////////////////////////////
+    // the triple point and acentric factor only have a meaning for a pure //
+    // fluid; the normal boiling point of a mixture is taken as its bubble //
+    // point at atmospheric pressure                                       //
+    /////////////////////////////////////////////////////////////////////////
+    if (mixFlag == 0)
+    {
+        INFOdll(icomp, wmmInfo, ttrp, tnbp, tcInfo, pcInfo, DcInfo, Zc, acf, dip, Rgas);
+        SATTdll(ttrp, z, kph, ptrp, Dl, Dv, x, y, ierr, herr, herr_length);
+        if (ierr > 0)
+        {
+            ptrp = NAN;
+        } // end if the triple point is outside the saturation range of the EOS
+    }
+    else
+    {
+        SATPdll(pAtm, z, kph, tnbp, Dl, Dv, x, y, ierr, herr, herr_length);
+        if (ierr > 0)
+        {
+            tnbp = NAN;
+        } // end if no bubble point at atmospheric pressure
+    } // end if pure fluid, else mixture
+
+    ///////////////////////////////////////////////////////////////////////////
+    // convert from REFPROP units (g/mol, kPa, mol/L, J/mol) to MASS BASE SI //
+    ///////////////////////////////////////////////////////////////////////////
+    info[0]  = wmm / 1000.0;
+    info[1]  = tc;
+    info[2]  = pc * 1000.0;
+    info[3]  = Dc * wmm;
+    info[4]  = hc / wmm * 1000.0;
+    info[5]  = sc / wmm * 1000.0;
+    info[6]  = ttrp;
+    info[7]  = ptrp * 1000.0;
+    info[8]  = tnbp;
+    info[9]  = acf;
+    info[10] = tmin;
+    info[11] = tmax;
+    info[12] = pmax * 1000.0;
+    info[13] = Dmax * wmm;
+
+    //////////////////////////////////////////
+    // Unload refprop to release the memory //
+    //////////////////////////////////////////
+    if (!unload_REFPROP(serr))
+    {
+        mexWarnMsgIdAndTxt("MyToolbox:fluidInfoMexC:unload", "REFPROP failed to unload properly.");
+    } // if REFPROP failed to unload
+} // end function mexFunction -> entry point
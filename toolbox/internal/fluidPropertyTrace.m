@@ -0,0 +1,107 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% fluidPropertyTrace
+%   Session state of the getFluidProperty trace started by startFluidPropertyTrace.m. One trace is recorded at a
+%   time; while none is, getFluidProperty only checks isRecording and records nothing.
+%
+%   From MATLAB:
+%        fluidPropertyTrace("start", fileName, recordResults)
+%        recording = fluidPropertyTrace("isRecording")
+%        fluidPropertyTrace("record", call, elapsed, values)
+%        summary   = fluidPropertyTrace("stop")
+%
+%   Where
+%
+%       fileName      = CHAR trace file, created or overwritten
+%       recordResults = LOGICAL whether the returned values are stored with each call
+%       call          = STRUCT of the getFluidProperty inputs as given, with the fields Library (0 -> REFPROP,
+%                       1 -> CoolProp, 2 -> refpropServer), RequestedProperty, InputProperty1, InputProperty2, Fluid,
+%                       DesiredUnits, Accuracy, CoolPropBackend, InputUnits, OutputUnit, MassOrMolar, Composition,
+%                       Values1, Values2 and DomainCheck
+%       elapsed       = DOUBLE time of the call in seconds
+%       values        = DOUBLE values the call returned
+%       summary       = STRUCT with the fields File, NumCalls and NumPoints
+%
+%   File layout (little-endian), see readFluidPropertyTrace.m:
+%       bytes 0-7     'FLPTRCE1'
+%       uint32        format version (1)
+%       double        POSIX time the trace was started
+%       per call      uint32 size of the rest of the record in bytes, then
+%                     double x 2      start of the call since the trace started and its duration, in seconds
+%                     uint8 x 2       library and flags (1 -> DomainCheck, 2 -> values stored)
+%                     10 strings      RequestedProperty, InputProperty1, InputProperty2, Fluid, DesiredUnits,
+%                                     Accuracy, CoolPropBackend, InputUnits(1), InputUnits(2), OutputUnit, each a
+%                                     uint16 length followed by its characters
+%                     double          MassOrMolar
+%                     3 arrays        Composition, Values1, Values2, each a uint32 count followed by the doubles
+%                     1 array         values returned, when stored
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function varargout = fluidPropertyTrace(command, varargin)
+    persistent trace
+    if isempty(trace)
+        trace = struct("fid", -1, "file", "", "recordResults", false, "timer", uint64(0), "numCalls", 0,...
+                       "numPoints", 0);
+    end
+
+    switch command
+        case "isRecording"
+            varargout{1} = (trace.fid >= 0);
+
+        case "start"
+            if trace.fid >= 0
+                error("A trace is already being recorded to %s. Call stopFluidPropertyTrace first.", trace.file);
+            end
+            [fid, msg] = fopen(varargin{1}, 'w', 'ieee-le');
+            if fid < 0
+                error("Cannot open %s: %s", varargin{1}, msg);
+            end
+            fwrite(fid, 'FLPTRCE1', 'uchar');
+            fwrite(fid, 1, 'uint32');
+            fwrite(fid, posixtime(datetime("now")), 'double');
+            trace = struct("fid", fid, "file", string(varargin{1}), "recordResults", varargin{2}, "timer", tic,...
+                           "numCalls", 0, "numPoints", 0);
+            mlock;   % keep the open file when clear functions runs
+
+        case "record"
+            if trace.fid < 0
+                return
+            end
+            [call, elapsed, values] = varargin{:};
+            payload = [typecast([toc(trace.timer) - elapsed, elapsed], 'uint8'),...
+                       uint8([call.Library, call.DomainCheck + 2 * trace.recordResults]),...
+                       packString(call.RequestedProperty), packString(call.InputProperty1),...
+                       packString(call.InputProperty2), packString(call.Fluid), packString(call.DesiredUnits),...
+                       packString(call.Accuracy), packString(call.CoolPropBackend), packString(call.InputUnits(1)),...
+                       packString(call.InputUnits(2)), packString(call.OutputUnit),...
+                       typecast(double(call.MassOrMolar), 'uint8'), packArray(call.Composition),...
+                       packArray(call.Values1), packArray(call.Values2)];
+            if trace.recordResults
+                payload = [payload, packArray(values)];
+            end
+            fwrite(trace.fid, numel(payload), 'uint32');
+            fwrite(trace.fid, payload, 'uint8');
+            trace.numCalls  = trace.numCalls + 1;
+            trace.numPoints = trace.numPoints + numel(values);
+
+        case "stop"
+            varargout{1} = struct("File", trace.file, "NumCalls", trace.numCalls, "NumPoints", trace.numPoints);
+            if trace.fid >= 0
+                fclose(trace.fid);
+                munlock;
+            end
+            trace.fid = -1;
+    end % end switch over commands
+end % end function fluidPropertyTrace
+
+function bytes = packString(value)
+% PACKSTRING uint16 length followed by the characters
+    chars = unicode2native(char(value), 'UTF-8');
+    bytes = [typecast(uint16(numel(chars)), 'uint8'), chars];
+end % end function packString
+
+function bytes = packArray(values)
+% PACKARRAY uint32 count followed by the values as doubles
+    bytes = [typecast(uint32(numel(values)), 'uint8'), typecast(double(values(:))', 'uint8')];
+end % end function packArray
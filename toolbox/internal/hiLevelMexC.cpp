@@ -4,14 +4,25 @@
  *                                                                                             *
  *  From MATLAB(R):                                                                               *
  *       output = hiLevelMexC(propReq, spec, Value1, Value2, fluid, MassOrMole)                *
+ *       output = hiLevelMexC(..., DebugOut, model) evaluates with the given model             *
+ *       [output, status] = hiLevelMexC(..., model, mask, domainCheck) only evaluates the      *
+ *                          points selected by mask and inside the domain of the EOS           *
+ *       [output, status, q, x, y, x3] = hiLevelMexC(...) also returns the quality and the     *
+ *                          phase compositions of every point from the same flash              *
+ *       output = hiLevelMexC(..., domainCheck, sharedCache, cacheEntries) shares the results  *
+ *                with the other processes on the host that use the same cache                 *
+ *       output = hiLevelMexC(..., cacheEntries, leverRule) resolves the two-phase points of a *
+ *                pure fluid from the saturation states at each P or T                         *
  *                                                                                             *
  *  Where (see: https://refprop-docs.readthedocs.io/en/latest/DLL/high_level.html)             *
- *    output    = DOUBLE (array of size MxN) output from RefProp for the desired Property      *
- *                from propReq where M is the size of Value1 and N is the size of Value2       *
+ *    output    = DOUBLE array output from RefProp for the desired Property from propReq,      *
+ *                of the size given by implicit expansion of value1 and value2, e.g. MxN       *
+ *                for an Mx1 value1 and a 1xN value2                                           *
  *    propReq   = CHAR value accepted by REFPROP as 'hOut' values                              *
  *    specsum   = CHAR value accepted by REFPROP as 'hIn'  values                              *
- *    value1    = DOUBLE (array of size 1xM) of values related to the first character in spec  *
- *    value2    = DOUBLE (array of size 1xN) of values related to the second character in spec *
+ *    value1    = DOUBLE (N-D array) of values related to the first character in spec          *
+ *    value2    = DOUBLE (N-D array) of values related to the second character in spec, each   *
+ *                dimension must match the one of value1 or be 1 in either of them             *
  *    fluid     = CHAR value accepted by REFPROP as 'hFld' values (for mulit-species,          *
  *                list numSpec fluids separated by a semicolon (;), where 1 < numSpec <= 20    *
  *    iMass     = INT value to determine input units: 0 -> Molar, 1 -> Mass (sets iMass)       *
@@ -21,48 +32,72 @@
  *    unit_char = CHAR value to determine units to use (enum as expected by refprop.dll)       *
  *    path      = CHAR path to Refprop directory (e.g. C:\\ProgramFiles (x86)\\REFPROP)        *
  *    DebugOut  = DOUBLE value (0 to suppress, 1 to show) debug output in MATLAB console       *
+ *    model     = [optional] CHAR 'exact' (default) for REFPROP's equations of state or 'fast' *
+ *                for the Peng-Robinson cubic equation, for screening runs                     *
+ *    mask      = [optional] LOGICAL array with as many elements as output, only the points    *
+ *                where it is true are evaluated, or [] to evaluate every point                *
+ *    domainCheck = [optional] DOUBLE value (1 to reject, 0 to evaluate) points of a plain     *
+ *                  input pair outside the EOS limits or below the melting line without        *
+ *                  calling REFPROP                                                            *
+ *    sharedCache = [optional] CHAR name of the shared-memory result cache every point is      *
+ *                  looked up in and stored to, or '' for none (see sharedResultCache.h)       *
+ *    cacheEntries = [optional] DOUBLE number of results the cache holds when this call        *
+ *                   creates it, default 1000000; an existing cache keeps its size             *
+ *    leverRule = [optional] DOUBLE value (1 to apply, 0 to flash every point) the lever rule  *
+ *                to the two-phase points of a pure fluid, see rpeSetLeverRule                 *
+ *    status    = [optional output] DOUBLE array of the size of output with the rpePointStatus *
+ *                of each point: 0 evaluated, 1 REFPROP failed, 2 masked, 3 outside the limits *
+ *                of the EOS, 4 below the melting line                                         *
+ *    q         = [optional output] DOUBLE array of the size of output, vapor quality of each  *
+ *                point as REFPROPdll returns it, on the basis of iMass                        *
+ *    x, y, x3  = [optional outputs] DOUBLE arrays of the size of output with one more         *
+ *                dimension of ncomp, e.g. MxNxncomp, the liquid, vapor and second liquid      *
+ *                compositions of each point; they follow status                               *
+ *                                                                                             *
+ *  REFPROP is loaded and evaluated by refpropEngine.cpp, which this file is compiled with;    *
+ *  it only converts between the MATLAB arrays and the engine's C interface.                   *
  *=============================================================================================*/
 
-// Copyright 2019 - 2025 The MathWorks, Inc.
+// Copyright 2019 - 2026 The MathWorks, Inc.
 
-#define REFPROP_IMPLEMENTATION
-#define REFPROP_FUNCTION_MODIFIER
-#undef UNICODE
-#include "REFPROP_lib.h"
-#undef REFPROP_FUNCTION_MODIFIER
-#undef REFPROP_IMPLEMENTATION
+#include "refpropEngine.h"
 
-#include <iostream>
-#include <sstream>
+#include <algorithm>
 #include <string>
-#include <stdlib.h>
+#include <vector>
 #include <stdio.h>
-#include <ctype.h>
-#include <math.h>
+#include <string.h>
 #include "mex.h"
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// libut routine that reports a pending Ctrl-C, the mex file must be linked with -lut   //
+//////////////////////////////////////////////////////////////////////////////////////////
+extern "C" bool utIsInterruptPending(void);
+
+static const size_t maxDims = 32;   // most dimensions accepted for value1 and value2
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // function to check that the number and type of arguments, in and out, are as expected //
 //////////////////////////////////////////////////////////////////////////////////////////
 void checkArguments(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
 {
-    int expectedOut =  1;   // expected number of output variables
-    int expectedIn  = 10;   // expected number of input  variables
+    int expectedOut = 1;                // expected number of output variables, plus an optional status, q, x, y and x3
+    int expectedIn  = 10;               // expected number of input  variables, model, mask, domainCheck, sharedCache, cacheEntries and leverRule are optional
     int inputInt;
     double inputDouble;
 
     ///////////////////////////////////////////////////////////////
     // Checking output arguments. There should only ever be one? //
     ///////////////////////////////////////////////////////////////
-    if(numOutArg != expectedOut)
+    if((numOutArg < expectedOut) || (numOutArg > (expectedOut + 5)))
     {
-        mexErrMsgIdAndTxt("MyToolbox:arrayProduct:nlhs", "Incorrect number of outputs were given, only 1 output is allowed");
+        mexErrMsgIdAndTxt("MyToolbox:arrayProduct:nlhs", "Incorrect number of outputs were given, %i output(s) plus status, q, x, y and x3 allowed", expectedOut);
     }
 
     ////////////////////////////////////////////////////////////////
     // Checking input arguments. There should always only be six? //
     ////////////////////////////////////////////////////////////////
-    if(numInArg != expectedIn)
+    if((numInArg < expectedIn) || (numInArg > (expectedIn + 6)))
     {
         mexErrMsgIdAndTxt("MyToolbox:arrayProduct:nrhs", "%i inputs were given, but %i are expected.", numInArg, expectedIn);
     }
@@ -79,13 +114,17 @@ void checkArguments(int numOutArg, mxArray *outputs[], int numInArg, const mxArr
         {
             mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Input variable spec expected to be of type CHAR.");
         }
-        else if(!mxIsDouble(inputs[2]))
+        else if(!mxIsDouble(inputs[2]) || mxIsComplex(inputs[2]) || mxIsSparse(inputs[2]))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Input variable value1 expected to be of type DOUBLE (real and full).");
+        }
+        else if(!mxIsDouble(inputs[3]) || mxIsComplex(inputs[3]) || mxIsSparse(inputs[3]))
         {
-            mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Input variable value1 expected to be of type DOUBLE.");
+            mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Input variable value2 expected to be of type DOUBLE (real and full).");
         }
-        else if(!mxIsDouble(inputs[3]))
+        else if((mxGetNumberOfDimensions(inputs[2]) > maxDims) || (mxGetNumberOfDimensions(inputs[3]) > maxDims))
         {
-            mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Input variable value2 expected to be of type DOUBLE.");
+            mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Input variables value1 and value2 may have at most %i dimensions.", int(maxDims));
         }
         else if(!mxIsChar(inputs[4]))
         {
@@ -95,7 +134,7 @@ void checkArguments(int numOutArg, mxArray *outputs[], int numInArg, const mxArr
         {
             mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Input variable MassOrMolar expected to be of type DOUBLE with values of 0 or 1.");
         }
-        else if(!mxIsDouble(inputs[6]))
+        else if(!mxIsDouble(inputs[6]) || mxIsComplex(inputs[6]))
         {
             mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Input variable Composition expected to be of type DOUBLE with values betwen 0 and 1.");
         }
@@ -111,6 +150,30 @@ void checkArguments(int numOutArg, mxArray *outputs[], int numInArg, const mxArr
         {
             mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Input variable DebugOutput expected to be of type DOUBLE with values of 0 or 1.");
         }
+        else if((numInArg >= 11) && !mxIsChar(inputs[10]))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Input variable model expected to be of type CHAR, 'exact' or 'fast'.");
+        }
+        else if((numInArg >= 12) && !mxIsEmpty(inputs[11]) && !mxIsLogical(inputs[11]))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Input variable mask expected to be of type LOGICAL or [].");
+        }
+        else if((numInArg >= 13) && !mxIsDouble(inputs[12]))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Input variable domainCheck expected to be of type DOUBLE with values of 0 or 1.");
+        }
+        else if((numInArg >= 14) && !mxIsChar(inputs[13]) && !mxIsEmpty(inputs[13]))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Input variable sharedCache expected to be of type CHAR or ''.");
+        }
+        else if((numInArg >= 15) && (!mxIsDouble(inputs[14]) || (mxGetScalar(inputs[14]) < 1.0)))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Input variable cacheEntries expected to be a positive DOUBLE.");
+        }
+        else if((numInArg == 16) && !mxIsDouble(inputs[15]))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Input variable leverRule expected to be of type DOUBLE with values of 0 or 1.");
+        }
         else
         {
             ////////////////////////////////////////////////////////////////////////////////////////////
@@ -148,6 +211,44 @@ void checkArguments(int numOutArg, mxArray *outputs[], int numInArg, const mxArr
     } // end if too few, elseif too many, else exactly the number of, input values expected
 } // end function checkArguments
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// size of the output from MATLAB implicit expansion of value1 and value2, false if a   //
+// dimension differs and is not 1 in either. stride1 and stride2 are the steps through  //
+// value1 and value2 for each output dimension, 0 where that input is expanded          //
+//////////////////////////////////////////////////////////////////////////////////////////
+static bool expandedSize(const mxArray *value1, const mxArray *value2, size_t &numDims, size_t outDims[],
+                         size_t stride1[], size_t stride2[])
+{
+    mwSize        numDims1 = mxGetNumberOfDimensions(value1);
+    mwSize        numDims2 = mxGetNumberOfDimensions(value2);
+    const mwSize *dims1    = mxGetDimensions(value1);
+    const mwSize *dims2    = mxGetDimensions(value2);
+    size_t        step1    = 1;
+    size_t        step2    = 1;
+
+    numDims = (numDims1 > numDims2) ? numDims1 : numDims2;
+    for (size_t itd = 0; itd < numDims; itd++)
+    {
+        size_t size1 = (itd < numDims1) ? dims1[itd] : 1;
+        size_t size2 = (itd < numDims2) ? dims2[itd] : 1;
+        if ((size1 != size2) && (size1 != 1) && (size2 != 1))
+        {
+            return false;
+        }
+        outDims[itd] = (size1 == 1) ? size2 : size1;
+        stride1[itd] = (size1 == 1) ? 0 : step1;
+        stride2[itd] = (size2 == 1) ? 0 : step2;
+        step1       *= size1;
+        step2       *= size2;
+    } // end loop over dimensions
+    return true;
+} // end function expandedSize
+
+static int mexInterrupted(void *)
+{
+    return utIsInterruptPending() ? 1 : 0;
+} // end function mexInterrupted
+
 void mexFunction(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
 {
     ///////////////////////////////////////////////////////////////////////
@@ -155,326 +256,175 @@ void mexFunction(int numOutArg, mxArray *outputs[], int numInArg, const mxArray
     ///////////////////////////////////////////////////////////////////////
     checkArguments(numOutArg, outputs, numInArg, inputs);
 
-    ///////////////////////////////
-    // getting the actual inputs //
-    ///////////////////////////////
-    const char   *propReq   = mxArrayToString(inputs[0]);               // Property requested for output
-    const char   *specSum   = mxArrayToString(inputs[1]);               // characters encoding spec variables
-    const double *value1    = mxGetPr(        inputs[2]);               // value for first  spec variable
-    const double *value2    = mxGetPr(        inputs[3]);               // value for second spec variable
-    const char   *fluid     = mxArrayToString(inputs[4]);               // String for fluid type
+    /////////////////////////////////////////////////////////////////////////////
+    // getting the actual inputs, the strings are copied into fixed buffers so //
+    // a call does not allocate them                                           //
+    /////////////////////////////////////////////////////////////////////////////
+    char          propReq  [RPE_STRING_LENGTH];                         // Property requested for output
+    char          specSum  [RPE_STRING_LENGTH];                         // characters encoding spec variables
+    char          fluid    [RPE_FLUID_LENGTH];                          // String for fluid type
+    char          unit_char[RPE_STRING_LENGTH];                         // Sets up which units to use -> molar or mass, SI or English
+    char          path     [RPE_FLUID_LENGTH];                          // location of reprop dll
+    mxGetString(inputs[0], propReq,   sizeof(propReq));
+    mxGetString(inputs[1], specSum,   sizeof(specSum));
+    mxGetString(inputs[4], fluid,     sizeof(fluid));
+    mxGetString(inputs[7], unit_char, sizeof(unit_char));
+    mxGetString(inputs[8], path,      sizeof(path));
+    const double *value1    = mxGetDoubles(inputs[2]);                  // values for first  spec variable
+    const double *value2    = mxGetDoubles(inputs[3]);                  // values for second spec variable
           int     iMass     = int(mxGetScalar(inputs[5]));              // Specifies mole or mass based input composition -> 0 = mole, 1 = mass
-          double *z         = mxGetPr(        inputs[6]);               // Composition on a mole or mass basis depending on iMass (array of max size 20)
-          char   *unit_char = mxArrayToString(inputs[7]);               // Sets up which units to use -> molar or mass, SI or English
-    std::string   path      = std::string(mxArrayToString(inputs[8]));  // location of reprop dll
+    const double *z         = mxGetDoubles(   inputs[6]);               // Composition on a mole or mass basis depending on iMass (array of max size 20)
           bool    DebugOut  = bool(mxGetScalar(inputs[9]));             // logical for printing debug info to the MATLAB console
+    char          model    [RPE_STRING_LENGTH] = "exact";               // property model, 'exact' or 'fast'
+    if (numInArg >= 11)
+    {
+        mxGetString(inputs[10], model, sizeof(model));
+    }
+          bool    domainCheck = (numInArg >= 13) && (mxGetScalar(inputs[12]) != 0.0);   // reject points outside the domain of the EOS
+    char          sharedCache[RPE_STRING_LENGTH] = "";                  // name of the shared result cache, none when empty
+    if ((numInArg >= 14) && mxIsChar(inputs[13]))
+    {
+        mxGetString(inputs[13], sharedCache, sizeof(sharedCache));
+    }
+          size_t  cacheEntries = (numInArg >= 15) ? size_t(mxGetScalar(inputs[14])) : 1000000;   // results a new shared cache holds
+          bool    leverRule    = (numInArg == 16) && (mxGetScalar(inputs[15]) != 0.0);   // two-phase points of a pure fluid by the lever rule
+    if ((strcmp(model, "exact") != 0) && (strcmp(model, "fast") != 0))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Input variable model was given as %s, but must be 'exact' or 'fast'.", model);
+    }
 
-    /////////////////////////////////////////////////////////////////// 
-    // getting the size of all the char arrays passed through inputs // 
-    /////////////////////////////////////////////////////////////////// 
-    size_t  propReq_len = (mxGetM(inputs[0]) * mxGetN(inputs[0])) + 1;  // size of propReq
-    size_t  spec_len    = (mxGetM(inputs[1]) * mxGetN(inputs[1])) + 1;  // size of first spec
-    size_t  numelVal1   =  mxGetNumberOfElements(inputs[2]);            // number of values for the first spec
-    size_t  numelVal2   =  mxGetNumberOfElements(inputs[3]);            // number of values for the second spec
-    size_t  fluid_len   = (mxGetM(inputs[4]) * mxGetN(inputs[4])) + 1;  // size of fluid 
-    
-    /////////////////////////////////////////////
-    // Allocate memory for the output variable //
-    /////////////////////////////////////////////
-    outputs[0] = mxCreateNumericMatrix(numelVal1, numelVal2, mxDOUBLE_CLASS, mxREAL); // [numelVal1 x numelVal2] array of real doubles
-
-    ///////////////////////////
-    // Setup local variables //
-    ///////////////////////////
-    size_t itr           =     0;               // iterator over rows
-    size_t itc           =     0;               // iterator over columns
-    size_t itrcmp        =     0;               // iterator over fluid composition
-    int    herr_length   =   255;               // INPUT:  length of the error string   (  255 is default)
-    int    hFld_length   = 10000;               // INPUT:  length of fluid name         (10000 is default)
-    int    hIn_length    =   255;               // INPUT:  length of input string       (  255 is default)
-    int    hOut_length   =   255;               // INPUT:  length of output flag string (  255 is default)
-    int    hUnits_length =   255;               // INPUT:  length of units string       (  255 is default)
-    int    ierr;                                // OUTPUT: error flag -> 0 = successful, !0 = unsuccessful
-    int    iFlag         =     0;               // OUTPUT: enum for getenumdll function (see comments below for values)
-    int    iUCode;                              // OUTPUT: Unit code representing the units of the first property in Output array
-    int    iUnits        =     0;               // INPUT:  Enumeration to denote which unit system to use (SI, english, etc.)
-    int    mixFlag       =     0;               // flag to determine whether input is mixture - same variable as "iFlag" in refprop.dll documentation (not iFlag enum above!)
-    double a;                                   // INPUT:  First input property as specified by hIn
-    double b;                                   // INPUT:  Second input property as specified by hIn
-    double hOutput[200];                        // OUTPUT: Array of properties specified by hOut (should be size 200, double precision)
-    double *propReqOut   = mxGetPr(outputs[0]); // creating a dummy pointer to fill with output values
-    double q             =    1.0;              // OUTPUT: Vapor quality on a mole or mass basis (vapor -> 1, liquid -> 0)
-    double x [20]        =   {1.0};             // OUTPUT: Composition of liquid phase (array of mole fractions of size 20) for 2-phase states
-    double x3[20];                              // OUTPUT: Reserved for returning composition of a second liquid phase for LLE or VLLE
-    double y [20]        =   {1.0};             // OUTPUT: Composition of vapor phase (array of mole fractions of size 20) for 2-phase states
-    char   herr  [255];                         // OUTPUT: Error string
-    char   hFld  [255];                         // INPUT:  Fluid string
-    char   hIn   [255];                         // INPUT:  Input string of properties sent to the routine
-    char   hOut  [255];                         // OUTPUT: Various flags to gain access to other features of Refprop
-    char   hUnits[255];                         // OUTPUT: Units for the first property in the output array
-    std::string DLL_name = "REFPRP64.DLL";      // Refprop dll used for this function
-    std::string serr;                           // load_REFPROP requires the error variable to be a string
-    
-    /////////////////////////////
-    // loading the Refprop dll //
-    /////////////////////////////
-    bool loaded_REFPROP = load_REFPROP(serr, path, DLL_name);
+    ///////////////////////////////////////////////////////////////////////////////
+    // size of the output by implicit expansion, e.g. MxN for Mx1 and 1xN values //
+    ///////////////////////////////////////////////////////////////////////////////
+    size_t numDims;                              // number of dimensions of the output
+    size_t outDims[maxDims];                     // size of the output
+    size_t stride1[maxDims];                     // step through value1 for each output dimension
+    size_t stride2[maxDims];                     // step through value2 for each output dimension
+    if (!expandedSize(inputs[2], inputs[3], numDims, outDims, stride1, stride2))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Input variables value1 and value2 must have compatible sizes: each dimension must match or be 1 in one of them.");
+    }
+    size_t numelOut = 1;                         // number of values in the output
+    mwSize mxDims[maxDims];                      // size of the output as mxCreateNumericArray expects it
+    for (size_t itd = 0; itd < numDims; itd++)
+    {
+        numelOut   *= outDims[itd];
+        mxDims[itd] = mwSize(outDims[itd]);
+    } // end loop over output dimensions
+
+    outputs[0]         = mxCreateNumericArray(mwSize(numDims), mxDims, mxDOUBLE_CLASS, mxREAL);
+    double *propReqOut = mxGetDoubles(outputs[0]);   // output values
+    int     statusIdx  = 1;                          // output index of the status
+
+    ///////////////////////////////////////////////////////////////////////////
+    // the mask selects the points to evaluate, one logical per output value //
+    ///////////////////////////////////////////////////////////////////////////
+    const unsigned char *mask = NULL;            // evaluate the points where nonzero, every point when NULL
+    if ((numInArg >= 12) && !mxIsEmpty(inputs[11]))
+    {
+        if (mxGetNumberOfElements(inputs[11]) != numelOut)
+        {
+            mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Input variable mask has %zu elements, but the output has %zu.", mxGetNumberOfElements(inputs[11]), numelOut);
+        }
+        mask = reinterpret_cast<const unsigned char *>(mxGetLogicals(inputs[11]));
+    }
+    std::vector<int> pointStatus((numOutArg > statusIdx) ? numelOut : 0);   // rpePointStatus of each point, when requested
+    int              numPhaseOut = numOutArg - statusIdx - 1;                 // number of q, x, y and x3 requested
 
     //////////////////////////////////////////////////////////////////////////////////////////////////
     // try-catch like behavior, if it fails to load refprop, send an error and skip everything else //
     //////////////////////////////////////////////////////////////////////////////////////////////////
-    if (!loaded_REFPROP)
+    int         status;                         // rpeStatus of the last engine call
+    rpeSession *session = rpeOpen(path, &status);
+    if (session == NULL)
     {
-        printf("REFPROP failed to load from: %s\\%s", path, DLL_name);
+        mexErrMsgIdAndTxt("MyToolbox:hiLevelMexC:load", "%s", rpeLastError(NULL));
     }
-    else
-    {
-        /////////////////////////////////////
-        // setting path to the refprop dll //
-        /////////////////////////////////////
-        SETPATHdll(const_cast<char*>(path.c_str()), 255);
-
-        ////////////////////////////////////
-        // setting the desired fluid type //
-        // error checking - ierr set here //
-        ////////////////////////////////////
-        std::string mix_string_search(fluid);
-        std::transform(mix_string_search.begin(), mix_string_search.end(), mix_string_search.begin(), [](unsigned char c){return tolower(c);});
-        
-        ////////////////////////////////////////////////////
-        // check to see if the user passed in a .MIX file //
-        ////////////////////////////////////////////////////
-        std::size_t mixFound = mix_string_search.rfind(".mix");
 
-        ////////////////////////////////////////////////////////////////////
-        // if the user passed in a .MIX file, else manually defined fluid //
-        ////////////////////////////////////////////////////////////////////
-        if( (mix_string_search.length() > 4) && (mixFound + 4) == mix_string_search.length())
+    ////////////////////////////////////
+    // setting the desired fluid type //
+    ////////////////////////////////////
+    status = rpeSetFluid(session, fluid, z, iMass);
+    if (status == RPE_OK)
+    {
+        if (rpeMixtureKind(session) == 2)
         {
             mexPrintf("Found Mixture from .MIX file\n");
-            SETMIXTUREdll(const_cast<char*>(fluid), z, ierr, hFld_length);   
-            mixFlag = 1;
         }
-        else
+        else if (rpeMixtureKind(session) == 1)
         {
-            ///////////////////////////////////////////////////////////
-            // check to see if the user passed in a mixture manually //
-            ///////////////////////////////////////////////////////////
-            mixFound = mix_string_search.rfind(";");
-            if (mixFound < mix_string_search.length())
-            {
-                mexPrintf("Found Mixture passed in as arguement\n");
-                mixFlag = 1;
-            } // end if mixture, else individual fluid
-            SETFLUIDSdll(const_cast<char *>(fluid), ierr, hFld_length);
-        } // end if .mix file, else manual fluid entry
-
-        ////////////////////////////////////////////////////////////////////////////////////////////////////
-        // try-catch like behaviour, if we couldn't set the fluid, send an error and skip everything else //
-        ////////////////////////////////////////////////////////////////////////////////////////////////////
-        if(ierr != 0)
-        {
-            mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Fluid %s failed to set: Error %d", fluid, ierr);
-        }
-        else
-        {
-            //////////////////////////////////////////////////////////////////////////
-            // Getting the enumeration value that goes with the desired unit type   //
-            // iFlag = 0 -> Check all possible strings                              //
-            // iFlag = 1 -> Check units only                                        //
-            // iFlag = 2 -> Check property strings and those in #3 only             //
-            // iFlag = 3 -> Check property strings not functions of T and D only    //
-            //////////////////////////////////////////////////////////////////////////
-            GETENUMdll(iFlag, unit_char, iUnits, ierr, herr, hUnits_length, herr_length);
-            if(ierr != 0)
-            {
-                mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "Converting %s to enum failed: Error %d -> %s", unit_char, ierr, herr);
-            }
-            
-            ////////////////////////////////////////////////////////////////////////////////
-            //                            Running the tests:                              //
-            ////////////////////////////////////////////////////////////////////////////////
-            // setting char variables with desired values //
-            ////////////////////////////////////////////////
-            strncpy(hFld, fluid,   fluid_len);      // change fluid string to change hFld
-            strncpy(hIn,  specSum, spec_len);       // change hIn here directly
-            strncpy(hOut, propReq, propReq_len);    // change hOut here directly
-            
-            ///////////////////////////////////////////
-            //running the first set at itr = itc = 0 //
-            ///////////////////////////////////////////
-            a = value1[itr]; // set first spec entry
-            b = value2[itc]; // set second spec entry
-            REFPROPdll(hFld, hIn, hOut, iUnits, iMass, mixFlag, a, b, z, hOutput, hUnits, iUCode, x, y, x3, q, ierr, herr, hFld_length, hIn_length, hOut_length, hUnits_length, herr_length);
-            if(ierr != 0)
-            {
-                mexWarnMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "1 Refprop call failed: WARNING %s -> %d %s", unit_char, ierr, herr);
-                hOutput[0] = NAN;
-            }
-
-            propReqOut[(numelVal1 * itc) + itr] = hOutput[0];
-            
-            if (DebugOut == TRUE)
-            {
-                printf("\n************************************\nValue %zu.%zu \nError             = (%d) %s\nFluid(s)          = %s\nInput properties  = %s = (%f, %f)\nOutput properties = %s\nOutput values     = %lf %s \n", itr+1, itc+1, ierr, herr, fluid, hIn, a, b, hOut, hOutput[0], hUnits);
-                
-                std::string parsed(fluid);
-                size_t      bgn = 0;
-                size_t      nnd = 0;
-
-                itrcmp = 0;
-                while (    (itrcmp    <  20)
-                        && (z[itrcmp]  > 0.000000001))
-                {
-                    nnd = parsed.find(";", bgn);
-                    
-                    printf("\nFor: %s\n", parsed.substr(bgn, nnd).c_str());
-                    printf("Liquid Phase Comp = %f\n", x[itrcmp]);
-                    printf("Vapor  Phase Comp = %f\n", y[itrcmp]);
-                    if(x3[itrcmp] > 0.000000001)
-                    {
-                        printf("2nd Liquid Phase  = %f\n", x3[itrcmp]);
-                    }
-                    
-                    bgn = nnd + 1;
-                    itrcmp++;
-                } // end loop over Fluid Composition
-            } // end if printing out debug statement
-
-            /////////////////////////////////////////////////////////////////////////////////////
-            // After the first iteration, we want to change the value of hFld from a string to //
-            // an empty string. This tells the function to continue with the previously loaded //
-            // dll rather than continuously reloading the dll related to the fluid name        //
-            /////////////////////////////////////////////////////////////////////////////////////
-            strncpy(hFld, " ", 2);  
-
-            ////////////////////////////////////////////////////////////////////
-            // loop over the rest of itc for itr = 0 (a remains the same too) //
-            ////////////////////////////////////////////////////////////////////
-            for (itc = 1; itc < numelVal2; itc++)
-            {
-                b = value2[itc]; // set second spec entry
-
-                //////////////////////
-                // Call RefProp dll //
-                //////////////////////
-                REFPROPdll(hFld, hIn, hOut, iUnits, iMass, mixFlag, a, b, z, hOutput, hUnits, iUCode, x, y, x3, q, ierr, herr, hFld_length, hIn_length, hOut_length, hUnits_length, herr_length);
-                if(ierr != 0)
-                {
-                    mexWarnMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "2 Refprop call failed: WARNING %s -> %d %s", unit_char, ierr, herr);
-                    hOutput[0] = NAN;
-                }
-
-                /////////////////////////////////
-                // Fill in the output variable //
-                /////////////////////////////////
-                propReqOut[(numelVal1 * itc) + itr] = hOutput[0];
-
-                //////////////////////////////////////////////////////////////////////////////////////////////////////
-                // Print out to screen, mostly this is for debugging purposes and can be removed or condensed later //
-                //////////////////////////////////////////////////////////////////////////////////////////////////////
-                if (DebugOut == TRUE)
-                {
-                    printf("\n************************************\nValue %zu.%zu \nError             = (%d) %s\nFluid(s)          = %s\nInput properties  = %s = (%f, %f)\nOutput properties = %s\nOutput values     = %lf %s \n", itr+1, itc+1, ierr, herr, fluid, hIn, a, b, hOut, hOutput[0], hUnits);
-
-                    std::string parsed(fluid);
-                    size_t      bgn = 0;
-                    size_t      nnd = 0;
-
-                    itrcmp = 0;
-                    while (    (itrcmp    <  20)
-                            && (z[itrcmp]  > 0.000000001))
-                    {
-                        nnd = parsed.find(";", bgn);
-
-                        printf("\nFor: %s\n", parsed.substr(bgn, nnd).c_str());
-                        printf("Liquid Phase Comp = %f\n", x[itrcmp]);
-                        printf("Vapor  Phase Comp = %f\n", y[itrcmp]);
-                        if(x3[itrcmp] > 0.000000001)
-                        {
-                            printf("2nd Liquid Phase  = %f\n", x3[itrcmp]);
-                        }
-
-                        bgn = nnd + 1;
-                        itrcmp++;
-                    } // end loop over Fluid Composition
-                } // end if printing debug info
-            } // end loop over spec 2 (itc)
-            
-            ///////////////////////////////
-            // continue looping over itr //
-            ///////////////////////////////
-            for (itr = 1; itr < numelVal1; itr++ )
-            {
-                a = value1[itr]; // set first spec entry
-                
-                ///////////////////////////
-                // loop over second spec //
-                ///////////////////////////
-                for (itc = 0; itc < numelVal2; itc++)
-                {
-                    b = value2[itc]; // set second spec entry
-
-                    //////////////////////
-                    // Call RefProp dll //
-                    //////////////////////
-                    REFPROPdll(hFld, hIn, hOut, iUnits, iMass, mixFlag, a, b, z, hOutput, hUnits, iUCode, x, y, x3, q, ierr, herr, hFld_length, hIn_length, hOut_length, hUnits_length, herr_length);
-                    if(ierr != 0)
-                    {
-                        mexWarnMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "3 Refprop call failed: WARNING %s -> %d %s", unit_char, ierr, herr);
-                        hOutput[0] = NAN;
-                    }
-
-                    /////////////////////////////////
-                    // Fill in the output variable //
-                    /////////////////////////////////
-                    propReqOut[(numelVal1 * itc) + itr] = hOutput[0];
-
-                    //////////////////////////////////////////////////////////////////////////////////////////////////////
-                    // Print out to screen, mostly this is for debugging purposes and can be removed or condensed later //
-                    //////////////////////////////////////////////////////////////////////////////////////////////////////
-                    if (DebugOut == TRUE)
-                    {
-                        printf("\n************************************\nValue %zu.%zu \nError             = (%d) %s\nFluid(s)          = %s\nInput properties  = %s = (%f, %f)\nOutput properties = %s\nOutput values     = %lf %s \n", itr+1, itc+1, ierr, herr, fluid, hIn, a, b, hOut, hOutput[0], hUnits);
-
-                        std::string parsed(fluid);
-                        size_t      bgn = 0;
-                        size_t      nnd = 0;
-
-                        itrcmp = 0;
-                        while (    (itrcmp    <  20)
-                                && (z[itrcmp]  > 0.000000001))
-                        {
-                            nnd = parsed.find(";", bgn);
+            mexPrintf("Found Mixture passed in as arguement\n");
+        } // end if .mix file, else if manually defined mixture
+        status = rpeSetUnits(session, unit_char);
+    }
+    if (status == RPE_OK)
+    {
+        status = rpeSetModel(session, (strcmp(model, "fast") == 0) ? RPE_MODEL_FAST : RPE_MODEL_EXACT);
+    }
+    if (status != RPE_OK)
+    {
+        std::string msg(rpeLastError(session));
+        rpeClose(session);
+        mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "%s", msg.c_str());
+    } // end if the fluid, the units or the model failed to set
+
+    /////////////////////////////////////////////////////////////////////
+    // evaluate every output value, stopping between columns on Ctrl-C //
+    /////////////////////////////////////////////////////////////////////
+    rpeSetDebug(session, DebugOut ? 1 : 0);
+    rpeSetInterruptCheck(session, mexInterrupted, NULL);
+    rpeSetDomainCheck(session, domainCheck ? 1 : 0);
+    rpeSetLeverRule(session, leverRule ? 1 : 0);
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // a shared cache that cannot be opened only costs the reuse, the points are  //
+    // still evaluated                                                            //
+    ////////////////////////////////////////////////////////////////////////////////
+    if ((sharedCache[0] != '\0') && (rpeSetSharedCache(session, sharedCache, cacheEntries) != RPE_OK))
+    {
+        mexWarnMsgIdAndTxt("MyToolbox:arrayProduct:cache", "%s Evaluating without the shared cache.", rpeLastError(session));
+    }
 
-                            printf("\nFor: %s\n", parsed.substr(bgn, nnd).c_str());
-                            printf("Liquid Phase Comp = %f\n", x[itrcmp]);
-                            printf("Vapor  Phase Comp = %f\n", y[itrcmp]);
-                            if(x3[itrcmp] > 0.000000001)
-                            {
-                                printf("2nd Liquid Phase  = %f\n", x3[itrcmp]);
-                            }
+    ////////////////////////////////////////////////////////////////////////////////////
+    // q, x, y and x3 are filled by the same flash, the compositions get one more     //
+    // dimension of the number of components after the dimensions of the output       //
+    ////////////////////////////////////////////////////////////////////////////////////
+    double *phaseOut[4] = {NULL, NULL, NULL, NULL};   // q, x, y and x3, when requested
+    for (int itp = 0; itp < numPhaseOut; itp++)
+    {
+        mwSize phaseDims[maxDims + 1];
+        std::copy(mxDims, mxDims + numDims, phaseDims);
+        phaseDims[numDims] = mwSize(rpeNumComponents(session));
+        outputs[statusIdx + 1 + itp] = mxCreateNumericArray(mwSize(numDims + ((itp > 0) ? 1 : 0)), phaseDims, mxDOUBLE_CLASS, mxREAL);
+        phaseOut[itp] = mxGetDoubles(outputs[statusIdx + 1 + itp]);
+    } // end loop over requested phase outputs
+    rpeSetPhaseOutput(session, phaseOut[0], phaseOut[1], phaseOut[2], phaseOut[3]);
+    status = rpeEvaluateExpandedMasked(session, propReq, specSum, numDims, outDims, value1, stride1, value2, stride2,
+                                       mask, propReqOut, pointStatus.empty() ? NULL : pointStatus.data());
+    size_t      numFailed = rpeNumFailed(session);
+    std::string msg(rpeLastError(session));
+    rpeClose(session);
+
+    if (status == RPE_ERR_INTERRUPTED)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:arrayProduct:interrupt", "%s", msg.c_str());
+    }
+    else if (status != RPE_OK)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "%s", msg.c_str());
+    }
+    else if ((numFailed > 0) && pointStatus.empty())
+    {
+        mexWarnMsgIdAndTxt("MyToolbox:arrayProduct:prhs", "%zu of %zu Refprop calls failed and returned NaN, the last: %s", numFailed, numelOut, msg.c_str());
+    } // end if interrupted, else if failed, else if some points failed without the status requested
 
-                            bgn = nnd + 1;
-                            itrcmp++;
-                        } // end loop over Fluid Composition
-                    } // end if printing debug info
-                } // end loop over spec 2  (itc)
-            } // end loop over spec 1 (itr)
-            if (DebugOut == TRUE)
-            {
-                printf("\n************************************\n");
-            } // end if printing debug info
-            
-            //////////////////////////////////////////
-            // Unload refprop to release the memory //
-            //////////////////////////////////////////
-            bool unloaded_REFPROP = unload_REFPROP(serr);
-            if (!unloaded_REFPROP)
-            {
-                printf("REFPROP failed to unload properly.");
-            } // if REFPROP failed to unload
-        } // end if fluid failed, else succeeded, to set
-    } // end if refprop failed, else succeeded, to load
+    if (!pointStatus.empty())
+    {
+        outputs[statusIdx] = mxCreateNumericArray(mwSize(numDims), mxDims, mxDOUBLE_CLASS, mxREAL);
+        double *statusOut  = mxGetDoubles(outputs[statusIdx]);
+        for (size_t itk = 0; itk < numelOut; itk++)
+        {
+            statusOut[itk] = double(pointStatus[itk]);
+        } // end loop over output values
+    } // end if the status is requested
 } // end function operator() -> entry point
-
@@ -0,0 +1,410 @@
+/*=============================================================================================*
+ *  hxMexC.cpp - discretized two-stream heat-exchanger kernel written with the MEX C api.      *
+ *               Marches both streams through numSegments equal-duty segments with one REFPROP *
+ *               load and one fluid setup per stream, and locates the pinch.                   *
+ *                                                                                             *
+ *  From MATLAB(R):                                                                               *
+ *       [profiles, approach, pinch] = hxMexC(hotFluid, hotZ, coldFluid, coldZ, iMass,         *
+ *                                            streams, duty, numSegments, counterflow, path)   *
+ *                                                                                             *
+ *  Where (see: https://refprop-docs.readthedocs.io/en/latest/DLL/legacy.html)                 *
+ *    profiles  = DOUBLE (array of size (numSegments+1)x7x2) node values of the hot (page 1)   *
+ *                and cold (page 2) streams with columns H (J/kg), T (K), Q (kg/kg),           *
+ *                D (kg/m^3), CP (J/(kg K)), viscosity (Pa s) and thermal conductivity         *
+ *                (W/(m K)). Row k is the k-th section from the hot inlet for both streams, so *
+ *                for counterflow the cold stream runs from its outlet (row 1) to its inlet    *
+ *    approach  = DOUBLE (array of size (numSegments+1)x1) hot minus cold temperature at each  *
+ *                section, negative where the temperature profiles cross                       *
+ *    pinch     = DOUBLE (array of size 1x2) row of the smallest approach and its value (K)    *
+ *    hotFluid  = CHAR value accepted by REFPROP as 'hFld' values (for mulit-species,          *
+ *                list numSpec fluids separated by a semicolon (;), where 1 < numSpec <= 20    *
+ *    hotZ      = DOUBLE (array of size 1x20) of species fractions of the hot stream           *
+ *    coldFluid = CHAR 'hFld' value of the cold stream                                         *
+ *    coldZ     = DOUBLE (array of size 1x20) of species fractions of the cold stream          *
+ *    iMass     = INT value to determine input units: 0 -> Molar, 1 -> Mass (sets iMass)       *
+ *    streams   = DOUBLE (array of size 2x3) rows hot and cold with columns pressure (Pa),     *
+ *                inlet enthalpy (J/kg) and mass flow rate (kg/s)                              *
+ *    duty      = DOUBLE heat transferred from the hot to the cold stream (W)                  *
+ *    numSegments = DOUBLE number of equal-duty segments                                       *
+ *    counterflow = DOUBLE (1 for counterflow, 0 for parallel flow)                            *
+ *    path      = CHAR path to Refprop directory (e.g. C:\\ProgramFiles (x86)\\REFPROP)        *
+ *                                                                                             *
+ *  Each stream is at constant pressure. Single-phase nodes are solved by Newton iterations on *
+ *  T started from the previous node's T and density, a full PH flash is only used for         *
+ *  two-phase nodes and where the phase changes. Viscosity and conductivity are NaN for        *
+ *  two-phase nodes. Q of a single-phase node follows REFPROP: -998 for liquid, 998 for vapor  *
+ *  and 999 above the critical pressure, so it is never taken for a saturated state.           *
+ *=============================================================================================*/
+
+// Copyright 2026 The MathWorks, Inc.
+
+#define REFPROP_IMPLEMENTATION
+#define REFPROP_FUNCTION_MODIFIER
+#undef UNICODE
+#include "REFPROP_lib.h"
+#undef REFPROP_FUNCTION_MODIFIER
+#undef REFPROP_IMPLEMENTATION
+#include "refpropMexHelpers.h"
+
+#include <string>
+#include <vector>
+#include <math.h>
+#include "mex.h"
+
+static const size_t numProfile = 7;       // H, T, Q, D, CP, viscosity, conductivity
+static const int    maxNewton  = 20;      // Newton iterations before a node falls back to a full flash
+static const double newtonTol  = 1.0e-9;  // relative enthalpy tolerance of the Newton iterations
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// function to check that the number and type of arguments, in and out, are as expected //
+//////////////////////////////////////////////////////////////////////////////////////////
+void checkArguments(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
+{
+    int expectedIn = 10;  // expected number of input variables
+    int inputInt;
+    double inputDouble;
+
+    if(numOutArg > 3)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:hxMexC:nlhs", "Incorrect number of outputs were given, no more than 3 outputs are allowed");
+    }
+
+    if(numInArg != expectedIn)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:hxMexC:nrhs", "%i inputs were given, but %i are expected.", numInArg, expectedIn);
+    }
+    else if(!mxIsChar(inputs[0]) || !mxIsChar(inputs[2]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:hxMexC:prhs", "Input variables hotFluid and coldFluid expected to be of type CHAR.");
+    }
+    else if(!mxIsDouble(inputs[1]) || (mxGetNumberOfElements(inputs[1]) != 20) ||
+            !mxIsDouble(inputs[3]) || (mxGetNumberOfElements(inputs[3]) != 20))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:hxMexC:prhs", "Input variables hotZ and coldZ expected to be of type DOUBLE with 20 elements.");
+    }
+    else if(!mxIsDouble(inputs[4]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:hxMexC:prhs", "Input variable MassOrMolar expected to be of type DOUBLE with values of 0 or 1.");
+    }
+    else if(!mxIsDouble(inputs[5]) || (mxGetM(inputs[5]) != 2) || (mxGetN(inputs[5]) != 3))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:hxMexC:prhs", "Input variable Streams expected to be of type DOUBLE of size 2x3.");
+    }
+    else if(!mxIsDouble(inputs[6]) || !mxIsDouble(inputs[7]) || !mxIsDouble(inputs[8]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:hxMexC:prhs", "Input variables Duty, NumSegments and Counterflow expected to be of type DOUBLE.");
+    }
+    else if(!mxIsChar(inputs[9]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:hxMexC:prhs", "Input variable PathToRefPropDll expected to be of type CHAR.");
+    }
+    else
+    {
+        inputDouble = mxGetScalar(inputs[4]);
+        inputInt    = int(inputDouble);
+        if ((double(inputInt) != inputDouble) || ((inputInt != 0) && (inputInt != 1)))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:hxMexC:prhs",
+                              "MassOrMolar input of %f is invalid. Acceptable values are 0 for Molar and 1 for Mass to select desired units.", inputDouble);
+        } // end if MassOrMolar is invalid
+
+        inputDouble = mxGetScalar(inputs[7]);
+        if ((inputDouble < 1.0) || (inputDouble != floor(inputDouble)))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:hxMexC:prhs", "NumSegments input of %f is invalid. It must be a positive integer.", inputDouble);
+        } // end if NumSegments is invalid
+
+        const double *streams = mxGetPr(inputs[5]);
+        if ((streams[4] <= 0.0) || (streams[5] <= 0.0))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:hxMexC:prhs", "The mass flow rates of both streams must be positive.");
+        } // end if a mass flow rate is invalid
+    } // end if input types not as expected, else check values
+} // end function checkArguments
+
+///////////////////////////////////////////////////////////////////////////////////////
+// T and molar density of a single-phase node at Pk (kPa) and hm (J/mol) by Newton   //
+// iterations on T from T and D of the previous node, whose molar cp gives the first //
+// step. On return cp is the molar heat capacity at the solution. Returns false when //
+// the iterations do not converge, so the node can be flashed instead                //
+///////////////////////////////////////////////////////////////////////////////////////
+static bool newtonPH(double Pk, double hm, double *z, int kph, double hPrev, double &T, double &D, double &cp,
+                     char *herr)
+{
+    int    ierr   = 0;
+    int    kguess = 1;      // TPRHOdll starts from the density in D
+    double p, e, h, s, cv, w, hjt;
+
+    T = T + (hm - hPrev) / cp;
+    for (int itn = 0; itn < maxNewton; itn++)
+    {
+        TPRHOdll(T, Pk, z, kph, kguess, D, ierr, herr, herr_length);
+        if ((ierr > 0) || !(T > 0.0))
+        {
+            return false;
+        }
+        THERMdll(T, D, z, p, e, h, s, cv, cp, w, hjt);
+        if (fabs(hm - h) <= newtonTol * (1.0 + fabs(hm)))
+        {
+            return true;
+        }
+        T = T + (hm - h) / cp;
+    } // end loop over Newton iterations
+    return false;
+} // end function newtonPH
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// march one stream from its inlet enthalpy hIn through numNodes nodes dh (J/kg) apart at //
+// pressure P (Pa), writing node k to row[k] of the numRows x numProfile profile. The     //
+// fluid is set once and the legacy routines reuse it for every node. Returns the number  //
+// of nodes that failed, with the error of the last one in lastError, or -1 when the      //
+// fluid could not be set                                                                 //
+////////////////////////////////////////////////////////////////////////////////////////////
+static long marchStream(const char *fluid, const double *zIn, int iMass, double P, double hIn, double dh,
+                        size_t numNodes, const size_t *row, size_t numRows, double *profile, std::string &lastError)
+{
+    int    ierr    = 0;                 // OUTPUT: error flag -> 0 = successful, !0 = unsuccessful
+    int    mixFlag = 0;                 // flag to determine whether input is mixture
+    int    kph     = 1;                 // phase of the current node: 1 -> liquid, 2 -> vapor
+    int    kphPrev = 0;                 // phase of the previous single-phase node, 0 if there is none to start from
+    long   numFailed = 0;               // nodes REFPROP could not solve
+    char   herr[herr_length];           // OUTPUT: Error string
+    double zFluid[20];                  // composition as given, a .MIX file fills it in
+    double z[20];                       // Composition on a mole basis
+    double x[20], y[20];                // OUTPUT: Composition of the liquid and vapor phases
+    double wmm;                         // molar mass of the stream (g/mol)
+    double Pk      = P / 1000.0;        // the legacy routines take kPa
+    double hBub    = NAN;               // molar enthalpy of the saturated liquid, NaN above the critical pressure
+    double hDew    = NAN;               // molar enthalpy of the saturated vapor,  NaN above the critical pressure
+    double T = 0.0, D = 0.0, Dl, Dv, q, e, s, cv, cp = 0.0, w, hjt, p, hm, eta, tcx, hPrev = 0.0;
+
+    std::copy(zIn, zIn + 20, zFluid);
+    setRefpropFluid(fluid, zFluid, mixFlag, ierr);
+    if (ierr != 0)
+    {
+        return -1;
+    }
+    if ((iMass == 1) && !isMixFile(fluid))
+    {
+        XMOLEdll(zFluid, z, wmm);
+    }
+    else
+    {
+        std::copy(zFluid, zFluid + 20, z);
+    } // end if mass, else molar composition
+    WMOLdll(z, wmm);
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // the bubble and dew enthalpies at the stream pressure classify every node, //
+    // so only two-phase nodes and the first node of each phase need a flash     //
+    ///////////////////////////////////////////////////////////////////////////////
+    int kphSat = 1;
+    SATPdll(Pk, z, kphSat, T, Dl, Dv, x, y, ierr, herr, herr_length);
+    if (ierr <= 0)
+    {
+        THERMdll(T, Dl, z, p, e, hBub, s, cv, cp, w, hjt);
+        kphSat = 2;
+        SATPdll(Pk, z, kphSat, T, Dl, Dv, x, y, ierr, herr, herr_length);
+        if (ierr <= 0)
+        {
+            THERMdll(T, Dv, z, p, e, hDew, s, cv, cp, w, hjt);
+        }
+        else
+        {
+            hBub = NAN;
+        } // end if the dew point exists, else treat the stream as supercritical
+    } // end if the bubble point exists
+
+    for (size_t itk = 0; itk < numNodes; itk++)
+    {
+        double *node = profile + row[itk];
+        double  h    = hIn + dh * double(itk);
+        hm = h * wmm / 1000.0;   // J/kg -> J/mol
+
+        node[0]                 = h;
+        node[numRows * 5]       = NAN;   // viscosity
+        node[numRows * 6]       = NAN;   // thermal conductivity
+        if (!isnan(hBub) && (hm > hBub) && (hm < hDew))
+        {
+            ///////////////////////////////////////////////////////////////////////
+            // two-phase: the flash gives T and the phase split, cp is undefined //
+            ///////////////////////////////////////////////////////////////////////
+            PHFLSHdll(Pk, hm, z, T, D, Dl, Dv, x, y, q, e, s, cv, cp, w, ierr, herr, herr_length);
+            kphPrev = 0;
+            if (ierr > 0)
+            {
+                numFailed++;
+                lastError = herr;
+                node[numRows] = NAN;  node[numRows * 2] = NAN;  node[numRows * 3] = NAN;  node[numRows * 4] = NAN;
+                continue;
+            }
+            double qkg, xkg[20], ykg[20], wliq, wvap;
+            QMASSdll(q, x, y, qkg, xkg, ykg, wliq, wvap, ierr, herr, herr_length);
+            node[numRows]     = T;
+            node[numRows * 2] = (ierr <= 0) ? qkg : NAN;
+            node[numRows * 3] = D * wmm;   // mol/L -> kg/m^3
+            node[numRows * 4] = NAN;
+            continue;
+        } // end if two-phase
+
+        /////////////////////////////////////////////////////////////////////////////////
+        // single-phase: Newton from the previous node of the same phase, else a flash //
+        /////////////////////////////////////////////////////////////////////////////////
+        kph = (!isnan(hBub) && (hm >= hDew)) ? 2 : 1;
+        if ((kphPrev != kph) || !newtonPH(Pk, hm, z, kph, hPrev, T, D, cp, herr))
+        {
+            PHFLSHdll(Pk, hm, z, T, D, Dl, Dv, x, y, q, e, s, cv, cp, w, ierr, herr, herr_length);
+            if (ierr > 0)
+            {
+                numFailed++;
+                lastError = herr;
+                kphPrev = 0;
+                node[numRows] = NAN;  node[numRows * 2] = NAN;  node[numRows * 3] = NAN;  node[numRows * 4] = NAN;
+                continue;
+            }
+        } // end if the node could not be warm started
+        kphPrev = kph;
+        hPrev   = hm;
+
+        node[numRows]     = T;
+        node[numRows * 2] = isnan(hBub) ? 999.0 : ((kph == 2) ? 998.0 : -998.0);   // REFPROP's single-phase quality
+        node[numRows * 3] = D * wmm;              // mol/L -> kg/m^3
+        node[numRows * 4] = cp * 1000.0 / wmm;    // J/(mol K) -> J/(kg K)
+        TRNPRPdll(T, D, z, eta, tcx, ierr, herr, herr_length);
+        if (ierr <= 0)
+        {
+            node[numRows * 5] = eta * 1.0e-6;     // uPa s -> Pa s
+            node[numRows * 6] = tcx;
+        } // end if transport succeeded
+    } // end loop over nodes
+    return numFailed;
+} // end function marchStream
+
+void mexFunction(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
+{
+    ///////////////////////////////////////////////////////////////////////
+    // check that the input and output variables have the correct format //
+    ///////////////////////////////////////////////////////////////////////
+    checkArguments(numOutArg, outputs, numInArg, inputs);
+
+    ///////////////////////////////
+    // getting the actual inputs //
+    ///////////////////////////////
+    const char   *fluids[2]   = {mxArrayToString(inputs[0]),            // String for the hot  fluid
+                                 mxArrayToString(inputs[2])};           // String for the cold fluid
+    const double *zIn[2]      = {mxGetPr(inputs[1]), mxGetPr(inputs[3])};  // compositions of the hot and cold streams
+          int     iMass       = int(mxGetScalar(inputs[4]));            // Specifies mole or mass based input composition -> 0 = mole, 1 = mass
+    const double *streams     = mxGetPr(        inputs[5]);             // rows hot and cold: P, inlet H, mass flow rate
+          double  duty        = mxGetScalar(    inputs[6]);             // heat from the hot to the cold stream
+          size_t  numSegments = size_t(mxGetScalar(inputs[7]));         // equal-duty segments
+          bool    counterflow = (mxGetScalar(inputs[8]) != 0.0);        // cold stream enters at the hot outlet
+    std::string   path        = std::string(mxArrayToString(inputs[9])); // location of reprop dll
+          size_t  numNodes    = numSegments + 1;                        // sections bounding the segments
+
+    //////////////////////////////////////////////
+    // Allocate memory for the output variables //
+    //////////////////////////////////////////////
+    mwSize profileDims[3] = {numNodes, numProfile, 2};
+    outputs[0] = mxCreateNumericArray(3, profileDims, mxDOUBLE_CLASS, mxREAL);       // [(N+1) x 7 x 2] profiles
+    mxArray *approachArray = mxCreateNumericMatrix(numNodes, 1, mxDOUBLE_CLASS, mxREAL); // [(N+1) x 1] approach
+    mxArray *pinchArray    = mxCreateNumericMatrix(1, 2, mxDOUBLE_CLASS, mxREAL);        // [1 x 2] pinch
+    double  *profileOut    = mxGetPr(outputs[0]);
+    double  *approachOut   = mxGetPr(approachArray);
+    double  *pinchOut      = mxGetPr(pinchArray);
+
+    ///////////////////////////
+    // Setup local variables //
+    ///////////////////////////
+    size_t itk        = 0;                      // iterator over nodes
+    size_t its        = 0;                      // iterator over streams, 0 -> hot, 1 -> cold
+    long   numFailed  = 0;                      // nodes of a stream REFPROP could not solve
+    std::string lastError;                      // error of the last node of a stream that failed
+    const char *names[2] = {"hot", "cold"};     // stream names for messages
+#if defined(_WIN32)
+    std::string DLL_name = "REFPRP64.DLL";      // Refprop dll used on Windows
+#else
+    std::string DLL_name = "";                  // librefprop.so or librefprop.dylib
+#endif
+    std::string serr;                           // load_REFPROP requires the error variable to be a string
+    std::vector<size_t> row(numNodes);          // row of the profile node k of a stream is written to
+
+    /////////////////////////////
+    // loading the Refprop dll //
+    /////////////////////////////
+    if (!load_REFPROP(serr, path, DLL_name))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:hxMexC:load", "REFPROP failed to load from: %s -> %s", path.c_str(), serr.c_str());
+    }
+    SETPATHdll(const_cast<char*>(path.c_str()), 255);
+
+    //////////////////////////////////////////////////////////////////////////////
+    // the segment enthalpy steps follow from the duty alone, so each stream is //
+    // marched on its own with its fluid set once rather than switching REFPROP //
+    // between the two fluids at every segment                                  //
+    //////////////////////////////////////////////////////////////////////////////
+    for (its = 0; its < 2; its++)
+    {
+        double P     = streams[its];
+        double hIn   = streams[2 + its];
+        double mdot  = streams[4 + its];
+        double dh    = ((its == 0) ? -duty : duty) / (double(numSegments) * mdot);
+        bool   flip  = (its == 1) && counterflow;
+        for (itk = 0; itk < numNodes; itk++)
+        {
+            row[itk] = (numNodes * numProfile * its) + (flip ? (numSegments - itk) : itk);
+        } // end loop over nodes
+
+        numFailed = marchStream(fluids[its], zIn[its], iMass, P, hIn, dh, numNodes, row.data(), numNodes,
+                                profileOut, lastError);
+        if (numFailed < 0)
+        {
+            unload_REFPROP(serr);
+            mexErrMsgIdAndTxt("MyToolbox:hxMexC:prhs", "Fluid %s of the %s stream failed to set.", fluids[its], names[its]);
+        }
+        else if (numFailed > 0)
+        {
+            mexWarnMsgIdAndTxt("MyToolbox:hxMexC:refprop", "%ld of %zu nodes of the %s stream failed and are NaN: %s",
+                               numFailed, numNodes, names[its], lastError.c_str());
+        } // end if the fluid failed to set, else if nodes failed
+    } // end loop over streams
+
+    //////////////////////////////////////////////////////////////
+    // approach temperature at each section and the pinch point //
+    //////////////////////////////////////////////////////////////
+    pinchOut[0] = NAN;
+    pinchOut[1] = NAN;
+    for (itk = 0; itk < numNodes; itk++)
+    {
+        approachOut[itk] = profileOut[numNodes + itk] - profileOut[(numNodes * numProfile) + numNodes + itk];
+        if (!isnan(approachOut[itk]) && (isnan(pinchOut[1]) || (approachOut[itk] < pinchOut[1])))
+        {
+            pinchOut[0] = double(itk + 1);
+            pinchOut[1] = approachOut[itk];
+        }
+    } // end loop over sections
+
+    //////////////////////////////////////////
+    // Unload refprop to release the memory //
+    //////////////////////////////////////////
+    if (!unload_REFPROP(serr))
+    {
+        mexWarnMsgIdAndTxt("MyToolbox:hxMexC:unload", "REFPROP failed to unload properly.");
+    } // if REFPROP failed to unload
+
+    if (numOutArg > 1)
+    {
+        outputs[1] = approachArray;
+    }
+    else
+    {
+        mxDestroyArray(approachArray);
+    } // end if approach requested
+    if (numOutArg > 2)
+    {
+        outputs[2] = pinchArray;
+    }
+    else
+    {
+        mxDestroyArray(pinchArray);
+    } // end if pinch requested
+} // end function mexFunction -> entry point
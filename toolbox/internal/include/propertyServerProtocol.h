@@ -0,0 +1,113 @@
+/*=============================================================================================*
+ *  propertyServerProtocol.h - messages exchanged over the Unix domain socket between          *
+ *                             refpropServer and the serverMexC client.                        *
+ *                                                                                             *
+ *  A request is a ServerRequest followed by the propReq, spec, fluid and units characters     *
+ *  (without terminators), then numelVal1 and numelVal2 doubles. The response is a             *
+ *  ServerResponse followed by msgLen characters and numValues doubles in column-major order.  *
+ *  Requests beyond serverMaxTextLen characters or serverMaxNumValues values are rejected.     *
+ *  Both ends run on the same host, so the structs are sent as they are laid out in memory.    *
+ *=============================================================================================*/
+
+// Copyright 2026 The MathWorks, Inc.
+
+#ifndef PROPERTY_SERVER_PROTOCOL_H
+#define PROPERTY_SERVER_PROTOCOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0                               // macOS has no MSG_NOSIGNAL, SIGPIPE is ignored instead
+#endif
+
+static const uint32_t serverMagic        = 0x56535052;  // "RPSV"
+static const uint32_t serverVersion      = 1;
+static const uint32_t serverMaxTextLen   = 10000;       // longest propReq, spec, fluid or units, REFPROP's hFld length
+static const uint64_t serverMaxNumValues = 100000000;   // most values of value1, value2 or the output of one request
+
+struct ServerRequest
+{
+    uint32_t magic;
+    uint32_t version;
+    int32_t  iMass;                                  // 0 -> molar, 1 -> mass composition
+    uint32_t propReqLen;
+    uint32_t specLen;
+    uint32_t fluidLen;
+    uint32_t unitsLen;
+    uint32_t zipped;                                 // 1 -> value1(k) with value2(k) only
+    uint64_t numelVal1;
+    uint64_t numelVal2;
+    double   z[20];                                  // composition, padded to 20 species
+};
+
+struct ServerResponse
+{
+    uint32_t magic;
+    int32_t  status;                                 // 0 -> values follow, otherwise the message says why not
+    uint32_t msgLen;
+    uint32_t cacheHits;                              // points answered from the server cache
+    uint64_t numValues;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// true if the sizes of a request are within the protocol limits, so neither end        //
+// allocates for a request that could not be a real one                                 //
+//////////////////////////////////////////////////////////////////////////////////////////
+static bool requestWithinLimits(const ServerRequest &request)
+{
+    uint64_t numCols = request.zipped ? 1 : request.numelVal2;
+    return (request.propReqLen <= serverMaxTextLen) && (request.specLen  <= serverMaxTextLen) &&
+           (request.fluidLen   <= serverMaxTextLen) && (request.unitsLen <= serverMaxTextLen) &&
+           (request.numelVal1  <= serverMaxNumValues) && (request.numelVal2 <= serverMaxNumValues) &&
+           ((numCols == 0) || (request.numelVal1 <= (serverMaxNumValues / numCols)));
+} // end function requestWithinLimits
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// send or receive exactly numBytes, retrying short transfers. False if the peer closed //
+// the connection or the socket failed                                                  //
+//////////////////////////////////////////////////////////////////////////////////////////
+static bool sendAll(int fd, const void *buffer, size_t numBytes)
+{
+    const char *data = static_cast<const char *>(buffer);
+    while (numBytes > 0)
+    {
+        ssize_t sent = send(fd, data, numBytes, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (sent <= 0)
+        {
+            return false;
+        }
+        data     += sent;
+        numBytes -= size_t(sent);
+    } // end loop until every byte is sent
+    return true;
+} // end function sendAll
+
+static bool recvAll(int fd, void *buffer, size_t numBytes)
+{
+    char *data = static_cast<char *>(buffer);
+    while (numBytes > 0)
+    {
+        ssize_t received = recv(fd, data, numBytes, 0);
+        if (received < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (received <= 0)
+        {
+            return false;
+        }
+        data     += received;
+        numBytes -= size_t(received);
+    } // end loop until every byte is received
+    return true;
+} // end function recvAll
+
+#endif // PROPERTY_SERVER_PROTOCOL_H
@@ -0,0 +1,195 @@
+/*=============================================================================================*
+ *  refpropEngine.h - C interface to the REFPROP evaluation engine used by hiLevelMexC.        *
+ *                    The engine does not depend on MATLAB, so it can be linked into           *
+ *                    S-functions, FMUs or C and C++ models as refpropEngine.cpp or as the     *
+ *                    librefpropEngine shared library built by createREFPROPmex or by          *
+ *                    CMakeLists.txt, which also runs test/refpropEngineTest.cpp.              *
+ *                                                                                             *
+ *  Usage:                                                                                     *
+ *       int status;                                                                           *
+ *       rpeSession *session = rpeOpen("/opt/REFPROP", &status);                               *
+ *       rpeSetFluid(session, "Water", z, 1);                                                  *
+ *       rpeSetUnits(session, "MASS BASE SI");                                                 *
+ *       rpeEvaluate(session, "H", "TP", numPoints, T, P, h);                                  *
+ *       rpeClose(session);                                                                    *
+ *                                                                                             *
+ *  Every function returning int returns an rpeStatus; rpeLastError explains any status other  *
+ *  than RPE_OK. Points REFPROP cannot evaluate are NaN and counted by rpeNumFailed, the rest  *
+ *  of the batch is still evaluated. All sessions of a process share one REFPROP instance,     *
+ *  which is loaded by the first rpeOpen and unloaded by the last rpeClose. REFPROP is not     *
+ *  thread-safe, so a process must not evaluate from two threads at once.                      *
+ *=============================================================================================*/
+
+// Copyright 2026 The MathWorks, Inc.
+
+#ifndef REFPROP_ENGINE_H
+#define REFPROP_ENGINE_H
+
+#include <stddef.h>
+
+#if defined(_WIN32) && defined(RPE_BUILD_DLL)
+#define RPE_API __declspec(dllexport)
+#elif defined(_WIN32) && defined(RPE_USE_DLL)
+#define RPE_API __declspec(dllimport)
+#elif defined(__GNUC__)
+#define RPE_API __attribute__((visibility("default")))
+#else
+#define RPE_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct rpeSession rpeSession;  // opaque, one fluid, composition and unit system
+
+#define RPE_FLUID_LENGTH  10000               // longest fluid string accepted, including the terminator
+#define RPE_STRING_LENGTH   255               // longest propReq, spec and unit string accepted, including the terminator
+
+enum rpeStatus
+{
+    RPE_OK              = 0,  // success
+    RPE_ERR_ARGUMENT    = 1,  // NULL session or pointer, or a string that is too long
+    RPE_ERR_LOAD        = 2,  // REFPROP could not be loaded, or is loaded from another directory
+    RPE_ERR_FLUID       = 3,  // the fluid could not be set
+    RPE_ERR_UNITS       = 4,  // the unit string is not a REFPROP unit system
+    RPE_ERR_NOT_READY   = 5,  // rpeSetFluid or rpeSetUnits has not succeeded yet
+    RPE_ERR_INTERRUPTED = 6,  // the interrupt check asked to stop, see rpeNumEvaluated
+    RPE_ERR_MODEL       = 7,  // the property model could not be switched
+    RPE_ERR_CACHE       = 8   // the shared result cache could not be opened, the session evaluates without it
+};
+
+enum rpePointStatus
+{
+    RPE_POINT_OK           = 0,  // evaluated by REFPROP
+    RPE_POINT_FAILED       = 1,  // REFPROP returned an error, the value is NaN
+    RPE_POINT_MASKED       = 2,  // not selected by the mask, the value is NaN
+    RPE_POINT_OUT_OF_RANGE = 3,  // an input is outside the limits of the equation of state, the value is NaN
+    RPE_POINT_SOLID        = 4   // the state is below the melting or sublimation line, the value is NaN
+};
+
+enum rpeModel
+{
+    RPE_MODEL_EXACT = 0,      // REFPROP's default multiparameter equations of state
+    RPE_MODEL_FAST  = 1       // Peng-Robinson cubic equation of state, for screening
+};
+
+///////////////////////////////////////////////////////////////////////////////////
+// open a session, loading REFPROP from refpropPath if no session has loaded it. //
+// Returns NULL with *status set when it fails, rpeLastError(NULL) says why      //
+///////////////////////////////////////////////////////////////////////////////////
+RPE_API rpeSession *rpeOpen(const char *refpropPath, int *status);
+RPE_API void        rpeClose(rpeSession *session);
+
+//////////////////////////////////////////////////////////////////////////////////////
+// set the fluid ("Water", "R32;R125" or a .MIX file), its 20 species fractions and //
+// their basis (0 -> molar, 1 -> mass), and the REFPROP unit system ("MKS", etc.)   //
+//////////////////////////////////////////////////////////////////////////////////////
+RPE_API int rpeSetFluid(rpeSession *session, const char *fluid, const double *z, int iMass);
+RPE_API int rpeSetUnits(rpeSession *session, const char *units);
+RPE_API int rpeMixtureKind(const rpeSession *session);   // 0 -> pure fluid, 1 -> listed mixture, 2 -> .MIX file
+RPE_API int rpeNumComponents(const rpeSession *session); // components of the fluid set, 0 before rpeSetFluid
+
+///////////////////////////////////////////////////////////////////////////////////////
+// select the rpeModel used by the evaluations of the session. RPE_MODEL_FAST        //
+// switches REFPROP to Peng-Robinson with PREOSdll for each evaluation and back      //
+// afterwards, so other sessions sharing REFPROP keep its default models             //
+///////////////////////////////////////////////////////////////////////////////////////
+RPE_API int rpeSetModel(rpeSession *session, int model);
+RPE_API int rpeGetModel(const rpeSession *session);      // the rpeModel set, RPE_MODEL_EXACT by default
+
+///////////////////////////////////////////////////////////////////////////////////////
+// debugOut prints every point to stdout. isInterrupted is called once per column of //
+// the output (every 256 records for rpeEvaluateRecords) and stops the evaluation    //
+// when it returns nonzero                                                           //
+///////////////////////////////////////////////////////////////////////////////////////
+RPE_API void rpeSetDebug(rpeSession *session, int debugOut);
+RPE_API void rpeSetInterruptCheck(rpeSession *session, int (*isInterrupted)(void *context), void *context);
+
+///////////////////////////////////////////////////////////////////////////////////////
+// domainCheck rejects points of a plain input pair ("TP", "PH", "ST<", ...)         //
+// without calling the solver: a T, P or D outside the limits of the equation of     //
+// state, read once per fluid and unit system, a negative P or D, and a P with Q     //
+// below the triple-point pressure are RPE_POINT_OUT_OF_RANGE, and a T, H or S below //
+// the melting line, or the sublimation line below the triple-point pressure, at the //
+// given P is RPE_POINT_SOLID                                                        //
+///////////////////////////////////////////////////////////////////////////////////////
+RPE_API void rpeSetDomainCheck(rpeSession *session, int domainCheck);
+
+///////////////////////////////////////////////////////////////////////////////////////
+// leverRule resolves two-phase points of a pure fluid without a flash per point:    //
+// for a spec of P with D, E, H, S or Q, or of T with D or Q, the saturated          //
+// liquid and vapor are evaluated once per P or T of the evaluation, and a point     //
+// strictly between them gets the requested T, P, D, E, H, S or Q by the lever rule  //
+// in the quality. Other points, mixtures, other properties and evaluations with     //
+// debug or phase output are evaluated by REFPROP as usual                           //
+///////////////////////////////////////////////////////////////////////////////////////
+RPE_API void rpeSetLeverRule(rpeSession *session, int leverRule);
+
+///////////////////////////////////////////////////////////////////////////////////////
+// the following evaluations of numPoints points also store the vapor quality q[k]   //
+// and the liquid, vapor and second liquid compositions x, y and x3 of point k at    //
+// [c * numPoints + k] for each of the rpeNumComponents components c, on the basis   //
+// of iMass. Points that are not evaluated or fail are NaN. Any of them may be NULL, //
+// and rpeSetPhaseOutput(session, NULL, NULL, NULL, NULL) stops storing them         //
+///////////////////////////////////////////////////////////////////////////////////////
+RPE_API void rpeSetPhaseOutput(rpeSession *session, double *q, double *x, double *y, double *x3);
+
+///////////////////////////////////////////////////////////////////////////////////////
+// share the results of rpeEvaluateExpandedMasked with every process on the host     //
+// that opens the same cache name, through a shared-memory segment of numEntries     //
+// results created by the first of them (see sharedResultCache.h). A point is looked //
+// up by the REFPROP path, fluid, composition, units, model, propReq, spec and both  //
+// inputs before REFPROP is called. Evaluations with debug or phase output bypass    //
+// the cache. NULL or "" detaches the session from its cache                         //
+///////////////////////////////////////////////////////////////////////////////////////
+RPE_API int rpeSetSharedCache(rpeSession *session, const char *name, size_t numEntries);
+
+///////////////////////////////////////////////////////////////////////////////////////
+// evaluate propReq (REFPROP 'hOut') at numPoints pairs value1[k], value2[k] of spec //
+// (REFPROP 'hIn') into output[k]                                                    //
+///////////////////////////////////////////////////////////////////////////////////////
+RPE_API int rpeEvaluate(rpeSession *session, const char *propReq, const char *spec, size_t numPoints,
+                        const double *value1, const double *value2, double *output);
+
+///////////////////////////////////////////////////////////////////////////////////////
+// evaluate over a column-major output of numDims dimensions outDims. stride1[d] and //
+// stride2[d] step through value1 and value2 along output dimension d, 0 where that  //
+// input is repeated, which gives MATLAB implicit expansion                          //
+///////////////////////////////////////////////////////////////////////////////////////
+RPE_API int rpeEvaluateExpanded(rpeSession *session, const char *propReq, const char *spec, size_t numDims,
+                                const size_t *outDims, const double *value1, const size_t *stride1,
+                                const double *value2, const size_t *stride2, double *output);
+
+///////////////////////////////////////////////////////////////////////////////////////
+// rpeEvaluateExpanded that only evaluates output[k] where mask[k] is nonzero, all   //
+// of them when mask is NULL. pointStatus[k] receives the rpePointStatus of output   //
+// value k unless pointStatus is NULL                                                //
+///////////////////////////////////////////////////////////////////////////////////////
+RPE_API int rpeEvaluateExpandedMasked(rpeSession *session, const char *propReq, const char *spec, size_t numDims,
+                                      const size_t *outDims, const double *value1, const size_t *stride1,
+                                      const double *value2, const size_t *stride2, const unsigned char *mask,
+                                      double *output, int *pointStatus);
+
+///////////////////////////////////////////////////////////////////////////////////////
+// evaluate numRecords records in order, each with its own propReq[k] and spec[k] at //
+// value1[k], value2[k], into output[k]. ierr[k] receives the REFPROP error of the   //
+// record (0 on success) unless ierr is NULL, so a state table mixing TQ, PH and TP  //
+// flashes is one call                                                               //
+///////////////////////////////////////////////////////////////////////////////////////
+RPE_API int rpeEvaluateRecords(rpeSession *session, size_t numRecords, const char *const *propReq,
+                               const char *const *spec, const double *value1, const double *value2,
+                               double *output, int *ierr);
+
+RPE_API size_t      rpeNumEvaluated(const rpeSession *session);  // points evaluated by the last evaluation
+RPE_API size_t      rpeNumFailed(const rpeSession *session);     // points of the last evaluation REFPROP failed on
+RPE_API size_t      rpeNumSkipped(const rpeSession *session);    // points of the last evaluation masked or rejected
+RPE_API size_t      rpeNumCacheHits(const rpeSession *session);  // points of the last evaluation from the shared cache
+RPE_API size_t      rpeNumLeverRule(const rpeSession *session);  // points of the last evaluation by the lever rule
+RPE_API const char *rpeLastError(const rpeSession *session);     // last error or failed point, "" if none, NULL for rpeOpen
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // REFPROP_ENGINE_H
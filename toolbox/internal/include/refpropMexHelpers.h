@@ -0,0 +1,85 @@
+/*=============================================================================================*
+ *  refpropMexHelpers.h - routines shared by the MEX files that call REFPROP                   *
+ *                                                                                             *
+ *  This file must be included after REFPROP_lib.h in a file that defines                      *
+ *  REFPROP_IMPLEMENTATION, since it uses the REFPROP function pointers defined there.         *
+ *=============================================================================================*/
+
+// Copyright 2026 The MathWorks, Inc.
+
+#ifndef REFPROP_MEX_HELPERS_H
+#define REFPROP_MEX_HELPERS_H
+
+#include <algorithm>
+#include <string>
+#include <string.h>
+#include <ctype.h>
+
+/////////////////////////////////////////////////////////////
+// string lengths used for every call to the REFPROP dll   //
+/////////////////////////////////////////////////////////////
+static const int herr_length   =   255;   // length of the error string   (  255 is default)
+static const int hFld_length   = 10000;   // length of fluid name         (10000 is default)
+static const int hIn_length    =   255;   // length of input string       (  255 is default)
+static const int hOut_length   =   255;   // length of output flag string (  255 is default)
+static const int hUnits_length =   255;   // length of units string       (  255 is default)
+
+/////////////////////////////////////////////////////////////////////////////////
+// check to see if the user passed in a .MIX file rather than a list of fluids //
+/////////////////////////////////////////////////////////////////////////////////
+static bool isMixFile(const char *fluid)
+{
+    std::string mix_string_search(fluid);
+    std::transform(mix_string_search.begin(), mix_string_search.end(), mix_string_search.begin(), [](unsigned char c){return tolower(c);});
+
+    std::size_t mixFound = mix_string_search.rfind(".mix");
+    return (mix_string_search.length() > 4) && ((mixFound + 4) == mix_string_search.length());
+} // end function isMixFile
+
+///////////////////////////////////////////////////////////////////////////////////////
+// set the fluid in REFPROP from a .MIX file or a semicolon separated list of fluids //
+// mixFlag is set to 1 for mixtures, ierr is the REFPROP error flag (0 = success)    //
+///////////////////////////////////////////////////////////////////////////////////////
+static void setRefpropFluid(const char *fluid, double *z, int &mixFlag, int &ierr)
+{
+    mixFlag = 0;
+    if (isMixFile(fluid))
+    {
+        SETMIXTUREdll(const_cast<char*>(fluid), z, ierr, hFld_length);
+        mixFlag = 1;
+    }
+    else
+    {
+        if (strchr(fluid, ';') != NULL)
+        {
+            mixFlag = 1;
+        } // end if mixture, else individual fluid
+        SETFLUIDSdll(const_cast<char *>(fluid), ierr, hFld_length);
+    } // end if .mix file, else manual fluid entry
+} // end function setRefpropFluid
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// single call to REFPROPdll for one state point. The hFld, hIn and hOut strings are    //
+// copied so the caller can pass string literals. Returns the REFPROP error flag.       //
+//////////////////////////////////////////////////////////////////////////////////////////
+inline int callREFPROPdll(const char *fluid, const char *spec, const char *props, int iUnits, int iMass, int mixFlag,
+                          double a, double b, double *z, double *hOutput, double &q, double *x, double *y, char *herr)
+{
+    int    ierr   = 0;             // OUTPUT: error flag -> 0 = successful, !0 = unsuccessful
+    int    iUCode = 0;             // OUTPUT: Unit code representing the units of the first property in Output array
+    double x3[20];                 // OUTPUT: Reserved for returning composition of a second liquid phase for LLE or VLLE
+    char   hFld  [hFld_length];    // INPUT:  Fluid string
+    char   hIn   [hIn_length];     // INPUT:  Input string of properties sent to the routine
+    char   hOut  [hOut_length];    // INPUT:  Output string of properties requested from the routine
+    char   hUnits[hUnits_length];  // OUTPUT: Units for the first property in the output array
+
+    strncpy(hFld, fluid, sizeof(hFld) - 1);  hFld[sizeof(hFld) - 1] = '\0';
+    strncpy(hIn,  spec,  sizeof(hIn)  - 1);  hIn [sizeof(hIn)  - 1] = '\0';
+    strncpy(hOut, props, sizeof(hOut) - 1);  hOut[sizeof(hOut) - 1] = '\0';
+
+    REFPROPdll(hFld, hIn, hOut, iUnits, iMass, mixFlag, a, b, z, hOutput, hUnits, iUCode, x, y, x3, q, ierr, herr,
+               hFld_length, hIn_length, hOut_length, hUnits_length, herr_length);
+    return ierr;
+} // end function callREFPROPdll
+
+#endif // REFPROP_MEX_HELPERS_H
@@ -0,0 +1,369 @@
+/*=============================================================================================*
+ *  sharedResultCache.h - result cache in a named shared-memory segment, shared by every       *
+ *                        process on the host that opens the same name, e.g. the process       *
+ *                        workers of a parfor loop.                                            *
+ *                                                                                             *
+ *  The segment is a header followed by a fixed number of 64-byte slots, an open-addressing    *
+ *  hash table probed linearly over sharedCacheProbes slots. A slot holds two hashes of the    *
+ *  query without its inputs (fluid, composition, units, model, propReq and spec), the bits    *
+ *  of the two inputs and the result. Each slot is guarded by its own sequence counter         *
+ *  (a seqlock): a writer makes it odd with a compare-and-swap, fills the slot and makes it    *
+ *  even again, and a reader only accepts a slot whose counter was even and unchanged around   *
+ *  its reads. Nothing blocks: a writer that finds a slot busy skips the store, and a reader   *
+ *  treats it as a miss. A process that dies while writing leaves one slot odd, which is then  *
+ *  never read or written again, rather than a torn result or a held lock. A full table        *
+ *  replaces one of the probed slots, so the segment never grows. A POSIX segment whose        *
+ *  creator died before publishing its header is removed and created again by the next         *
+ *  process that opens it.                                                                     *
+ *                                                                                             *
+ *  POSIX segments (shm_open) stay until the host restarts or they are removed from /dev/shm   *
+ *  on Linux; Windows mappings (Local\ namespace) go away with the last process using them.    *
+ *=============================================================================================*/
+
+// Copyright 2026 The MathWorks, Inc.
+
+#ifndef SHARED_RESULT_CACHE_H
+#define SHARED_RESULT_CACHE_H
+
+#include <atomic>
+#include <string>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+static_assert((ATOMIC_LLONG_LOCK_FREE == 2) && (ATOMIC_INT_LOCK_FREE == 2),
+              "the shared result cache needs lock-free atomics, which are the only ones shared between processes");
+
+static const uint32_t sharedCacheMagic   = 0x43535052;  // "RPSC"
+static const uint32_t sharedCacheVersion = 1;
+static const size_t   sharedCacheProbes  = 8;           // slots searched from the home slot of a key
+
+struct SharedCacheHeader
+{
+    std::atomic<uint32_t> magic;                         // set last by the process that creates the segment
+    uint32_t              version;
+    uint64_t              numSlots;
+    uint8_t               reserved[48];                  // keeps the slots aligned to 64 bytes
+};
+
+struct SharedCacheSlot
+{
+    std::atomic<uint64_t> sequence;                      // 0 -> never written, odd -> being written
+    std::atomic<uint64_t> key;                           // hash of the query without its inputs
+    std::atomic<uint64_t> check;                         // second, independent hash of the same
+    std::atomic<uint64_t> value1;                        // bits of the first input
+    std::atomic<uint64_t> value2;                        // bits of the second input
+    std::atomic<uint64_t> result;                        // bits of the result, failed points are not stored
+    uint64_t              reserved[2];                   // one slot per 64-byte cache line
+};
+
+struct SharedResultCache
+{
+    SharedCacheHeader *header   = NULL;
+    SharedCacheSlot   *slots    = NULL;
+    size_t             numSlots = 0;
+    size_t             numBytes = 0;                     // size of the mapping
+#if defined(_WIN32)
+    HANDLE             mapping  = NULL;
+#endif
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// FNV-1a of numBytes from seed, with a final mix so nearby inputs spread over the slots //
+///////////////////////////////////////////////////////////////////////////////////////////
+static uint64_t sharedCacheHash(const void *data, size_t numBytes, uint64_t seed)
+{
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    uint64_t             hash  = seed;
+    for (size_t itb = 0; itb < numBytes; itb++)
+    {
+        hash ^= bytes[itb];
+        hash *= 0x100000001b3ULL;
+    } // end loop over bytes
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+} // end function sharedCacheHash
+
+static uint64_t sharedCacheBits(double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+} // end function sharedCacheBits
+
+static size_t sharedCacheHome(const SharedResultCache *cache, uint64_t key, uint64_t bits1, uint64_t bits2)
+{
+    return size_t(sharedCacheHash(&bits2, sizeof(bits2), key ^ (bits1 * 0x9e3779b97f4a7c15ULL)) % cache->numSlots);
+} // end function sharedCacheHome
+
+static void closeSharedCache(SharedResultCache *cache)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+#if defined(_WIN32)
+    if (cache->header != NULL)
+    {
+        UnmapViewOfFile(cache->header);
+    }
+    if (cache->mapping != NULL)
+    {
+        CloseHandle(cache->mapping);
+    }
+#else
+    if (cache->header != NULL)
+    {
+        munmap(cache->header, cache->numBytes);
+    }
+#endif
+    delete cache;
+} // end function closeSharedCache
+
+////////////////////////////////////////////////////////////////////////////////////
+// the new segment is zero filled, which is every slot empty, so the creator only //
+// writes the header and publishes it with the magic number. The other processes  //
+// wait up to a second for it, false when it is not published by then            //
+////////////////////////////////////////////////////////////////////////////////////
+static bool publishSharedHeader(SharedResultCache *cache, bool creator, size_t numSlots)
+{
+    if (creator)
+    {
+        cache->header->version  = sharedCacheVersion;
+        cache->header->numSlots = numSlots;
+        cache->header->magic.store(sharedCacheMagic, std::memory_order_release);
+    }
+    for (int itw = 0; (cache->header->magic.load(std::memory_order_acquire) != sharedCacheMagic) && (itw < 1000); itw++)
+    {
+#if defined(_WIN32)
+        Sleep(1);
+#else
+        usleep(1000);
+#endif
+    } // end loop waiting for the creator to initialize the header
+    return cache->header->magic.load(std::memory_order_acquire) == sharedCacheMagic;
+} // end function publishSharedHeader
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// map the segment name, creating it with numSlots slots if no process has yet. A segment //
+// that exists keeps the size it was created with. NULL with msg set when it fails, e.g.  //
+// the creator has not finished initializing it within a second                           //
+////////////////////////////////////////////////////////////////////////////////////////////
+static SharedResultCache *openSharedCache(const char *name, size_t numSlots, std::string &msg)
+{
+    if ((name == NULL) || (name[0] == '\0') || (strlen(name) > 200) || (strpbrk(name, "/\\") != NULL) ||
+        (numSlots == 0))
+    {
+        msg = "The shared cache name must be 1 to 200 characters without slashes, with at least one slot.";
+        return NULL;
+    }
+    SharedResultCache *cache   = new SharedResultCache();
+    size_t             size    = sizeof(SharedCacheHeader) + (numSlots * sizeof(SharedCacheSlot));
+    bool               creator = false;
+
+#if defined(_WIN32)
+    std::string mappingName = std::string("Local\\") + name;
+    cache->mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, DWORD(uint64_t(size) >> 32),
+                                        DWORD(size & 0xffffffffULL), mappingName.c_str());
+    if (cache->mapping == NULL)
+    {
+        msg = "CreateFileMapping failed for " + mappingName + ": error " + std::to_string(GetLastError());
+        closeSharedCache(cache);
+        return NULL;
+    }
+    creator       = (GetLastError() != ERROR_ALREADY_EXISTS);
+    cache->header = static_cast<SharedCacheHeader *>(MapViewOfFile(cache->mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+    if (cache->header == NULL)
+    {
+        msg = "MapViewOfFile failed for " + mappingName + ": error " + std::to_string(GetLastError());
+        closeSharedCache(cache);
+        return NULL;
+    }
+    MEMORY_BASIC_INFORMATION region;
+    VirtualQuery(cache->header, &region, sizeof(region));
+    cache->numBytes = region.RegionSize;
+    publishSharedHeader(cache, creator, numSlots);
+#else
+    std::string segmentName = std::string("/") + name;
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        //////////////////////////////////////////////////////////////////////////
+        // O_EXCL picks one creator, the others wait for it to size the segment //
+        //////////////////////////////////////////////////////////////////////////
+        int fd  = shm_open(segmentName.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        creator = (fd >= 0);
+        if (creator && (ftruncate(fd, off_t(size)) != 0))
+        {
+            msg = "Sizing the shared cache " + segmentName + " failed: " + strerror(errno);
+            close(fd);
+            shm_unlink(segmentName.c_str());
+            delete cache;
+            return NULL;
+        }
+        if (!creator && (errno == EEXIST))
+        {
+            fd = shm_open(segmentName.c_str(), O_RDWR, 0600);
+        }
+        if (fd < 0)
+        {
+            msg = "shm_open failed for " + segmentName + ": " + strerror(errno);
+            delete cache;
+            return NULL;
+        }
+
+        struct stat status;
+        for (int itw = 0; (fstat(fd, &status) == 0) && (size_t(status.st_size) < sizeof(SharedCacheHeader)) && (itw < 1000); itw++)
+        {
+            usleep(1000);
+        } // end loop waiting for the creator to size the segment
+        cache->numBytes = size_t(status.st_size);
+        if (cache->numBytes >= sizeof(SharedCacheHeader))
+        {
+            void *mapped = mmap(NULL, cache->numBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (mapped == MAP_FAILED)
+            {
+                msg = "Mapping the shared cache " + segmentName + " failed: " + strerror(errno);
+                close(fd);
+                delete cache;
+                return NULL;
+            }
+            cache->header = static_cast<SharedCacheHeader *>(mapped);
+        }
+        if (((cache->header != NULL) && publishSharedHeader(cache, creator, numSlots)) || (attempt > 0))
+        {
+            close(fd);
+            break;
+        }
+
+        //////////////////////////////////////////////////////////////////////////////
+        // a creator that died between shm_open and publishing the header left a    //
+        // segment nobody can use, so it is removed and created once more. The name //
+        // is only removed while it still names the segment that was waited for     //
+        //////////////////////////////////////////////////////////////////////////////
+        struct stat named;
+        int         current = shm_open(segmentName.c_str(), O_RDWR, 0600);
+        if ((current >= 0) && (fstat(current, &named) == 0) && (fstat(fd, &status) == 0) &&
+            (named.st_dev == status.st_dev) && (named.st_ino == status.st_ino))
+        {
+            shm_unlink(segmentName.c_str());
+        }
+        if (current >= 0)
+        {
+            close(current);
+        }
+        if (cache->header != NULL)
+        {
+            munmap(cache->header, cache->numBytes);
+            cache->header = NULL;
+        }
+        close(fd);
+    } // end loop over the first attempt and the one after removing a dead segment
+    if (cache->header == NULL)
+    {
+        msg = std::string("The shared cache ") + name + " was not sized by the process that created it.";
+        closeSharedCache(cache);
+        return NULL;
+    }
+#endif
+
+    if ((cache->header->magic.load(std::memory_order_acquire) != sharedCacheMagic) ||
+        (cache->header->version != sharedCacheVersion) ||
+        (sizeof(SharedCacheHeader) + (cache->header->numSlots * sizeof(SharedCacheSlot)) > cache->numBytes))
+    {
+        msg = std::string("The shared cache ") + name + " was not initialized, or by another version.";
+        closeSharedCache(cache);
+        return NULL;
+    }
+    cache->numSlots = size_t(cache->header->numSlots);
+    cache->slots    = reinterpret_cast<SharedCacheSlot *>(cache->header + 1);
+    return cache;
+} // end function openSharedCache
+
+////////////////////////////////////////////////////////////////////////////////////
+// result of the query key, check at the inputs a, b, false when no slot holds it //
+////////////////////////////////////////////////////////////////////////////////////
+static bool sharedCacheLookup(const SharedResultCache *cache, uint64_t key, uint64_t check, double a, double b,
+                              double &result)
+{
+    uint64_t bits1 = sharedCacheBits(a);
+    uint64_t bits2 = sharedCacheBits(b);
+    size_t   home  = sharedCacheHome(cache, key, bits1, bits2);
+    for (size_t itp = 0; itp < sharedCacheProbes; itp++)
+    {
+        SharedCacheSlot &slot   = cache->slots[(home + itp) % cache->numSlots];
+        uint64_t         before = slot.sequence.load(std::memory_order_acquire);
+        if (before == 0)
+        {
+            return false;
+        }
+        if ((before & 1) != 0)
+        {
+            continue;
+        }
+        bool matches = (slot.key.load(std::memory_order_relaxed)    == key)   &&
+                       (slot.check.load(std::memory_order_relaxed)  == check) &&
+                       (slot.value1.load(std::memory_order_relaxed) == bits1) &&
+                       (slot.value2.load(std::memory_order_relaxed) == bits2);
+        uint64_t bits = slot.result.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (matches && (slot.sequence.load(std::memory_order_relaxed) == before))
+        {
+            memcpy(&result, &bits, sizeof(result));
+            return true;
+        }
+    } // end loop over the probed slots
+    return false;
+} // end function sharedCacheLookup
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// store the result of the query key, check at a, b in the first probed slot that is   //
+// empty or holds the same inputs, else in one of the probed slots picked by the hash. //
+// Skipped when another process is writing that slot                                   //
+/////////////////////////////////////////////////////////////////////////////////////////
+static void sharedCacheStore(SharedResultCache *cache, uint64_t key, uint64_t check, double a, double b, double result)
+{
+    uint64_t bits1  = sharedCacheBits(a);
+    uint64_t bits2  = sharedCacheBits(b);
+    size_t   home   = sharedCacheHome(cache, key, bits1, bits2);
+    size_t   target = (home + size_t(check % sharedCacheProbes)) % cache->numSlots;
+    for (size_t itp = 0; itp < sharedCacheProbes; itp++)
+    {
+        SharedCacheSlot &slot = cache->slots[(home + itp) % cache->numSlots];
+        if ((slot.sequence.load(std::memory_order_relaxed) == 0) ||
+            ((slot.key.load(std::memory_order_relaxed) == key) && (slot.value1.load(std::memory_order_relaxed) == bits1) &&
+             (slot.value2.load(std::memory_order_relaxed) == bits2)))
+        {
+            target = (home + itp) % cache->numSlots;
+            break;
+        }
+    } // end loop over the probed slots
+
+    SharedCacheSlot &slot     = cache->slots[target];
+    uint64_t         sequence = slot.sequence.load(std::memory_order_relaxed);
+    if (((sequence & 1) != 0) ||
+        !slot.sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire))
+    {
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.key.store(key, std::memory_order_relaxed);
+    slot.check.store(check, std::memory_order_relaxed);
+    slot.value1.store(bits1, std::memory_order_relaxed);
+    slot.value2.store(bits2, std::memory_order_relaxed);
+    slot.result.store(sharedCacheBits(result), std::memory_order_relaxed);
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+} // end function sharedCacheStore
+
+#endif // SHARED_RESULT_CACHE_H
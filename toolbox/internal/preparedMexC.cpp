@@ -0,0 +1,303 @@
+/*=============================================================================================*
+ *  preparedMexC.cpp - prepared REFPROP queries written with the MEX C api.                    *
+ *                     A query is checked and its unit enum resolved once, then evaluated      *
+ *                     many times from a handle with REFPROP kept loaded between calls.        *
+ *                                                                                             *
+ *  From MATLAB(R):                                                                               *
+ *       handle = preparedMexC('prepare', propReq, spec, fluid, iMass, z, unit_char, path)     *
+ *       output = preparedMexC(handle, value1, value2)                                         *
+ *                preparedMexC('release', handle)                                              *
+ *                preparedMexC('releaseAll')                                                   *
+ *                                                                                             *
+ *  Where (see: https://refprop-docs.readthedocs.io/en/latest/DLL/high_level.html)             *
+ *    handle    = DOUBLE scalar returned by 'prepare', valid until it is released or the mex   *
+ *                file is cleared                                                              *
+ *    output    = DOUBLE (array of size MxN) output from RefProp for the desired Property      *
+ *                from propReq where M is the size of value1 and N is the size of value2       *
+ *    propReq   = CHAR value accepted by REFPROP as 'hOut' values                              *
+ *    spec      = CHAR value accepted by REFPROP as 'hIn'  values                              *
+ *    value1    = DOUBLE (array of size 1xM) of values related to the first character in spec  *
+ *    value2    = DOUBLE (array of size 1xN) of values related to the second character in spec *
+ *    fluid     = CHAR value accepted by REFPROP as 'hFld' values (for mulit-species,          *
+ *                list numSpec fluids separated by a semicolon (;), where 1 < numSpec <= 20    *
+ *    iMass     = INT value to determine input units: 0 -> Molar, 1 -> Mass (sets iMass)       *
+ *    z         = DOUBLE (array of size 1x20) of species fractions                             *
+ *    unit_char = CHAR value to determine units to use (enum as expected by refprop.dll)       *
+ *    path      = CHAR path to Refprop directory (e.g. C:\\ProgramFiles (x86)\\REFPROP)        *
+ *                                                                                             *
+ *  Evaluating a handle only checks that it is valid and that the values are DOUBLE. REFPROP   *
+ *  is unloaded when the last handle is released or the mex file is cleared.                   *
+ *                                                                                             *
+ *  The output array is the only allocation of an evaluation, the REFPROP buffers are on the   *
+ *  stack. Code that must not allocate at all calls rpeEvaluate of refpropEngine.h instead.    *
+ *=============================================================================================*/
+
+// Copyright 2026 The MathWorks, Inc.
+
+#define REFPROP_IMPLEMENTATION
+#define REFPROP_FUNCTION_MODIFIER
+#undef UNICODE
+#include "REFPROP_lib.h"
+#undef REFPROP_FUNCTION_MODIFIER
+#undef REFPROP_IMPLEMENTATION
+#include "refpropMexHelpers.h"
+
+#include <string>
+#include <vector>
+#include <math.h>
+#include "mex.h"
+
+//////////////////////////////////////////////////////////////////
+// everything REFPROPdll needs for a query, resolved at prepare //
+//////////////////////////////////////////////////////////////////
+struct PreparedQuery
+{
+    bool        inUse;
+    std::string propReq;    // hOut
+    std::string spec;       // hIn
+    std::string fluid;      // hFld
+    int         iUnits;     // enum of unit_char from GETENUMdll
+    int         iMass;      // 0 -> molar, 1 -> mass composition
+    int         mixFlag;    // 1 for mixtures
+    double      z[20];      // composition, filled from the .MIX file for predefined mixtures
+};
+
+static std::vector<PreparedQuery> queries;              // handle k is queries[k - 1]
+static std::string                loadedPath;           // REFPROP directory loaded, empty when not loaded
+static size_t                     numInUse   = 0;       // number of handles not yet released
+
+static void unloadPrepared(void)
+{
+    std::string serr;
+    if (!loadedPath.empty())
+    {
+        unload_REFPROP(serr);
+        loadedPath.clear();
+    }
+    queries.clear();
+    numInUse = 0;
+} // end function unloadPrepared
+
+/////////////////////////////////////////////////////////////////////////////
+// return the query of a handle, raising an error if it is not a valid one //
+/////////////////////////////////////////////////////////////////////////////
+static PreparedQuery &getQuery(const mxArray *handleIn)
+{
+    double handle = mxIsDouble(handleIn) && (mxGetNumberOfElements(handleIn) == 1) ? mxGetScalar(handleIn) : 0.0;
+    size_t index  = size_t(handle);
+    if ((double(index) != handle) || (index < 1) || (index > queries.size()) || !queries[index - 1].inUse)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:preparedMexC:handle", "Invalid prepared query handle. Prepare the query again with prepareFluidProperty.");
+    }
+    return queries[index - 1];
+} // end function getQuery
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// function to check that the number and type of arguments, in and out, are as expected //
+//////////////////////////////////////////////////////////////////////////////////////////
+void checkPrepareArguments(int numOutArg, int numInArg, const mxArray *inputs[])
+{
+    int expectedIn = 8;   // expected number of input variables, including the command
+    int inputInt;
+    double inputDouble;
+
+    if(numOutArg > 1)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:preparedMexC:nlhs", "Incorrect number of outputs were given, only 1 output is allowed");
+    }
+
+    if(numInArg != expectedIn)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:preparedMexC:nrhs", "%i inputs were given, but %i are expected.", numInArg, expectedIn);
+    }
+    else if(!mxIsChar(inputs[1]) || !mxIsChar(inputs[2]) || !mxIsChar(inputs[3]) || !mxIsChar(inputs[6]) || !mxIsChar(inputs[7]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:preparedMexC:prhs", "Input variables propReq, spec, fluid, unit_char and path expected to be of type CHAR.");
+    }
+    else if(!mxIsDouble(inputs[4]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:preparedMexC:prhs", "Input variable MassOrMolar expected to be of type DOUBLE with values of 0 or 1.");
+    }
+    else if(!mxIsDouble(inputs[5]) || (mxGetNumberOfElements(inputs[5]) != 20))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:preparedMexC:prhs", "Input variable Composition expected to be of type DOUBLE with 20 elements.");
+    }
+    else
+    {
+        inputDouble = mxGetScalar(inputs[4]);
+        inputInt    = int(inputDouble);
+        if ((double(inputInt) != inputDouble) || ((inputInt != 0) && (inputInt != 1)))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:preparedMexC:prhs",
+                              "MassOrMolar input of %f is invalid. Acceptable values are 0 for Molar and 1 for Mass to select desired units.", inputDouble);
+        } // end if MassOrMolar is invalid
+    } // end if input types not as expected, else check values
+} // end function checkPrepareArguments
+
+////////////////////////////////////////////////////////////////////////////////////
+// load REFPROP if needed, set the fluid and resolve the units, return the handle //
+////////////////////////////////////////////////////////////////////////////////////
+static double prepareQuery(const mxArray *inputs[])
+{
+    PreparedQuery query;
+    query.inUse   = true;
+    query.propReq = std::string(mxArrayToString(inputs[1]));
+    query.spec    = std::string(mxArrayToString(inputs[2]));
+    query.fluid   = std::string(mxArrayToString(inputs[3]));
+    query.iMass   = int(mxGetScalar(inputs[4]));
+    std::copy(mxGetPr(inputs[5]), mxGetPr(inputs[5]) + 20, query.z);
+    char        *unit_char = mxArrayToString(inputs[6]);
+    std::string  path      = std::string(mxArrayToString(inputs[7]));
+
+    int         ierr     = 0;                   // OUTPUT: error flag -> 0 = successful, !0 = unsuccessful
+    int         iFlag    = 0;                   // INPUT:  GETENUMdll checks all possible strings
+    char        herr[herr_length];              // OUTPUT: Error string
+#if defined(_WIN32)
+    std::string DLL_name = "REFPRP64.DLL";      // Refprop dll used on Windows
+#else
+    std::string DLL_name = "";                  // librefprop.so or librefprop.dylib
+#endif
+    std::string serr;                           // load_REFPROP requires the error variable to be a string
+
+    //////////////////////////////////////////////////////////////////////////
+    // REFPROP is loaded once for every handle, so they must share its path //
+    //////////////////////////////////////////////////////////////////////////
+    if (!loadedPath.empty() && (path != loadedPath))
+    {
+        if (numInUse > 0)
+        {
+            mexErrMsgIdAndTxt("MyToolbox:preparedMexC:load", "Prepared queries already use REFPROP from %s. Release them before preparing queries for %s.", loadedPath.c_str(), path.c_str());
+        }
+        unloadPrepared();
+    }
+    if (loadedPath.empty())
+    {
+        if (!load_REFPROP(serr, path, DLL_name))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:preparedMexC:load", "REFPROP failed to load from: %s -> %s", path.c_str(), serr.c_str());
+        }
+        SETPATHdll(const_cast<char*>(path.c_str()), 255);
+        loadedPath = path;
+        mexAtExit(unloadPrepared);
+    }
+
+    setRefpropFluid(query.fluid.c_str(), query.z, query.mixFlag, ierr);
+    if (ierr != 0)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:preparedMexC:prhs", "Fluid %s failed to set: Error %d", query.fluid.c_str(), ierr);
+    }
+
+    GETENUMdll(iFlag, unit_char, query.iUnits, ierr, herr, hUnits_length, herr_length);
+    if (ierr != 0)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:preparedMexC:prhs", "Converting %s to enum failed: Error %d -> %s", unit_char, ierr, herr);
+    }
+
+    /////////////////////////////////////////////////////////
+    // reuse the slot of a released handle if there is one //
+    /////////////////////////////////////////////////////////
+    size_t index = 0;
+    while ((index < queries.size()) && queries[index].inUse)
+    {
+        index++;
+    } // end loop looking for a free slot
+    if (index == queries.size())
+    {
+        queries.push_back(query);
+    }
+    else
+    {
+        queries[index] = query;
+    }
+    numInUse++;
+    return double(index + 1);
+} // end function prepareQuery
+
+//////////////////////////////////////////////////////////////////////////////////////
+// evaluate a prepared query on every pair of value1 and value2, NaN where it fails //
+//////////////////////////////////////////////////////////////////////////////////////
+static void evaluateQuery(const PreparedQuery &query, const mxArray *value1In, const mxArray *value2In, mxArray *&output)
+{
+    const double *value1    = mxGetPr(value1In);
+    const double *value2    = mxGetPr(value2In);
+    size_t        numelVal1 = mxGetNumberOfElements(value1In);
+    size_t        numelVal2 = mxGetNumberOfElements(value2In);
+
+    output = mxCreateUninitNumericMatrix(numelVal1, numelVal2, mxDOUBLE_CLASS, mxREAL);   // every element is written below
+    double *propReqOut = mxGetPr(output);
+
+    int    ierr;                                // OUTPUT: error flag -> 0 = successful, !0 = unsuccessful
+    double hOutput[200];                        // OUTPUT: Array of properties specified by hOut
+    double q;                                   // OUTPUT: Vapor quality
+    double x[20];                               // OUTPUT: Composition of liquid phase
+    double y[20];                               // OUTPUT: Composition of vapor phase
+    double z[20];                               // INPUT:  Composition, REFPROPdll may not keep it constant
+    char   herr[herr_length];                   // OUTPUT: Error string
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // other mex files share the loaded REFPROP, so the first point always names //
+    // the fluid. REFPROP skips the setup when it is the fluid already set       //
+    ///////////////////////////////////////////////////////////////////////////////
+    std::copy(query.z, query.z + 20, z);
+    const char *fluid = query.fluid.c_str();
+    for (size_t itc = 0; itc < numelVal2; itc++)
+    {
+        for (size_t itr = 0; itr < numelVal1; itr++)
+        {
+            ierr = callREFPROPdll(fluid, query.spec.c_str(), query.propReq.c_str(), query.iUnits, query.iMass,
+                                  query.mixFlag, value1[itr], value2[itc], z, hOutput, q, x, y, herr);
+            if (ierr != 0)
+            {
+                mexWarnMsgIdAndTxt("MyToolbox:preparedMexC:refprop", "Refprop call failed: WARNING %d %s", ierr, herr);
+                hOutput[0] = NAN;
+            }
+            propReqOut[(numelVal1 * itc) + itr] = hOutput[0];
+            fluid = " ";
+        } // end loop over value1
+    } // end loop over value2
+} // end function evaluateQuery
+
+void mexFunction(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
+{
+    ///////////////////////////////////////////////////////////////////////
+    // evaluating a handle is the call made most often, so it goes first //
+    ///////////////////////////////////////////////////////////////////////
+    if ((numInArg > 0) && !mxIsChar(inputs[0]))
+    {
+        if ((numInArg != 3) || !mxIsDouble(inputs[1]) || !mxIsDouble(inputs[2]))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:preparedMexC:prhs", "A prepared query is evaluated as output = preparedMexC(handle, value1, value2) with DOUBLE values.");
+        }
+        evaluateQuery(getQuery(inputs[0]), inputs[1], inputs[2], outputs[0]);
+        return;
+    }
+
+    if (numInArg == 0)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:preparedMexC:nrhs", "A command ('prepare', 'release' or 'releaseAll') or a handle is expected.");
+    }
+    std::string command(mxArrayToString(inputs[0]));
+
+    if (command == "prepare")
+    {
+        checkPrepareArguments(numOutArg, numInArg, inputs);
+        outputs[0] = mxCreateDoubleScalar(prepareQuery(inputs));
+    }
+    else if ((command == "release") && (numInArg == 2))
+    {
+        getQuery(inputs[1]).inUse = false;
+        numInUse--;
+        if (numInUse == 0)
+        {
+            unloadPrepared();
+        }
+    }
+    else if ((command == "releaseAll") && (numInArg == 1))
+    {
+        unloadPrepared();
+    }
+    else
+    {
+        mexErrMsgIdAndTxt("MyToolbox:preparedMexC:prhs", "Unknown command %s with %i inputs.", command.c_str(), numInArg);
+    } // end if prepare, else if release, else if releaseAll
+} // end function mexFunction
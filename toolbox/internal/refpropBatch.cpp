@@ -0,0 +1,556 @@
+/*=============================================================================================*
+ *  refpropBatch.cpp - evaluates a REFPROP property grid in shards without MATLAB, so large    *
+ *                     property tables can be spread over the cores and nodes of a cluster.    *
+ *                                                                                             *
+ *  From a shell:                                                                              *
+ *       refpropBatch run jobFile shardIndex numShards chunkFile                               *
+ *       refpropBatch merge jobFile outputFile chunkFile...                                    *
+ *                                                                                             *
+ *  Where                                                                                      *
+ *    jobFile    = text file of "key = value" lines describing the grid, '#' starts a comment: *
+ *                   refprop     = path to the Refprop directory holding the shared library    *
+ *                   fluid       = fluid string, e.g., Water or R32;R125                       *
+ *                   composition = species fractions separated by spaces (default 1)           *
+ *                   massOrMolar = 0 -> Molar, 1 -> Mass composition (default 1)               *
+ *                   units       = REFPROP unit system (default MASS BASE SI)                  *
+ *                   model       = exact or fast (default exact), see refpropEngine.h          *
+ *                   domainCheck = 1 -> NaN outside the equation of state limits (default 0)   *
+ *                   outputs     = requested properties separated by spaces, e.g., H S D       *
+ *                   input1      = name and M values of the 1st input property, the values as  *
+ *                                 a list or as "linspace a b n" or "logspace a b n"           *
+ *                   input2      = name and N values of the 2nd input property, likewise       *
+ *    shardIndex = shard to evaluate, 0 <= shardIndex < numShards                              *
+ *    numShards  = number of shards the job is split into                                      *
+ *    chunkFile  = binary file the shard is written to                                         *
+ *    outputFile = file the merged grid is written to, in the layout of                        *
+ *                 readFluidPropertyStream.m                                                   *
+ *                                                                                             *
+ *  The MxN grid of (input1, input2) points is split into numShards contiguous ranges of its   *
+ *  column-major index, and each shard is evaluated through the same refpropEngine as          *
+ *  hiLevelMexC, so the values match getFluidProperty. REFPROP is not thread-safe, so a shard  *
+ *  is one process; run the shards in parallel as separate processes, e.g., with xargs -P or   *
+ *  a scheduler array job. merge checks that the chunks were written for the job file and      *
+ *  cover every point once before writing the MxNxP result.                                    *
+ *                                                                                             *
+ *  Chunk layout (little-endian):                                                              *
+ *    bytes 0-7   'FLPSHRD1'                                                                   *
+ *    uint32      format version (1), uint32 reserved                                          *
+ *    uint64 x 6  hash of the job, M, N, P, first point, number of points                      *
+ *    double      values, one block of the shard's points per requested property               *
+ *=============================================================================================*/
+
+// Copyright 2026 The MathWorks, Inc.
+
+#include "refpropEngine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char   shardMagic[8]    = {'F', 'L', 'P', 'S', 'H', 'R', 'D', '1'};
+static const char   streamMagic[8]   = {'F', 'L', 'P', 'S', 'T', 'R', 'M', '1'};
+static const size_t shardHeaderBytes = 8 + 4 + 4 + (6 * 8);
+static const size_t pointsPerBlock   = 65536;   // points evaluated and written at a time
+
+struct BatchJob
+{
+    std::string              refpropPath;
+    std::string              fluid;
+    std::vector<double>      composition = {1.0};
+    int                      massOrMolar = 1;
+    std::string              units       = "MASS BASE SI";
+    std::string              model       = "exact";
+    int                      domainCheck = 0;
+    std::vector<std::string> outputs;
+    std::string              input1;
+    std::vector<double>      values1;
+    std::string              input2;
+    std::vector<double>      values2;
+};
+
+struct ShardHeader
+{
+    uint64_t jobHash;
+    uint64_t numRows;
+    uint64_t numCols;
+    uint64_t numProp;
+    uint64_t first;
+    uint64_t count;
+};
+
+static std::string trim(const std::string &text)
+{
+    size_t start = text.find_first_not_of(" \t\r\n");
+    size_t end   = text.find_last_not_of(" \t\r\n");
+    return (start == std::string::npos) ? std::string() : text.substr(start, end - start + 1);
+} // end function trim
+
+static std::vector<std::string> splitWords(const std::string &text, const char *separators)
+{
+    std::vector<std::string> words;
+    size_t start = text.find_first_not_of(separators);
+    while (start != std::string::npos)
+    {
+        size_t end = text.find_first_of(separators, start);
+        words.push_back(text.substr(start, end - start));
+        start = text.find_first_not_of(separators, end);
+    } // end loop over words
+    return words;
+} // end function splitWords
+
+static bool parseNumber(const std::string &word, double &value)
+{
+    char *end = NULL;
+    value     = strtod(word.c_str(), &end);
+    return (end != word.c_str()) && (*end == '\0') && isfinite(value);
+} // end function parseNumber
+
+////////////////////////////////////////////////////////////////////////////
+// "name v1 v2 ...", "name linspace a b n" or "name logspace a b n", with //
+// the spacing of MATLAB's linspace and logspace                          //
+////////////////////////////////////////////////////////////////////////////
+static bool parseInput(const std::string &text, std::string &name, std::vector<double> &values)
+{
+    std::vector<std::string> words = splitWords(text, " \t");
+    if (words.size() < 2)
+    {
+        return false;
+    }
+    name = words[0];
+    values.clear();
+    if ((words[1] == "linspace") || (words[1] == "logspace"))
+    {
+        double a, b, n;
+        if ((words.size() != 5) || !parseNumber(words[2], a) || !parseNumber(words[3], b) ||
+            !parseNumber(words[4], n) || (n < 1) || (n != floor(n)))
+        {
+            return false;
+        }
+        size_t numValues = size_t(n);
+        for (size_t itv = 0; itv < numValues; itv++)
+        {
+            double exponent = (itv + 1 == numValues) ? b : a + ((b - a) * double(itv)) / double(numValues - 1);
+            values.push_back((words[1] == "logspace") ? pow(10.0, exponent) : exponent);
+        } // end loop over values
+        return true;
+    }
+    for (size_t itw = 1; itw < words.size(); itw++)
+    {
+        double value;
+        if (!parseNumber(words[itw], value))
+        {
+            return false;
+        }
+        values.push_back(value);
+    } // end loop over values
+    return true;
+} // end function parseInput
+
+static bool readJob(const char *jobFile, BatchJob &job)
+{
+    FILE *file = fopen(jobFile, "r");
+    if (file == NULL)
+    {
+        perror(jobFile);
+        return false;
+    }
+    bool        valid  = true;
+    int         lineNo = 0;
+    char        buffer[65536];
+    std::string line;
+    while (valid && (fgets(buffer, sizeof(buffer), file) != NULL))
+    {
+        line = buffer;
+        lineNo++;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty())
+        {
+            continue;
+        }
+        size_t      equals = line.find('=');
+        std::string key    = trim(line.substr(0, equals));
+        std::string value  = (equals == std::string::npos) ? std::string() : trim(line.substr(equals + 1));
+        double      number = 0;
+
+        if (key == "refprop")
+        {
+            job.refpropPath = value;
+        }
+        else if (key == "fluid")
+        {
+            job.fluid = value;
+        }
+        else if (key == "units")
+        {
+            job.units = value;
+        }
+        else if (key == "model")
+        {
+            job.model = value;
+            valid     = (value == "exact") || (value == "fast");
+        }
+        else if (key == "outputs")
+        {
+            job.outputs = splitWords(value, " \t;");
+        }
+        else if (key == "input1")
+        {
+            valid = parseInput(value, job.input1, job.values1);
+        }
+        else if (key == "input2")
+        {
+            valid = parseInput(value, job.input2, job.values2);
+        }
+        else if (key == "massOrMolar")
+        {
+            valid = parseNumber(value, number) && ((number == 0) || (number == 1));
+            job.massOrMolar = int(number);
+        }
+        else if (key == "domainCheck")
+        {
+            valid = parseNumber(value, number) && ((number == 0) || (number == 1));
+            job.domainCheck = int(number);
+        }
+        else if (key == "composition")
+        {
+            job.composition.clear();
+            for (const std::string &word : splitWords(value, " \t"))
+            {
+                valid = valid && parseNumber(word, number);
+                job.composition.push_back(number);
+            } // end loop over species
+        }
+        else
+        {
+            valid = false;
+        }
+        if (!valid)
+        {
+            fprintf(stderr, "refpropBatch: %s line %d: cannot read \"%s\"\n", jobFile, lineNo, line.c_str());
+        }
+    } // end loop over lines
+    fclose(file);
+
+    if (valid && (job.refpropPath.empty() || job.fluid.empty() || job.outputs.empty() || job.values1.empty() ||
+                  job.values2.empty() || job.composition.empty()))
+    {
+        fprintf(stderr, "refpropBatch: %s must set refprop, fluid, outputs, input1 and input2\n", jobFile);
+        valid = false;
+    }
+    return valid;
+} // end function readJob
+
+static void appendJsonString(std::string &json, const std::string &text)
+{
+    json += '"';
+    for (char c : text)
+    {
+        if ((c == '"') || (c == '\\'))
+        {
+            json += '\\';
+        }
+        json += c;
+    } // end loop over characters
+    json += '"';
+} // end function appendJsonString
+
+static void appendJsonNumbers(std::string &json, const std::vector<double> &values)
+{
+    char number[32];
+    json += (values.size() == 1) ? "" : "[";
+    for (size_t itv = 0; itv < values.size(); itv++)
+    {
+        snprintf(number, sizeof(number), (itv == 0) ? "%.17g" : ",%.17g", values[itv]);
+        json += number;
+    } // end loop over values
+    json += (values.size() == 1) ? "" : "]";
+} // end function appendJsonNumbers
+
+////////////////////////////////////////////////////////////////////////////////////////
+// the job as the JSON metadata of streamFluidProperty, which                         //
+// readFluidPropertyStream returns as info.meta, with the unit system and model added //
+////////////////////////////////////////////////////////////////////////////////////////
+static std::string jobMetaText(const BatchJob &job)
+{
+    std::string json = "{\"library\":\"REFPROP\",\"fluid\":";
+    appendJsonString(json, job.fluid);
+    json += ",\"fluidComposition\":";
+    appendJsonNumbers(json, job.composition);
+    json += ",\"massOrMolar\":" + std::to_string(job.massOrMolar) + ",\"requestedProperties\":";
+    json += (job.outputs.size() == 1) ? "" : "[";
+    for (size_t itp = 0; itp < job.outputs.size(); itp++)
+    {
+        json += (itp == 0) ? "" : ",";
+        appendJsonString(json, job.outputs[itp]);
+    } // end loop over requested properties
+    json += (job.outputs.size() == 1) ? "" : "]";
+    json += ",\"inputProperty1\":";
+    appendJsonString(json, job.input1);
+    json += ",\"inputProperty1Value\":";
+    appendJsonNumbers(json, job.values1);
+    json += ",\"inputProperty2\":";
+    appendJsonString(json, job.input2);
+    json += ",\"inputProperty2Value\":";
+    appendJsonNumbers(json, job.values2);
+    json += ",\"units\":";
+    appendJsonString(json, job.units);
+    json += ",\"model\":";
+    appendJsonString(json, job.model);
+    json += ",\"domainCheck\":" + std::to_string(job.domainCheck) + "}";
+    return json;
+} // end function jobMetaText
+
+static uint64_t hashText(const std::string &text)
+{
+    uint64_t hash = 14695981039346656037ULL;   // FNV-1a
+    for (unsigned char c : text)
+    {
+        hash = (hash ^ c) * 1099511628211ULL;
+    } // end loop over characters
+    return hash;
+} // end function hashText
+
+static int runShard(const BatchJob &job, size_t shardIndex, size_t numShards, const char *chunkFile)
+{
+    auto        start     = std::chrono::steady_clock::now();
+    size_t      numRows   = job.values1.size();
+    size_t      numPoints = numRows * job.values2.size();
+    ShardHeader header    = {hashText(jobMetaText(job)), numRows, job.values2.size(), job.outputs.size(),
+                             (numPoints * shardIndex) / numShards, 0};
+    header.count          = (numPoints * (shardIndex + 1)) / numShards - header.first;
+
+    int         status  = RPE_OK;
+    rpeSession *session = rpeOpen(job.refpropPath.c_str(), &status);
+    if (session == NULL)
+    {
+        fprintf(stderr, "refpropBatch: %s\n", rpeLastError(NULL));
+        return 1;
+    }
+    rpeSetDomainCheck(session, job.domainCheck);
+    if (((status = rpeSetFluid(session, job.fluid.c_str(), job.composition.data(), job.massOrMolar)) != RPE_OK) ||
+        ((status = rpeSetUnits(session, job.units.c_str())) != RPE_OK) ||
+        ((status = rpeSetModel(session, (job.model == "fast") ? RPE_MODEL_FAST : RPE_MODEL_EXACT)) != RPE_OK))
+    {
+        fprintf(stderr, "refpropBatch: %s\n", rpeLastError(session));
+        rpeClose(session);
+        return 1;
+    }
+
+    FILE *file = fopen(chunkFile, "wb");
+    if (file == NULL)
+    {
+        perror(chunkFile);
+        rpeClose(session);
+        return 1;
+    }
+    uint32_t version[2] = {1, 0};
+    bool     written    = (fwrite(shardMagic, 1, 8, file) == 8) && (fwrite(version, 4, 2, file) == 2) &&
+                          (fwrite(&header, 8, 6, file) == 6);
+
+    ////////////////////////////////////////////////////////////////////////////
+    // one block of points at a time, written to each property's part of the  //
+    // chunk, so the memory used does not depend on the size of the shard     //
+    ////////////////////////////////////////////////////////////////////////////
+    size_t              numFailed = 0;
+    std::vector<double> value1, value2, output;
+    for (size_t blockStart = 0; written && (blockStart < header.count); blockStart += pointsPerBlock)
+    {
+        size_t blockSize = std::min(pointsPerBlock, size_t(header.count) - blockStart);
+        value1.resize(blockSize);
+        value2.resize(blockSize);
+        output.resize(blockSize);
+        for (size_t itk = 0; itk < blockSize; itk++)
+        {
+            size_t point = header.first + blockStart + itk;
+            value1[itk]  = job.values1[point % numRows];
+            value2[itk]  = job.values2[point / numRows];
+        } // end loop over points of the block
+
+        for (size_t itp = 0; written && (itp < job.outputs.size()); itp++)
+        {
+            status = rpeEvaluate(session, job.outputs[itp].c_str(), (job.input1 + job.input2).c_str(), blockSize,
+                                 value1.data(), value2.data(), output.data());
+            if (status != RPE_OK)
+            {
+                fprintf(stderr, "refpropBatch: %s\n", rpeLastError(session));
+                rpeClose(session);
+                fclose(file);
+                remove(chunkFile);
+                return 1;
+            }
+            numFailed += rpeNumFailed(session);
+            written    = (fseeko(file, off_t(shardHeaderBytes + 8 * (itp * header.count + blockStart)), SEEK_SET) == 0)
+                         && (fwrite(output.data(), 8, blockSize, file) == blockSize);
+        } // end loop over requested properties
+    } // end loop over blocks
+    rpeClose(session);
+    written = (fclose(file) == 0) && written;
+    if (!written)
+    {
+        fprintf(stderr, "refpropBatch: cannot write %s\n", chunkFile);
+        remove(chunkFile);
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    fprintf(stderr, "refpropBatch: shard %zu of %zu, points %llu to %llu, %zu values failed, %.1f s\n", shardIndex,
+            numShards, (unsigned long long)header.first, (unsigned long long)(header.first + header.count),
+            numFailed, seconds);
+    return 0;
+} // end function runShard
+
+static int mergeShards(const BatchJob &job, const char *outputFile, int numChunks, char *chunkFiles[])
+{
+    std::string metaText  = jobMetaText(job);
+    uint64_t    jobHash   = hashText(metaText);
+    uint64_t    numRows   = job.values1.size();
+    uint64_t    numCols   = job.values2.size();
+    uint64_t    numProp   = job.outputs.size();
+    uint64_t    numPoints = numRows * numCols;
+
+    ////////////////////////////////////////////////////////////////////////
+    // read every chunk header first, so nothing is written unless the    //
+    // chunks belong to the job and cover each point exactly once         //
+    ////////////////////////////////////////////////////////////////////////
+    std::vector<ShardHeader> headers(numChunks);
+    for (int itc = 0; itc < numChunks; itc++)
+    {
+        char     magic[8];
+        uint32_t version[2];
+        FILE    *chunk = fopen(chunkFiles[itc], "rb");
+        bool     valid = (chunk != NULL) && (fread(magic, 1, 8, chunk) == 8) && (fread(version, 4, 2, chunk) == 2) &&
+                         (fread(&headers[itc], 8, 6, chunk) == 6) && (memcmp(magic, shardMagic, 8) == 0) &&
+                         (version[0] == 1);
+        if (chunk != NULL)
+        {
+            fclose(chunk);
+        }
+        if (!valid)
+        {
+            fprintf(stderr, "refpropBatch: %s is not a chunk written by refpropBatch run\n", chunkFiles[itc]);
+            return 1;
+        }
+        if ((headers[itc].jobHash != jobHash) || (headers[itc].numRows != numRows) ||
+            (headers[itc].numCols != numCols) || (headers[itc].numProp != numProp))
+        {
+            fprintf(stderr, "refpropBatch: %s was written for a different job\n", chunkFiles[itc]);
+            return 1;
+        }
+    } // end loop over chunks
+
+    std::vector<int> order(numChunks);
+    for (int itc = 0; itc < numChunks; itc++)
+    {
+        order[itc] = itc;
+    } // end loop over chunks
+    std::sort(order.begin(), order.end(), [&headers](int a, int b) { return headers[a].first < headers[b].first; });
+    uint64_t covered = 0;
+    for (int itc : order)
+    {
+        if (headers[itc].first != covered)
+        {
+            fprintf(stderr, "refpropBatch: points %llu to %llu are %s\n", (unsigned long long)std::min(covered,
+                    headers[itc].first), (unsigned long long)std::max(covered, headers[itc].first),
+                    (headers[itc].first > covered) ? "missing" : "in more than one chunk");
+            return 1;
+        }
+        covered += headers[itc].count;
+    } // end loop over chunks in point order
+    if (covered != numPoints)
+    {
+        fprintf(stderr, "refpropBatch: points %llu to %llu are missing\n", (unsigned long long)covered,
+                (unsigned long long)numPoints);
+        return 1;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // the layout of readFluidPropertyStream.m with the whole grid as one   //
+    // completed tile, and each chunk's block of a property copied into the //
+    // contiguous range of that property's page                             //
+    //////////////////////////////////////////////////////////////////////////
+    FILE *output = fopen(outputFile, "wb");
+    if (output == NULL)
+    {
+        perror(outputFile);
+        return 1;
+    }
+    size_t   fixedBytes  = 8 + 4 + 4 + (6 * 8) + 4;
+    uint32_t headerBytes = uint32_t(8 * ((fixedBytes + metaText.size() + 7) / 8));
+    uint32_t version     = 1;
+    uint32_t metaBytes   = uint32_t(metaText.size());
+    uint64_t sizes[6]    = {numRows, numCols, numProp, numRows, numCols, 1};
+    std::vector<char> padding(headerBytes - fixedBytes - metaBytes, 0);
+    bool written = (fwrite(streamMagic, 1, 8, output) == 8) && (fwrite(&headerBytes, 4, 1, output) == 1) &&
+                   (fwrite(&version, 4, 1, output) == 1) && (fwrite(sizes, 8, 6, output) == 6) &&
+                   (fwrite(&metaBytes, 4, 1, output) == 1) &&
+                   (fwrite(metaText.data(), 1, metaBytes, output) == metaBytes) &&
+                   (fwrite(padding.data(), 1, padding.size(), output) == padding.size());
+
+    std::vector<double> block;
+    for (int itc = 0; written && (itc < numChunks); itc++)
+    {
+        FILE *chunk = fopen(chunkFiles[itc], "rb");
+        written     = (chunk != NULL) && (fseeko(chunk, off_t(shardHeaderBytes), SEEK_SET) == 0);
+        for (uint64_t itp = 0; written && (itp < numProp); itp++)
+        {
+            for (uint64_t blockStart = 0; written && (blockStart < headers[itc].count); blockStart += pointsPerBlock)
+            {
+                size_t blockSize = size_t(std::min(uint64_t(pointsPerBlock), headers[itc].count - blockStart));
+                off_t  offset    = off_t(headerBytes + 8 * (itp * numPoints + headers[itc].first + blockStart));
+                block.resize(blockSize);
+                written = (fread(block.data(), 8, blockSize, chunk) == blockSize) &&
+                          (fseeko(output, offset, SEEK_SET) == 0) &&
+                          (fwrite(block.data(), 8, blockSize, output) == blockSize);
+            } // end loop over blocks
+        } // end loop over requested properties
+        if (chunk != NULL)
+        {
+            fclose(chunk);
+        }
+    } // end loop over chunks
+    written = (fclose(output) == 0) && written;
+    if (!written)
+    {
+        fprintf(stderr, "refpropBatch: cannot merge the chunks into %s\n", outputFile);
+        remove(outputFile);
+        return 1;
+    }
+    return 0;
+} // end function mergeShards
+
+int main(int argc, char *argv[])
+{
+    bool isRun   = (argc == 6) && (strcmp(argv[1], "run") == 0);
+    bool isMerge = (argc >= 5) && (strcmp(argv[1], "merge") == 0);
+    if (!isRun && !isMerge)
+    {
+        fprintf(stderr, "usage: refpropBatch run jobFile shardIndex numShards chunkFile\n"
+                        "       refpropBatch merge jobFile outputFile chunkFile...\n");
+        return 2;
+    }
+
+    BatchJob job;
+    if (!readJob(argv[2], job))
+    {
+        return 2;
+    }
+    if (isMerge)
+    {
+        return mergeShards(job, argv[3], argc - 4, argv + 4);
+    }
+
+    long long shardIndex = atoll(argv[3]);
+    long long numShards  = atoll(argv[4]);
+    if ((numShards < 1) || (shardIndex < 0) || (shardIndex >= numShards))
+    {
+        fprintf(stderr, "refpropBatch: shardIndex must be between 0 and numShards - 1\n");
+        return 2;
+    }
+    return runShard(job, size_t(shardIndex), size_t(numShards), argv[5]);
+} // end function main
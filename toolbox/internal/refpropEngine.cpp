@@ -0,0 +1,1045 @@
+/*=============================================================================================*
+ *  refpropEngine.cpp - REFPROP evaluation engine behind the C interface of refpropEngine.h.   *
+ *                      Loads REFPROP, sets the fluid and units and evaluates batches of       *
+ *                      state points without any MATLAB types, so it builds without MATLAB:    *
+ *                                                                                             *
+ *       c++ -O2 -std=c++17 -fPIC -shared -Iinclude refpropEngine.cpp -ldl \                   *
+ *           -o librefpropEngine.so                                                            *
+ *                                                                                             *
+ *  hiLevelMexC is compiled with this file and only converts between mxArrays and the engine.  *
+ *=============================================================================================*/
+
+// Copyright 2026 The MathWorks, Inc.
+
+#define REFPROP_IMPLEMENTATION
+#define REFPROP_FUNCTION_MODIFIER
+#undef UNICODE
+#include "REFPROP_lib.h"
+#undef REFPROP_FUNCTION_MODIFIER
+#undef REFPROP_IMPLEMENTATION
+#include "refpropMexHelpers.h"
+#include "refpropEngine.h"
+#include "sharedResultCache.h"
+
+#include <map>
+#include <string>
+#include <ctype.h>
+#include <stdio.h>
+#include <math.h>
+
+static const size_t maxEngineDims   = 32;    // most output dimensions rpeEvaluateExpanded accepts
+static const size_t recordsPerCheck = 256;   // records rpeEvaluateRecords evaluates between interrupt checks
+
+struct rpeSession
+{
+    std::string fluid;                      // hFld, empty until rpeSetFluid succeeds
+    std::string units;                      // unit system name, for error messages
+    double      z[20];                      // composition, filled from the .MIX file for predefined mixtures
+    int         iMass        = 0;           // 0 -> molar, 1 -> mass composition
+    int         mixFlag      = 0;           // 1 for mixtures
+    int         mixKind      = 0;           // 0 -> pure, 1 -> listed mixture, 2 -> .MIX file
+    int         numComp      = 0;           // components of the fluid, 0 until rpeSetFluid succeeds
+    int         iUnits       = -1;          // enum of the unit system from GETENUMdll, -1 until set
+    int         model        = RPE_MODEL_EXACT;   // rpeModel used by the evaluations
+    bool        debugOut     = false;       // print every point to stdout
+    bool        domainCheck  = false;       // reject points outside the EOS limits or below the melting line
+    bool        leverRule    = false;       // resolve two-phase points of a pure fluid from its saturation states
+    bool        limitsKnown  = false;       // tMin, tMax, pMax, dMax and pTrp have been read for the fluid and units
+    double      tMin, tMax, pMax, dMax;     // limits of the equation of state in the session units
+    double      pTrp;                       // triple-point pressure, -INFINITY when REFPROP gives none
+    double     *phaseQ  = NULL;             // vapor quality of each point, when requested
+    double     *phaseX  = NULL;             // liquid composition of each point, when requested
+    double     *phaseY  = NULL;             // vapor composition of each point, when requested
+    double     *phaseX3 = NULL;             // second liquid composition of each point, when requested
+    int       (*isInterrupted)(void *) = NULL;
+    void       *interruptContext       = NULL;
+    SharedResultCache *sharedCache     = NULL;   // results shared with other processes, when opened
+    size_t      numEvaluated = 0;
+    size_t      numFailed    = 0;
+    size_t      numSkipped   = 0;
+    size_t      numCacheHits = 0;
+    size_t      numLeverRule = 0;
+    std::string lastError;
+};
+
+static size_t      numOpenSessions = 0;   // sessions sharing the loaded REFPROP
+static std::string loadedPath;            // directory REFPROP was loaded from
+static std::string openError;             // why the last rpeOpen failed, rpeLastError of a NULL session
+static std::map<std::string, int> unitEnums;   // GETENUMdll result by REFPROP directory and unit system name
+
+static int setError(rpeSession *session, int status, const std::string &message)
+{
+    session->lastError = message;
+    return status;
+} // end function setError
+
+rpeSession *rpeOpen(const char *refpropPath, int *status)
+{
+    int         localStatus;
+    int        &result = (status != NULL) ? *status : localStatus;
+    std::string serr;
+    if (refpropPath == NULL)
+    {
+        openError = "The REFPROP path is NULL.";
+        result    = RPE_ERR_ARGUMENT;
+        return NULL;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // REFPROP is one instance per process, so every session shares its path //
+    ///////////////////////////////////////////////////////////////////////////
+    std::string path(refpropPath);
+    if (numOpenSessions == 0)
+    {
+#if defined(_WIN32)
+        std::string DLL_name = "REFPRP64.DLL";     // Refprop dll used on Windows
+#else
+        std::string DLL_name = "";                 // librefprop.so or librefprop.dylib
+#endif
+        if (!load_REFPROP(serr, path, DLL_name))
+        {
+            openError = "REFPROP failed to load from " + path + ": " + serr;
+            result    = RPE_ERR_LOAD;
+            return NULL;
+        }
+        SETPATHdll(const_cast<char *>(path.c_str()), 255);
+        loadedPath = path;
+    }
+    else if (path != loadedPath)
+    {
+        openError = "REFPROP is already loaded from " + loadedPath + ", not " + path + ".";
+        result    = RPE_ERR_LOAD;
+        return NULL;
+    } // end if first session, else if another REFPROP directory
+
+    numOpenSessions++;
+    result = RPE_OK;
+    return new rpeSession();
+} // end function rpeOpen
+
+void rpeClose(rpeSession *session)
+{
+    std::string serr;
+    if (session == NULL)
+    {
+        return;
+    }
+    closeSharedCache(session->sharedCache);
+    delete session;
+    numOpenSessions--;
+    if (numOpenSessions == 0)
+    {
+        unload_REFPROP(serr);
+        loadedPath.clear();
+    }
+} // end function rpeClose
+
+int rpeSetFluid(rpeSession *session, const char *fluid, const double *z, int iMass)
+{
+    int ierr = 0;   // OUTPUT: error flag -> 0 = successful, !0 = unsuccessful
+    if ((session == NULL) || (fluid == NULL) || (z == NULL))
+    {
+        return RPE_ERR_ARGUMENT;
+    }
+    if (strlen(fluid) >= size_t(hFld_length))
+    {
+        return setError(session, RPE_ERR_ARGUMENT, "The fluid string is longer than REFPROP accepts.");
+    }
+
+    std::copy(z, z + 20, session->z);
+    setRefpropFluid(fluid, session->z, session->mixFlag, ierr);
+    if (ierr != 0)
+    {
+        session->fluid.clear();
+        return setError(session, RPE_ERR_FLUID, "Fluid " + std::string(fluid) + " failed to set: Error " + std::to_string(ierr));
+    }
+    session->fluid       = fluid;
+    session->iMass       = iMass;
+    session->limitsKnown = false;
+    session->numComp     = 0;
+    while ((session->numComp < 20) && (session->z[session->numComp] > 0.000000001))
+    {
+        session->numComp++;
+    } // end loop over the nonzero species fractions
+    session->mixKind = isMixFile(fluid) ? 2 : session->mixFlag;
+    return RPE_OK;
+} // end function rpeSetFluid
+
+int rpeSetUnits(rpeSession *session, const char *units)
+{
+    int  ierr   = 0;                // OUTPUT: error flag -> 0 = successful, !0 = unsuccessful
+    int  iFlag  = 0;                // INPUT:  GETENUMdll checks all possible strings
+    char hEnum[hUnits_length];      // INPUT:  unit system name
+    char herr [herr_length];        // OUTPUT: Error string
+    if ((session == NULL) || (units == NULL))
+    {
+        return RPE_ERR_ARGUMENT;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    // the enum of a unit system only depends on the REFPROP directory, so it   //
+    // is kept for the life of the process. GETENUMdll then runs once per name  //
+    // even when callers such as hiLevelMexC open a session for every call      //
+    //////////////////////////////////////////////////////////////////////////////
+    std::string unitKey = loadedPath + '\n' + units;
+    std::map<std::string, int>::const_iterator known = unitEnums.find(unitKey);
+    if (known != unitEnums.end())
+    {
+        session->iUnits      = known->second;
+        session->units       = units;
+        session->limitsKnown = false;
+        return RPE_OK;
+    }
+
+    strncpy(hEnum, units, sizeof(hEnum) - 1);  hEnum[sizeof(hEnum) - 1] = '\0';
+    GETENUMdll(iFlag, hEnum, session->iUnits, ierr, herr, hUnits_length, herr_length);
+    if (ierr != 0)
+    {
+        session->iUnits = -1;
+        return setError(session, RPE_ERR_UNITS, "Converting " + std::string(units) + " to enum failed: Error "
+                                                + std::to_string(ierr) + " -> " + std::string(herr));
+    }
+    session->units       = units;
+    session->limitsKnown = false;
+    unitEnums[unitKey]   = session->iUnits;
+    return RPE_OK;
+} // end function rpeSetUnits
+
+int rpeMixtureKind(const rpeSession *session)
+{
+    return (session != NULL) ? session->mixKind : 0;
+} // end function rpeMixtureKind
+
+int rpeNumComponents(const rpeSession *session)
+{
+    return (session != NULL) ? session->numComp : 0;
+} // end function rpeNumComponents
+
+int rpeSetModel(rpeSession *session, int model)
+{
+    if ((session == NULL) || ((model != RPE_MODEL_EXACT) && (model != RPE_MODEL_FAST)))
+    {
+        return RPE_ERR_ARGUMENT;
+    }
+    session->model       = model;
+    session->limitsKnown = false;   // the limits are those of the model
+    return RPE_OK;
+} // end function rpeSetModel
+
+int rpeGetModel(const rpeSession *session)
+{
+    return (session != NULL) ? session->model : RPE_MODEL_EXACT;
+} // end function rpeGetModel
+
+//////////////////////////////////////////////////////////////////////////////////////
+// switches REFPROP to Peng-Robinson for the fast model and back to the default     //
+// models when the evaluation returns. PREOSdll applies to the loaded fluid, so the //
+// fluid of the session is set first in case another session has changed it         //
+//////////////////////////////////////////////////////////////////////////////////////
+class ModelScope
+{
+public:
+    explicit ModelScope(rpeSession *session) : active(false)
+    {
+        int    ierr = 0;
+        int    mixFlag;
+        double z[20];
+        if (session->model != RPE_MODEL_FAST)
+        {
+            return;
+        }
+        std::copy(session->z, session->z + 20, z);
+        setRefpropFluid(session->fluid.c_str(), z, mixFlag, ierr);
+        if (ierr == 0)
+        {
+            int iPREOS = 2;   // Peng-Robinson for all calculations
+            PREOSdll(iPREOS);
+            active = true;
+        }
+    }
+    ~ModelScope()
+    {
+        if (active)
+        {
+            int iPREOS = 0;   // back to the default models
+            PREOSdll(iPREOS);
+        }
+    }
+    bool failed(const rpeSession *session) const
+    {
+        return (session->model == RPE_MODEL_FAST) && !active;
+    }
+
+private:
+    bool active;
+};
+
+void rpeSetDebug(rpeSession *session, int debugOut)
+{
+    if (session != NULL)
+    {
+        session->debugOut = (debugOut != 0);
+    }
+} // end function rpeSetDebug
+
+void rpeSetInterruptCheck(rpeSession *session, int (*isInterrupted)(void *context), void *context)
+{
+    if (session != NULL)
+    {
+        session->isInterrupted    = isInterrupted;
+        session->interruptContext = context;
+    }
+} // end function rpeSetInterruptCheck
+
+void rpeSetDomainCheck(rpeSession *session, int domainCheck)
+{
+    if (session != NULL)
+    {
+        session->domainCheck = (domainCheck != 0);
+    }
+} // end function rpeSetDomainCheck
+
+void rpeSetLeverRule(rpeSession *session, int leverRule)
+{
+    if (session != NULL)
+    {
+        session->leverRule = (leverRule != 0);
+    }
+} // end function rpeSetLeverRule
+
+void rpeSetPhaseOutput(rpeSession *session, double *q, double *x, double *y, double *x3)
+{
+    if (session != NULL)
+    {
+        session->phaseQ  = q;
+        session->phaseX  = x;
+        session->phaseY  = y;
+        session->phaseX3 = x3;
+    }
+} // end function rpeSetPhaseOutput
+
+int rpeSetSharedCache(rpeSession *session, const char *name, size_t numEntries)
+{
+    std::string msg;
+    if (session == NULL)
+    {
+        return RPE_ERR_ARGUMENT;
+    }
+    closeSharedCache(session->sharedCache);
+    session->sharedCache = NULL;
+    if ((name == NULL) || (name[0] == '\0'))
+    {
+        return RPE_OK;
+    }
+    session->sharedCache = openSharedCache(name, numEntries, msg);
+    return (session->sharedCache != NULL) ? RPE_OK : setError(session, RPE_ERR_CACHE, msg);
+} // end function rpeSetSharedCache
+
+//////////////////////////////////////////////////////////////////////////////////////
+// the two hashes that identify everything but the inputs of a shared cache entry,  //
+// including the REFPROP directory so two REFPROP versions never share results      //
+//////////////////////////////////////////////////////////////////////////////////////
+static void sharedCacheQuery(const rpeSession *session, const char *propReq, const char *spec, uint64_t &key,
+                             uint64_t &check)
+{
+    std::string query = loadedPath + '\n' + session->fluid + '\n' + std::to_string(session->iUnits) + '\n'
+                        + std::to_string(session->iMass) + '\n' + std::to_string(session->model) + '\n' + propReq
+                        + '\n' + spec + '\n';
+    query.append(reinterpret_cast<const char *>(session->z), sizeof(session->z));
+    key   = sharedCacheHash(query.data(), query.size(), 0xcbf29ce484222325ULL);
+    check = sharedCacheHash(query.data(), query.size(), 0x84222325cbf29ce4ULL);
+} // end function sharedCacheQuery
+
+/////////////////////////////////////////////////////////////////////////////////
+// store q, x, y and x3 of point index into the buffers of rpeSetPhaseOutput,  //
+// NaN when the point was not evaluated or failed                              //
+/////////////////////////////////////////////////////////////////////////////////
+static void storePhase(const rpeSession *session, size_t index, size_t numPoints, bool valid, double q,
+                       const double *x, const double *y, const double *x3)
+{
+    if (session->phaseQ != NULL)
+    {
+        session->phaseQ[index] = valid ? q : NAN;
+    }
+    for (int itc = 0; itc < session->numComp; itc++)
+    {
+        size_t at = size_t(itc) * numPoints + index;
+        if (session->phaseX != NULL)
+        {
+            session->phaseX[at]  = valid ? x[itc] : NAN;
+        }
+        if (session->phaseY != NULL)
+        {
+            session->phaseY[at]  = valid ? y[itc] : NAN;
+        }
+        if (session->phaseX3 != NULL)
+        {
+            session->phaseX3[at] = valid ? x3[itc] : NAN;
+        }
+    } // end loop over components
+} // end function storePhase
+
+//////////////////////////////////////////////////////////////////////////////////////
+// the two input properties of a plain pair such as "TP", "PH" or "ST<", else false //
+// for flags and melting or sublimation specs like "CRIT" or "TMELT"                //
+//////////////////////////////////////////////////////////////////////////////////////
+static bool plainPair(const char *spec, char &first, char &second)
+{
+    const char *letters = "TPDEHSQ";
+    size_t      len     = strlen(spec);
+    if ((len < 2) || (len > 3) || (strchr(letters, toupper(spec[0])) == NULL) ||
+        (strchr(letters, toupper(spec[1])) == NULL) || ((len == 3) && (strchr("L<>V", toupper(spec[2])) == NULL)))
+    {
+        return false;
+    }
+    first  = char(toupper(spec[0]));
+    second = char(toupper(spec[1]));
+    return true;
+} // end function plainPair
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// read the limits of the equation of state and the triple-point pressure in the       //
+// session units once per fluid and unit system. A fluid REFPROP gives no limits for   //
+// is not range checked, and one without a triple point, such as a mixture, has no     //
+// lower pressure bound but zero                                                       //
+/////////////////////////////////////////////////////////////////////////////////////////
+static void loadLimits(rpeSession *session, char *hFld, double *z)
+{
+    int    ierr;
+    int    iUCode;
+    double hOutput[200];
+    double q;
+    double x[20], y[20], x3[20];
+    double a = 0.0;
+    double b = 0.0;
+    char   hIn   [hIn_length]  = "";                     // fixed properties need no inputs
+    char   hOut  [hOut_length] = "TMIN;TMAX;PMAX;DMAX";
+    char   hUnits[hUnits_length];
+    char   herr  [herr_length];
+
+    REFPROPdll(hFld, hIn, hOut, session->iUnits, session->iMass, session->mixFlag, a, b, z, hOutput, hUnits, iUCode,
+               x, y, x3, q, ierr, herr, hFld_length, hIn_length, hOut_length, hUnits_length, herr_length);
+    if (ierr == 0)
+    {
+        session->tMin = hOutput[0];
+        session->tMax = hOutput[1];
+        session->pMax = hOutput[2];
+        session->dMax = hOutput[3];
+    }
+    else
+    {
+        session->tMin = -INFINITY;
+        session->tMax =  INFINITY;
+        session->pMax =  INFINITY;
+        session->dMax =  INFINITY;
+    } // end if REFPROP gave the limits, else do not range check
+
+    strncpy(hOut, "PTRP", sizeof(hOut));
+    REFPROPdll(hFld, hIn, hOut, session->iUnits, session->iMass, session->mixFlag, a, b, z, hOutput, hUnits, iUCode,
+               x, y, x3, q, ierr, herr, hFld_length, hIn_length, hOut_length, hUnits_length, herr_length);
+    session->pTrp        = (ierr == 0) ? hOutput[0] : -INFINITY;
+    session->limitsKnown = true;
+} // end function loadLimits
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// the melting or sublimation line value at each pressure checked, so every point of a //
+// grid at one pressure costs one line evaluation rather than one per point, whichever //
+// grid dimension the pressure varies along                                            //
+/////////////////////////////////////////////////////////////////////////////////////////
+struct MeltCache
+{
+    std::map<double, double> values;   // by pressure, -INFINITY when the fluid has no such line there
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+// rpePointStatus of the point a, b of a plain pair: RPE_POINT_OUT_OF_RANGE outside  //
+// the limits of the equation of state, at a negative P or D, or at a saturation P   //
+// below the triple point, RPE_POINT_SOLID when the T, H or S given with P is below  //
+// its value on the melting line at that P, or on the sublimation line below the     //
+// triple-point pressure, else RPE_POINT_OK                                          //
+///////////////////////////////////////////////////////////////////////////////////////
+static int domainStatus(rpeSession *session, char first, char second, double a, double b, double *z,
+                        MeltCache &melt)
+{
+    const char   names [2] = {first, second};
+    const double values[2] = {a, b};
+    for (int itv = 0; itv < 2; itv++)
+    {
+        if (((names[itv] == 'T') && ((values[itv] < session->tMin) || (values[itv] > session->tMax))) ||
+            ((names[itv] == 'P') && ((values[itv] < 0.0) || (values[itv] > session->pMax))) ||
+            ((names[itv] == 'D') && ((values[itv] < 0.0) || (values[itv] > session->dMax))))
+        {
+            return RPE_POINT_OUT_OF_RANGE;
+        }
+    } // end loop over the two inputs
+
+    int pIdx = (first == 'P') ? 0 : ((second == 'P') ? 1 : -1);
+    if ((pIdx >= 0) && (names[1 - pIdx] == 'Q') && (values[pIdx] < session->pTrp))
+    {
+        return RPE_POINT_OUT_OF_RANGE;   // there is no liquid below the triple-point pressure
+    }
+    if ((pIdx < 0) || (strchr("THS", names[1 - pIdx]) == NULL))
+    {
+        return RPE_POINT_OK;
+    }
+    auto found = melt.values.find(values[pIdx]);
+    if (found == melt.values.end())
+    {
+        int    ierr;
+        int    iUCode;
+        double hOutput[200];
+        double q;
+        double x[20], y[20], x3[20];
+        double p = values[pIdx];
+        double b = 0.0;
+        char   hFld  [hFld_length] = " ";               // the fluid is already set
+        char   hIn   [hIn_length]  = "PMELT";           // the melting line at the given pressure
+        if (p < session->pTrp)
+        {
+            strncpy(hIn, "PSUBL", sizeof(hIn));         // the sublimation line below the triple point
+        }
+        char   hOut  [hOut_length] = {names[1 - pIdx], '\0'};
+        char   hUnits[hUnits_length];
+        char   herr  [herr_length];
+
+        REFPROPdll(hFld, hIn, hOut, session->iUnits, session->iMass, session->mixFlag, p, b, z, hOutput, hUnits,
+                   iUCode, x, y, x3, q, ierr, herr, hFld_length, hIn_length, hOut_length, hUnits_length, herr_length);
+        found = melt.values.emplace(p, (ierr == 0) ? hOutput[0] : -INFINITY).first;
+    } // end if the melting or sublimation line is not known at this pressure
+    return (values[1 - pIdx] < found->second) ? RPE_POINT_SOLID : RPE_POINT_OK;
+} // end function domainStatus
+
+/////////////////////////////////////////////////////////////////////////////
+// print one evaluated point with the phase compositions, as hiLevelMexC's //
+// DebugOut has always done                                                //
+/////////////////////////////////////////////////////////////////////////////
+static void printPoint(const rpeSession *session, size_t index, int ierr, const char *herr, const char *hIn,
+                       double a, double b, const char *hOut, double value, const char *hUnits,
+                       const double *z, const double *x, const double *y, const double *x3)
+{
+    printf("\n************************************\nValue %zu \nError             = (%d) %s\nFluid(s)          = %s\nInput properties  = %s = (%f, %f)\nOutput properties = %s\nOutput values     = %lf %s \n", index+1, ierr, herr, session->fluid.c_str(), hIn, a, b, hOut, value, hUnits);
+
+    std::string parsed(session->fluid);
+    size_t      bgn    = 0;
+    size_t      nnd    = 0;
+    size_t      itrcmp = 0;
+    while (    (itrcmp    <  20)
+            && (z[itrcmp]  > 0.000000001))
+    {
+        nnd = parsed.find(";", bgn);
+
+        printf("\nFor: %s\n", parsed.substr(bgn, nnd).c_str());
+        printf("Liquid Phase Comp = %f\n", x[itrcmp]);
+        printf("Vapor  Phase Comp = %f\n", y[itrcmp]);
+        if(x3[itrcmp] > 0.000000001)
+        {
+            printf("2nd Liquid Phase  = %f\n", x3[itrcmp]);
+        }
+
+        bgn = nnd + 1;
+        itrcmp++;
+    } // end loop over Fluid Composition
+} // end function printPoint
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// the saturated liquid and vapor states of a pure fluid at one P or T, computed once  //
+// for every point of an evaluation at that P or T                                     //
+/////////////////////////////////////////////////////////////////////////////////////////
+struct SaturationEnds
+{
+    bool   valid = false;
+    double liquid[6];                       // T, P, D, E, H, S of the saturated liquid
+    double vapor [6];                       // T, P, D, E, H, S of the saturated vapor
+};
+
+struct LeverRule
+{
+    char   row;                             // 'P' or 'T', the input the saturation states are found at
+    char   across;                          // the other input, that locates the point between them
+    char   prop;                            // the requested property
+    bool   rowFirst;                        // whether row is the first input of spec
+    std::map<double, SaturationEnds> ends;  // saturation states by row value
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// whether the points of spec and propReq can be resolved by the lever rule: a pair of //
+// P with D, E, H, S or Q, or of T with D or Q, in either order, and a requested       //
+// property that is linear in the quality (E, H, S, Q and the constant T and P) or in  //
+// the specific volume (D). T with E, H or S is left to REFPROP, as a liquid           //
+// compressed at that T can have the same E or H as a two-phase state, and the same S  //
+// where the liquid contracts on heating, as water does below 4 C                      //
+/////////////////////////////////////////////////////////////////////////////////////////
+static bool leverRuleQuery(const char *propReq, const char *spec, LeverRule &lever)
+{
+    const char *saturated = "TPDEHSQ";
+    if ((strlen(spec) != 2) || (strlen(propReq) != 1) || (strchr(saturated, toupper(propReq[0])) == NULL))
+    {
+        return false;
+    }
+    lever.prop     = char(toupper(propReq[0]));
+    lever.rowFirst = (toupper(spec[0]) == 'P') || ((toupper(spec[0]) == 'T') && (toupper(spec[1]) != 'P'));
+    lever.row      = char(toupper(spec[lever.rowFirst ? 0 : 1]));
+    lever.across   = char(toupper(spec[lever.rowFirst ? 1 : 0]));
+    return ((lever.row == 'P') && (strchr("DEHSQ", lever.across) != NULL)) ||
+           ((lever.row == 'T') && (strchr("DQ",    lever.across) != NULL));
+} // end function leverRuleQuery
+
+static void saturationEnds(rpeSession *session, char row, double rowValue, char *hFld, double *z,
+                           SaturationEnds &ends)
+{
+    int    ierr;
+    int    iUCode;
+    double hOutput[200];
+    double q;
+    double x[20], y[20], x3[20];
+    double a;
+    double b;
+    char   hIn   [hIn_length]  = {row, 'Q', '\0'};
+    char   hOut  [hOut_length] = "T;P;D;E;H;S";
+    char   hUnits[hUnits_length];
+    char   herr  [herr_length];
+
+    ends.valid = true;
+    for (int side = 0; side < 2; side++)
+    {
+        a = rowValue;
+        b = double(side);
+        REFPROPdll(hFld, hIn, hOut, session->iUnits, session->iMass, session->mixFlag, a, b, z, hOutput, hUnits,
+                   iUCode, x, y, x3, q, ierr, herr, hFld_length, hIn_length, hOut_length, hUnits_length,
+                   herr_length);
+        strncpy(hFld, " ", 2);
+        ends.valid = ends.valid && (ierr == 0);
+        std::copy(hOutput, hOutput + 6, (side == 0) ? ends.liquid : ends.vapor);
+    } // end loop over the liquid and vapor sides
+} // end function saturationEnds
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// the requested property of the point a, b when it is strictly between the saturated  //
+// liquid and vapor at its P or T, interpolated in the quality; false for any other    //
+// point, which REFPROP then evaluates                                                 //
+/////////////////////////////////////////////////////////////////////////////////////////
+static bool leverRuleValue(rpeSession *session, LeverRule &lever, double a, double b, char *hFld, double *z,
+                           double &value)
+{
+    const char *saturated   = "TPDEHS";
+    double      rowValue    = lever.rowFirst ? a : b;
+    double      acrossValue = lever.rowFirst ? b : a;
+    if (isnan(rowValue) || isnan(acrossValue))
+    {
+        return false;
+    }
+    auto found = lever.ends.find(rowValue);
+    if (found == lever.ends.end())
+    {
+        found = lever.ends.emplace(rowValue, SaturationEnds()).first;
+        saturationEnds(session, lever.row, rowValue, hFld, z, found->second);
+    }
+    const SaturationEnds &ends = found->second;
+    if (!ends.valid)
+    {
+        return false;
+    }
+
+    double q;                               // quality from the lever rule, on the one basis of a pure fluid
+    if (lever.across == 'Q')
+    {
+        q = acrossValue;
+    }
+    else if (lever.across == 'D')
+    {
+        q = (1.0 / acrossValue - 1.0 / ends.liquid[2]) / (1.0 / ends.vapor[2] - 1.0 / ends.liquid[2]);
+    }
+    else
+    {
+        int at = int(strchr(saturated, lever.across) - saturated);
+        q = (acrossValue - ends.liquid[at]) / (ends.vapor[at] - ends.liquid[at]);
+    } // end if quality given, else if density, else an extensive property
+    if (!((q > 0.0) && (q < 1.0)))
+    {
+        return false;
+    }
+
+    if (lever.prop == 'Q')
+    {
+        value = q;
+    }
+    else if (lever.prop == 'D')
+    {
+        value = 1.0 / ((1.0 - q) / ends.liquid[2] + q / ends.vapor[2]);
+    }
+    else
+    {
+        int at = int(strchr(saturated, lever.prop) - saturated);
+        value = ends.liquid[at] + q * (ends.vapor[at] - ends.liquid[at]);
+    } // end if quality, else if density, else linear in the quality
+    return true;
+} // end function leverRuleValue
+
+int rpeEvaluateExpandedMasked(rpeSession *session, const char *propReq, const char *spec, size_t numDims,
+                              const size_t *outDims, const double *value1, const size_t *stride1,
+                              const double *value2, const size_t *stride2, const unsigned char *mask,
+                              double *output, int *pointStatus)
+{
+    if ((session == NULL) || (propReq == NULL) || (spec == NULL) || (outDims == NULL) || (stride1 == NULL) ||
+        (stride2 == NULL) || (output == NULL) || (numDims == 0))
+    {
+        return RPE_ERR_ARGUMENT;
+    }
+    session->numEvaluated = 0;
+    session->numFailed    = 0;
+    session->numSkipped   = 0;
+    session->numCacheHits = 0;
+    session->numLeverRule = 0;
+    session->lastError.clear();
+    if (session->fluid.empty() || (session->iUnits < 0))
+    {
+        return setError(session, RPE_ERR_NOT_READY, "Set the fluid and units of the session before evaluating.");
+    }
+    if ((numDims > maxEngineDims) || (strlen(propReq) >= size_t(hOut_length)) || (strlen(spec) >= size_t(hIn_length)))
+    {
+        return setError(session, RPE_ERR_ARGUMENT, "Too many dimensions, or propReq or spec is longer than REFPROP accepts.");
+    }
+
+    size_t numelOut = 1;                         // number of values in the output
+    for (size_t itd = 0; itd < numDims; itd++)
+    {
+        numelOut *= outDims[itd];
+    } // end loop over output dimensions
+
+    ///////////////////////////
+    // Setup local variables //
+    ///////////////////////////
+    size_t idx1          =     0;               // index into value1 of the current output value
+    size_t idx2          =     0;               // index into value2 of the current output value
+    size_t sub[maxEngineDims] = {0};            // subscripts of the current output value
+    int    ierr;                                // OUTPUT: error flag -> 0 = successful, !0 = unsuccessful
+    int    state;                               // rpePointStatus of the current output value
+    char   first         =     0;               // first  input property of spec when it is a plain pair
+    char   second        =     0;               // second input property of spec when it is a plain pair
+    bool   checkDomain;                         // whether points are checked against the domain of the EOS
+    MeltCache melt;                             // melting line value at each pressure checked
+    int    iUCode;                              // OUTPUT: Unit code representing the units of the first property in Output array
+    double a;                                   // INPUT:  First input property as specified by hIn
+    double b;                                   // INPUT:  Second input property as specified by hIn
+    double hOutput[200];                        // OUTPUT: Array of properties specified by hOut (should be size 200, double precision)
+    double q             =    1.0;              // OUTPUT: Vapor quality on a mole or mass basis (vapor -> 1, liquid -> 0)
+    double x [20]        =   {1.0};             // OUTPUT: Composition of liquid phase (array of mole fractions of size 20) for 2-phase states
+    double x3[20]        =   {0.0};             // OUTPUT: Reserved for returning composition of a second liquid phase for LLE or VLLE
+    double y [20]        =   {1.0};             // OUTPUT: Composition of vapor phase (array of mole fractions of size 20) for 2-phase states
+    double z [20];                              // INPUT:  Composition, REFPROPdll may not keep it constant
+    char   herr  [herr_length];                 // OUTPUT: Error string
+    char   hFld  [hFld_length];                 // INPUT:  Fluid string
+    char   hIn   [hIn_length];                  // INPUT:  Input string of properties sent to the routine
+    char   hOut  [hOut_length];                 // OUTPUT: Various flags to gain access to other features of Refprop
+    char   hUnits[hUnits_length];               // OUTPUT: Units for the first property in the output array
+
+    ModelScope modelScope(session);
+    if (modelScope.failed(session))
+    {
+        return setError(session, RPE_ERR_MODEL, "Switching " + session->fluid + " to the fast (Peng-Robinson) model failed.");
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // other sessions and mex files share the loaded REFPROP, so the first point //
+    // always names the fluid. REFPROP skips the setup when it is the fluid set  //
+    ///////////////////////////////////////////////////////////////////////////////
+    std::copy(session->z, session->z + 20, z);
+    strncpy(hFld, session->fluid.c_str(), sizeof(hFld) - 1);  hFld[sizeof(hFld) - 1] = '\0';
+    strncpy(hIn,  spec,                   sizeof(hIn)  - 1);  hIn [sizeof(hIn)  - 1] = '\0';
+    strncpy(hOut, propReq,                sizeof(hOut) - 1);  hOut[sizeof(hOut) - 1] = '\0';
+
+    checkDomain = session->domainCheck && plainPair(spec, first, second);
+    if (checkDomain && !session->limitsKnown)
+    {
+        loadLimits(session, hFld, z);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    // the shared cache only holds the value, so points that also print or return  //
+    // the phase compositions are always evaluated                                 //
+    /////////////////////////////////////////////////////////////////////////////////
+    bool     useCache = (session->sharedCache != NULL) && !session->debugOut && (session->phaseQ == NULL) &&
+                        (session->phaseX == NULL) && (session->phaseY == NULL) && (session->phaseX3 == NULL);
+    uint64_t cacheKey   = 0;                    // hashes of the query without its inputs, for the shared cache
+    uint64_t cacheCheck = 0;
+    double   cached;                            // value found in the shared cache
+    if (useCache)
+    {
+        sharedCacheQuery(session, propReq, spec, cacheKey, cacheCheck);
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    // two-phase points of a pure fluid from the saturation states at their P   //
+    // or T, which are found once per P or T rather than by a flash per point   //
+    //////////////////////////////////////////////////////////////////////////////
+    LeverRule lever;
+    bool      useLever = session->leverRule && (session->mixKind == 0) && (session->numComp == 1) &&
+                         !session->debugOut && (session->phaseQ == NULL) && (session->phaseX == NULL) &&
+                         (session->phaseY == NULL) && (session->phaseX3 == NULL) &&
+                         leverRuleQuery(propReq, spec, lever);
+    double    leverValue;                   // value of a point resolved by the lever rule
+
+    ////////////////////////////////////////////////////////////////////////
+    // loop over the output in column-major order, finding the value1 and //
+    // value2 entries of each output value from the strides               //
+    ////////////////////////////////////////////////////////////////////////
+    for (size_t itk = 0; itk < numelOut; itk++)
+    {
+        if ((itk > 0) && ((itk % outDims[0]) == 0) && (session->isInterrupted != NULL) &&
+            (session->isInterrupted(session->interruptContext) != 0))
+        {
+            return setError(session, RPE_ERR_INTERRUPTED, "Interrupted after " + std::to_string(itk) + " of "
+                                                          + std::to_string(numelOut) + " values.");
+        }
+
+        a = value1[idx1]; // set first spec entry
+        b = value2[idx2]; // set second spec entry
+
+        ///////////////////////////////////////////////////////////////////////////
+        // points outside the mask or the domain are NaN without calling REFPROP //
+        ///////////////////////////////////////////////////////////////////////////
+        state = RPE_POINT_OK;
+        if ((mask != NULL) && (mask[itk] == 0))
+        {
+            state = RPE_POINT_MASKED;
+        }
+        else if (checkDomain)
+        {
+            state = domainStatus(session, first, second, a, b, z, melt);
+        } // end if masked, else if checking the domain
+
+        if (state != RPE_POINT_OK)
+        {
+            output[itk] = NAN;
+            session->numSkipped++;
+            storePhase(session, itk, numelOut, false, q, x, y, x3);
+        }
+        else if (useLever && leverRuleValue(session, lever, a, b, hFld, z, leverValue))
+        {
+            output[itk] = leverValue;
+            session->numEvaluated++;
+            session->numLeverRule++;
+        }
+        else if (useCache && sharedCacheLookup(session->sharedCache, cacheKey, cacheCheck, a, b, cached))
+        {
+            output[itk] = cached;
+            session->numEvaluated++;
+            session->numCacheHits++;
+        }
+        else
+        {
+            //////////////////////
+            // Call RefProp dll //
+            //////////////////////
+            REFPROPdll(hFld, hIn, hOut, session->iUnits, session->iMass, session->mixFlag, a, b, z, hOutput, hUnits,
+                       iUCode, x, y, x3, q, ierr, herr, hFld_length, hIn_length, hOut_length, hUnits_length,
+                       herr_length);
+            if(ierr != 0)
+            {
+                session->numFailed++;
+                session->lastError = "Refprop call " + std::to_string(itk + 1) + " failed: " + session->units + " -> "
+                                     + std::to_string(ierr) + " " + std::string(herr);
+                hOutput[0] = NAN;
+                state      = RPE_POINT_FAILED;
+            }
+            output[itk] = hOutput[0];
+            session->numEvaluated++;
+            storePhase(session, itk, numelOut, ierr == 0, q, x, y, x3);
+            if (useCache && (ierr == 0))   // failed points are not shared
+            {
+                sharedCacheStore(session->sharedCache, cacheKey, cacheCheck, a, b, hOutput[0]);
+            }
+
+            if (session->debugOut)
+            {
+                printPoint(session, itk, ierr, herr, hIn, a, b, hOut, hOutput[0], hUnits, z, x, y, x3);
+            } // end if printing debug info
+
+            /////////////////////////////////////////////////////////////////////////////////////
+            // After the first iteration, we want to change the value of hFld from a string to //
+            // an empty string. This tells the function to continue with the previously loaded //
+            // dll rather than continuously reloading the dll related to the fluid name        //
+            /////////////////////////////////////////////////////////////////////////////////////
+            strncpy(hFld, " ", 2);
+        } // end if skipped, else if two-phase by the lever rule, else if cached, else evaluated
+        if (pointStatus != NULL)
+        {
+            pointStatus[itk] = state;
+        }
+
+        //////////////////////////////////////////////////////////////////////////
+        // step to the next output subscripts, carrying into the next dimension //
+        //////////////////////////////////////////////////////////////////////////
+        for (size_t itd = 0; itd < numDims; itd++)
+        {
+            sub[itd]++;
+            idx1 += stride1[itd];
+            idx2 += stride2[itd];
+            if (sub[itd] < outDims[itd])
+            {
+                break;
+            }
+            idx1    -= stride1[itd] * outDims[itd];
+            idx2    -= stride2[itd] * outDims[itd];
+            sub[itd] = 0;
+        } // end loop over dimensions
+    } // end loop over output values
+    if (session->debugOut)
+    {
+        printf("\n************************************\n");
+    } // end if printing debug info
+    return RPE_OK;
+} // end function rpeEvaluateExpandedMasked
+
+int rpeEvaluateExpanded(rpeSession *session, const char *propReq, const char *spec, size_t numDims,
+                        const size_t *outDims, const double *value1, const size_t *stride1,
+                        const double *value2, const size_t *stride2, double *output)
+{
+    return rpeEvaluateExpandedMasked(session, propReq, spec, numDims, outDims, value1, stride1, value2, stride2, NULL,
+                                     output, NULL);
+} // end function rpeEvaluateExpanded
+
+int rpeEvaluate(rpeSession *session, const char *propReq, const char *spec, size_t numPoints,
+                const double *value1, const double *value2, double *output)
+{
+    size_t unitStride = 1;
+    return rpeEvaluateExpanded(session, propReq, spec, 1, &numPoints, value1, &unitStride, value2, &unitStride, output);
+} // end function rpeEvaluate
+
+int rpeEvaluateRecords(rpeSession *session, size_t numRecords, const char *const *propReq,
+                       const char *const *spec, const double *value1, const double *value2,
+                       double *output, int *ierr)
+{
+    if ((session == NULL) || (propReq == NULL) || (spec == NULL) || (value1 == NULL) || (value2 == NULL) ||
+        (output == NULL))
+    {
+        return RPE_ERR_ARGUMENT;
+    }
+    session->numEvaluated = 0;
+    session->numFailed    = 0;
+    session->numSkipped   = 0;
+    session->numCacheHits = 0;
+    session->numLeverRule = 0;
+    session->lastError.clear();
+    if (session->fluid.empty() || (session->iUnits < 0))
+    {
+        return setError(session, RPE_ERR_NOT_READY, "Set the fluid and units of the session before evaluating.");
+    }
+    for (size_t itr = 0; itr < numRecords; itr++)
+    {
+        if ((propReq[itr] == NULL) || (spec[itr] == NULL) || (strlen(propReq[itr]) >= size_t(hOut_length)) ||
+            (strlen(spec[itr]) >= size_t(hIn_length)))
+        {
+            return setError(session, RPE_ERR_ARGUMENT, "The propReq or spec of record " + std::to_string(itr + 1)
+                                                       + " is missing or longer than REFPROP accepts.");
+        }
+    } // end loop over records
+
+    ///////////////////////////
+    // Setup local variables //
+    ///////////////////////////
+    int    ierrRecord;                          // OUTPUT: error flag -> 0 = successful, !0 = unsuccessful
+    int    iUCode;                              // OUTPUT: Unit code representing the units of the first property in Output array
+    double a;                                   // INPUT:  First input property as specified by hIn
+    double b;                                   // INPUT:  Second input property as specified by hIn
+    double hOutput[200];                        // OUTPUT: Array of properties specified by hOut (should be size 200, double precision)
+    double q             =    1.0;              // OUTPUT: Vapor quality on a mole or mass basis (vapor -> 1, liquid -> 0)
+    double x [20]        =   {1.0};             // OUTPUT: Composition of liquid phase (array of mole fractions of size 20) for 2-phase states
+    double x3[20]        =   {0.0};             // OUTPUT: Reserved for returning composition of a second liquid phase for LLE or VLLE
+    double y [20]        =   {1.0};             // OUTPUT: Composition of vapor phase (array of mole fractions of size 20) for 2-phase states
+    double z [20];                              // INPUT:  Composition, REFPROPdll may not keep it constant
+    char   herr  [herr_length];                 // OUTPUT: Error string
+    char   hFld  [hFld_length];                 // INPUT:  Fluid string
+    char   hIn   [hIn_length];                  // INPUT:  Input string of properties sent to the routine
+    char   hOut  [hOut_length];                 // OUTPUT: Various flags to gain access to other features of Refprop
+    char   hUnits[hUnits_length];               // OUTPUT: Units for the first property in the output array
+
+    ModelScope modelScope(session);
+    if (modelScope.failed(session))
+    {
+        return setError(session, RPE_ERR_MODEL, "Switching " + session->fluid + " to the fast (Peng-Robinson) model failed.");
+    }
+    std::copy(session->z, session->z + 20, z);
+    strncpy(hFld, session->fluid.c_str(), sizeof(hFld) - 1);  hFld[sizeof(hFld) - 1] = '\0';
+
+    //////////////////////////////////////////////////////////////////////////////////
+    // the records are evaluated in the order given. REFPROPdll parses hIn and hOut //
+    // on every call, so the fluid setup is the only work shared between records,   //
+    // and keeping the order lets a caller rely on it                               //
+    //////////////////////////////////////////////////////////////////////////////////
+    for (size_t itr = 0; itr < numRecords; itr++)
+    {
+        if ((itr > 0) && ((itr % recordsPerCheck) == 0) && (session->isInterrupted != NULL) &&
+            (session->isInterrupted(session->interruptContext) != 0))
+        {
+            return setError(session, RPE_ERR_INTERRUPTED, "Interrupted after " + std::to_string(itr) + " of "
+                                                          + std::to_string(numRecords) + " records.");
+        }
+
+        strncpy(hIn,  spec[itr],    sizeof(hIn)  - 1);  hIn [sizeof(hIn)  - 1] = '\0';
+        strncpy(hOut, propReq[itr], sizeof(hOut) - 1);  hOut[sizeof(hOut) - 1] = '\0';
+        a = value1[itr];
+        b = value2[itr];
+
+        REFPROPdll(hFld, hIn, hOut, session->iUnits, session->iMass, session->mixFlag, a, b, z,
+                   hOutput, hUnits, iUCode, x, y, x3, q, ierrRecord, herr, hFld_length, hIn_length, hOut_length,
+                   hUnits_length, herr_length);
+        if(ierrRecord != 0)
+        {
+            session->numFailed++;
+            session->lastError = "Record " + std::to_string(itr + 1) + " (" + std::string(spec[itr]) + " -> "
+                                 + std::string(propReq[itr]) + ") failed: " + std::to_string(ierrRecord) + " "
+                                 + std::string(herr);
+            hOutput[0] = NAN;
+        }
+        output[itr] = hOutput[0];
+        if (ierr != NULL)
+        {
+            ierr[itr] = ierrRecord;
+        }
+        session->numEvaluated++;
+        storePhase(session, itr, numRecords, ierrRecord == 0, q, x, y, x3);
+
+        if (session->debugOut)
+        {
+            printPoint(session, itr, ierrRecord, herr, hIn, a, b, hOut, hOutput[0], hUnits, z, x, y, x3);
+        } // end if printing debug info
+
+        strncpy(hFld, " ", 2);   // continue with the fluid set by the first record
+    } // end loop over records
+    if (session->debugOut)
+    {
+        printf("\n************************************\n");
+    } // end if printing debug info
+    return RPE_OK;
+} // end function rpeEvaluateRecords
+
+size_t rpeNumEvaluated(const rpeSession *session)
+{
+    return (session != NULL) ? session->numEvaluated : 0;
+} // end function rpeNumEvaluated
+
+size_t rpeNumFailed(const rpeSession *session)
+{
+    return (session != NULL) ? session->numFailed : 0;
+} // end function rpeNumFailed
+
+size_t rpeNumSkipped(const rpeSession *session)
+{
+    return (session != NULL) ? session->numSkipped : 0;
+} // end function rpeNumSkipped
+
+size_t rpeNumCacheHits(const rpeSession *session)
+{
+    return (session != NULL) ? session->numCacheHits : 0;
+} // end function rpeNumCacheHits
+
+size_t rpeNumLeverRule(const rpeSession *session)
+{
+    return (session != NULL) ? session->numLeverRule : 0;
+} // end function rpeNumLeverRule
+
+const char *rpeLastError(const rpeSession *session)
+{
+    return (session != NULL) ? session->lastError.c_str() : openError.c_str();
+} // end function rpeLastError
@@ -0,0 +1,379 @@
+/*=============================================================================================*
+ *  refpropServer.cpp - local property server that keeps REFPROP loaded for many MATLAB        *
+ *                      sessions on the same host (Linux and macOS).                           *
+ *                                                                                             *
+ *  From a shell (startPropertyServer.m does this for you):                                    *
+ *       refpropServer socketPath refpropPath [numWorkers] [cacheSize]                         *
+ *                                                                                             *
+ *  Where                                                                                      *
+ *    socketPath  = path of the Unix domain socket the clients connect to. The socket is only  *
+ *                  accessible to the user that started the server                             *
+ *    refpropPath = path to the Refprop directory holding the shared library                   *
+ *    numWorkers  = number of worker processes, each with its own REFPROP instance (default 4) *
+ *    cacheSize   = number of state points in the result cache all workers share               *
+ *                  (default 1000000, 0 disables the cache)                                    *
+ *                                                                                             *
+ *  REFPROP keeps its state in global memory, so the pool is one process per worker. Each      *
+ *  connection carries one request: a worker accepts it on the shared socket, answers it and   *
+ *  closes it, so any number of clients share the workers and none waits on a connection       *
+ *  another client holds open. The workers keep the last fluid and unit system set between     *
+ *  requests. The results are cached in a sharedResultCache.h segment the parent maps before   *
+ *  starting the workers, so a state point evaluated by one worker is a hit for all of them,   *
+ *  and a full cache replaces old entries one slot at a time. The parent process only          *
+ *  restarts a worker that exits, so a REFPROP crash costs one request rather than a MATLAB    *
+ *  session. The server writes its process id to socketPath.pid and stops on SIGTERM or        *
+ *  SIGINT.                                                                                    *
+ *=============================================================================================*/
+
+// Copyright 2026 The MathWorks, Inc.
+
+#define REFPROP_IMPLEMENTATION
+#define REFPROP_FUNCTION_MODIFIER
+#undef UNICODE
+#include "REFPROP_lib.h"
+#undef REFPROP_FUNCTION_MODIFIER
+#undef REFPROP_IMPLEMENTATION
+#include "refpropMexHelpers.h"
+#include "propertyServerProtocol.h"
+#include "sharedResultCache.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+static volatile sig_atomic_t stopRequested = 0;  // set by SIGTERM or SIGINT
+
+static void requestStop(int)
+{
+    stopRequested = 1;
+} // end function requestStop
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// REFPROP setup a worker keeps between requests, so a client that sends many requests //
+// for the same fluid and units pays for SETFLUIDSdll and GETENUMdll once              //
+/////////////////////////////////////////////////////////////////////////////////////////
+struct WorkerState
+{
+    std::string fluid;                                    // fluid currently set in REFPROP
+    std::vector<double> z;                                // composition it was set with
+    int mixFlag = 0;
+    bool fluidSent = false;                               // REFPROPdll has been called with the fluid string
+    std::unordered_map<std::string, int> unitEnums;       // GETENUMdll result for each unit string
+    SharedResultCache *cache = NULL;                      // results shared by all workers, NULL when disabled
+};
+
+///////////////////////////////////////////////////////////////////////////
+// send a response with a status message and no values, false on failure //
+///////////////////////////////////////////////////////////////////////////
+static bool sendStatus(int fd, int status, const std::string &msg)
+{
+    ServerResponse response = {serverMagic, status, uint32_t(msg.size()), 0, 0};
+    return sendAll(fd, &response, sizeof(response)) && sendAll(fd, msg.data(), msg.size());
+} // end function sendStatus
+
+////////////////////////////////////////////////////////////////////////////////////////
+// evaluate one request the same way hiLevelMexC does, the first output of propReq at //
+// every pair of values, NaN where REFPROP fails                                      //
+////////////////////////////////////////////////////////////////////////////////////////
+static bool serveRequest(int fd, const ServerRequest &request, WorkerState &state)
+{
+    std::string propReq(request.propReqLen, ' ');
+    std::string spec   (request.specLen,    ' ');
+    std::string fluid  (request.fluidLen,   ' ');
+    std::string units  (request.unitsLen,   ' ');
+    if (!recvAll(fd, &propReq[0], propReq.size()) || !recvAll(fd, &spec[0],  spec.size()) ||
+        !recvAll(fd, &fluid[0],   fluid.size())   || !recvAll(fd, &units[0], units.size()))
+    {
+        return false;
+    }
+
+    std::vector<double> value1(request.numelVal1);
+    std::vector<double> value2(request.numelVal2);
+    if (!recvAll(fd, value1.data(), value1.size() * sizeof(double)) ||
+        !recvAll(fd, value2.data(), value2.size() * sizeof(double)))
+    {
+        return false;
+    }
+    if (request.zipped && (value1.size() != value2.size()))
+    {
+        return sendStatus(fd, -1, "Zipped inputs require value1 and value2 to have the same number of elements.");
+    }
+
+    //////////////////////////////////////////////////////////////////////
+    // set the fluid only when it differs from the last request's fluid //
+    //////////////////////////////////////////////////////////////////////
+    int    ierr = 0;
+    char   herr[herr_length];
+    double z[20];
+    std::copy(request.z, request.z + 20, z);
+    std::vector<double> zRequest(z, z + 20);
+    if ((fluid != state.fluid) || (zRequest != state.z))
+    {
+        setRefpropFluid(fluid.c_str(), z, state.mixFlag, ierr);
+        if (ierr != 0)
+        {
+            state.fluid.clear();
+            return sendStatus(fd, ierr, "Fluid " + fluid + " failed to set: Error " + std::to_string(ierr));
+        }
+        state.fluid     = fluid;
+        state.z         = zRequest;
+        state.fluidSent = false;
+    } // end if the fluid changed
+
+    if (state.unitEnums.find(units) == state.unitEnums.end())
+    {
+        int iFlag  = 0;
+        int iUnits = 0;
+        GETENUMdll(iFlag, const_cast<char *>(units.c_str()), iUnits, ierr, herr, hUnits_length, herr_length);
+        if (ierr != 0)
+        {
+            return sendStatus(fd, ierr, "Converting " + units + " to enum failed: " + std::string(herr));
+        }
+        state.unitEnums[units] = iUnits;
+    } // end if the unit system has not been converted yet
+    int iUnits = state.unitEnums[units];
+
+    ////////////////////////////////////////////////////////////////////////////////////
+    // the two cache hashes cover everything but the inputs that changes the result   //
+    ////////////////////////////////////////////////////////////////////////////////////
+    std::string query = fluid + '\n' + propReq + '\n' + spec + '\n' + units + '\n' + std::to_string(request.iMass)
+                        + '\n';
+    query.append(reinterpret_cast<const char *>(z), sizeof(z));
+    uint64_t cacheKey   = sharedCacheHash(query.data(), query.size(), 0xcbf29ce484222325ULL);
+    uint64_t cacheCheck = sharedCacheHash(query.data(), query.size(), 0x84222325cbf29ce4ULL);
+
+    size_t numCols   = request.zipped ? 1 : value2.size();
+    size_t numPoints = value1.size() * numCols;
+    std::vector<double> output(numPoints);
+    uint32_t cacheHits = 0;
+    double hOutput[200];
+    double q;
+    double x[20];
+    double y[20];
+
+    for (size_t itc = 0; itc < numCols; itc++)
+    {
+        for (size_t itr = 0; itr < value1.size(); itr++)
+        {
+            double a = value1[itr];
+            double b = request.zipped ? value2[itr] : value2[itc];
+
+            double cached;
+            if ((state.cache != NULL) && sharedCacheLookup(state.cache, cacheKey, cacheCheck, a, b, cached))
+            {
+                output[(value1.size() * itc) + itr] = cached;
+                cacheHits++;
+                continue;
+            }
+
+            ierr = callREFPROPdll(state.fluidSent ? " " : fluid.c_str(), spec.c_str(), propReq.c_str(), iUnits,
+                                  request.iMass, state.mixFlag, a, b, z, hOutput, q, x, y, herr);
+            state.fluidSent = true;
+            double value = (ierr > 0) ? NAN : hOutput[0];
+            output[(value1.size() * itc) + itr] = value;
+
+            if ((state.cache != NULL) && (ierr <= 0))   // failed points are not shared
+            {
+                sharedCacheStore(state.cache, cacheKey, cacheCheck, a, b, value);
+            }
+        } // end loop over rows
+    } // end loop over columns
+
+    ServerResponse response = {serverMagic, 0, 0, cacheHits, uint64_t(numPoints)};
+    return sendAll(fd, &response, sizeof(response)) && sendAll(fd, output.data(), output.size() * sizeof(double));
+} // end function serveRequest
+
+//////////////////////////////////////////////////////////////////////////////////////
+// worker process: one REFPROP instance, answers the request of one connection at a //
+// time and closes it, until the parent asks it to stop                             //
+//////////////////////////////////////////////////////////////////////////////////////
+static int runWorker(int listenFd, const std::string &refpropPath, SharedResultCache *cache)
+{
+    std::string serr;
+    if (!load_REFPROP(serr, refpropPath, ""))
+    {
+        fprintf(stderr, "refpropServer: REFPROP failed to load from %s -> %s\n", refpropPath.c_str(), serr.c_str());
+        return 1;
+    }
+    SETPATHdll(const_cast<char *>(refpropPath.c_str()), 255);
+
+    WorkerState state;
+    state.cache = cache;
+    while (!stopRequested)
+    {
+        int fd = accept(listenFd, NULL, NULL);
+        if (fd < 0)
+        {
+            continue;
+        } // end if interrupted by a signal
+
+        ServerRequest request;
+        if (recvAll(fd, &request, sizeof(request)))
+        {
+            if ((request.magic != serverMagic) || (request.version != serverVersion))
+            {
+                sendStatus(fd, -1, "The client and refpropServer use different protocol versions.");
+            }
+            else if (!requestWithinLimits(request))
+            {
+                sendStatus(fd, -1, "The request exceeds the limits of refpropServer: " + std::to_string(serverMaxTextLen)
+                                   + " characters per name and " + std::to_string(serverMaxNumValues) + " values.");
+            }
+            else
+            {
+                serveRequest(fd, request, state);
+            }
+        } // end if a request was received
+        close(fd);
+    } // end loop over connections
+
+    unload_REFPROP(serr);
+    return 0;
+} // end function runWorker
+
+int main(int argc, char *argv[])
+{
+    if ((argc < 3) || (argc > 5))
+    {
+        fprintf(stderr, "usage: refpropServer socketPath refpropPath [numWorkers] [cacheSize]\n");
+        return 2;
+    }
+    std::string socketPath  = argv[1];
+    std::string refpropPath = argv[2];
+    int         numWorkers  = (argc > 3) ? atoi(argv[3]) : 4;
+    size_t      cacheSize   = (argc > 4) ? size_t(atoll(argv[4])) : 1000000;
+
+    sockaddr_un address = {};
+    address.sun_family  = AF_UNIX;
+    if ((numWorkers < 1) || (socketPath.size() >= sizeof(address.sun_path)))
+    {
+        fprintf(stderr, "refpropServer: numWorkers must be at least 1 and the socket path shorter than %zu characters\n",
+                sizeof(address.sun_path));
+        return 2;
+    }
+    strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    /////////////////////////////////////////////////////////////////////////////
+    // the socket is created with only user permissions, so other users on the //
+    // host cannot send requests                                               //
+    /////////////////////////////////////////////////////////////////////////////
+    unlink(socketPath.c_str());
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    mode_t oldMask = umask(0077);
+    if ((listenFd < 0) || (bind(listenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) ||
+        (listen(listenFd, 64) != 0))
+    {
+        perror("refpropServer");
+        return 1;
+    }
+    umask(oldMask);
+
+    struct sigaction stopAction = {};
+    stopAction.sa_handler = requestStop;
+    sigaction(SIGTERM, &stopAction, NULL);
+    sigaction(SIGINT,  &stopAction, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    //////////////////////////////////////////////////////////////////////////////
+    // the workers inherit the cache mapping, so its name is removed as soon as //
+    // it is mapped and the segment goes away with the last process of the pool //
+    //////////////////////////////////////////////////////////////////////////////
+    SharedResultCache *cache = NULL;
+    if (cacheSize > 0)
+    {
+        std::string cacheName = "refpropServer_" + std::to_string(int(getpid()));
+        std::string msg;
+        cache = openSharedCache(cacheName.c_str(), cacheSize, msg);
+        if (cache == NULL)
+        {
+            fprintf(stderr, "refpropServer: %s\n", msg.c_str());
+            close(listenFd);
+            unlink(socketPath.c_str());
+            return 1;
+        }
+        shm_unlink(("/" + cacheName).c_str());
+    } // end if the cache is enabled
+
+    FILE *pidFile = fopen((socketPath + ".pid").c_str(), "w");
+    if (pidFile != NULL)
+    {
+        fprintf(pidFile, "%d\n", int(getpid()));
+        fclose(pidFile);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // start the pool and restart any worker that exits while still serving //
+    //////////////////////////////////////////////////////////////////////////
+    std::vector<pid_t> workers(numWorkers, 0);
+    unsigned int       retryDelay = 1;             // seconds to wait before forking again after a fork failed
+    while (!stopRequested)
+    {
+        bool forkFailed = false;
+        for (size_t itw = 0; itw < workers.size(); itw++)
+        {
+            if (workers[itw] == 0)
+            {
+                pid_t pid = fork();
+                if (pid == 0)
+                {
+                    _exit(runWorker(listenFd, refpropPath, cache));
+                }
+                workers[itw] = (pid > 0) ? pid : 0;
+                forkFailed   = forkFailed || (pid < 0);
+            }
+        } // end loop over workers
+
+        ///////////////////////////////////////////////////////////////////////////
+        // after a failed fork, wait before the next attempt rather than spin on //
+        // waitpid, which returns at once when no worker is running              //
+        ///////////////////////////////////////////////////////////////////////////
+        int   status = 0;
+        pid_t exited = 0;
+        if (forkFailed)
+        {
+            perror("refpropServer: fork");
+            sleep(retryDelay);
+            retryDelay = (retryDelay < 30) ? (2 * retryDelay) : 60;
+            exited     = waitpid(-1, &status, WNOHANG);
+        }
+        else
+        {
+            retryDelay = 1;
+            exited     = waitpid(-1, &status, 0);
+        } // end if a fork failed, else wait for a worker to exit
+        for (size_t itw = 0; itw < workers.size(); itw++)
+        {
+            if ((exited > 0) && (workers[itw] == exited))
+            {
+                fprintf(stderr, "refpropServer: worker %d exited (status %d), restarting it\n", int(exited), status);
+                workers[itw] = 0;
+                if (WIFEXITED(status) && (WEXITSTATUS(status) == 1))
+                {
+                    stopRequested = 1;
+                } // end if REFPROP could not be loaded, restarting would fail the same way
+            }
+        } // end loop over workers
+    } // end loop until stopped
+
+    for (size_t itw = 0; itw < workers.size(); itw++)
+    {
+        if (workers[itw] > 0)
+        {
+            kill(workers[itw], SIGKILL);
+            waitpid(workers[itw], NULL, 0);
+        }
+    } // end loop over workers
+    closeSharedCache(cache);
+    close(listenFd);
+    unlink(socketPath.c_str());
+    unlink((socketPath + ".pid").c_str());
+    return 0;
+} // end function main
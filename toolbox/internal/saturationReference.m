@@ -0,0 +1,40 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% saturationReference
+%   Saturation property from the library, used by fitSaturationAncillary.m to fit the ancillaries and by
+%   evaluateSaturationAncillary.m where they do not apply.
+%
+%   From MATLAB:
+%        value = saturationReference(ancillary, name, inputProperty, inputValue)
+%
+%   Where
+%
+%       value       = DOUBLE (same size as inputValue) in SI units (Pa, K, kg/m^3, J/kg, J/(kg K))
+%       ancillary   = STRUCT with at least the fields Library, Fluid, Composition, MassOrMolar and KeepLibraryLoaded
+%       name        = STRING saturation property: "Pliq", "Pvap", "Tliq", "Tvap", "Dliq", "Dvap", "Hliq", "Hvap",
+%                            "Sliq" or "Svap", the liq properties at the bubble point and the vap properties at the
+%                            dew point
+%   inputProperty   = STRING "T" or "P"
+%       inputValue  = DOUBLE array of temperatures (K) or pressures (Pa)
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function value = saturationReference(ancillary, name, inputProperty, inputValue)
+    arguments
+        ancillary     (1, 1) struct
+        name          (1, 1) string
+        inputProperty (1, 1) string
+        inputValue           double
+    end
+
+    quality  = double(endsWith(name, "vap"));
+    property = extractBefore(name, 2);
+    if ~contains(ancillary.Library, "REFPROP", "IgnoreCase", true) && any(property == ["D", "H", "S"])
+        property = property + "mass";   % CoolProp names the mass based properties Dmass, Hmass and Smass
+    end
+
+    value = getFluidProperty(ancillary.Library, char(property), char(inputProperty), inputValue(:)', 'Q', quality,...
+                             ancillary.Fluid, ancillary.Composition, ancillary.MassOrMolar, 'MASS BASE SI',...
+                             keepLibraryLoaded=ancillary.KeepLibraryLoaded);
+    value = reshape(value, size(inputValue));
+end % end function saturationReference
@@ -0,0 +1,184 @@
+/*=============================================================================================*
+ *  serverMexC.cpp - client of refpropServer written with the MEX C api (Linux and macOS).     *
+ *                   Sends one batched request over the Unix domain socket and returns the     *
+ *                   same output as hiLevelMexC, without loading REFPROP in MATLAB.            *
+ *                                                                                             *
+ *  From MATLAB(R):                                                                               *
+ *       output = serverMexC(socketPath, propReq, spec, value1, value2, fluid, iMass, z,       *
+ *                           unit_char, zipped)                                                *
+ *                                                                                             *
+ *  Where (see: https://refprop-docs.readthedocs.io/en/latest/DLL/high_level.html)             *
+ *    output     = DOUBLE (array of size MxN) output from RefProp for the desired Property     *
+ *                 from propReq where M is the size of value1 and N is the size of value2,     *
+ *                 or Mx1 when zipped is 1                                                     *
+ *    socketPath = CHAR path of the socket refpropServer listens on                            *
+ *    propReq    = CHAR value accepted by REFPROP as 'hOut' values                             *
+ *    spec       = CHAR value accepted by REFPROP as 'hIn'  values                             *
+ *    value1     = DOUBLE (array of size 1xM) of values related to the first character in spec *
+ *    value2     = DOUBLE (array of size 1xN) of values related to the second character in     *
+ *                 spec                                                                        *
+ *    fluid      = CHAR value accepted by REFPROP as 'hFld' values                             *
+ *    iMass      = INT value to determine input units: 0 -> Molar, 1 -> Mass (sets iMass)      *
+ *    z          = DOUBLE (array of size 1x20) of species fractions                            *
+ *    unit_char  = CHAR value to determine units to use (enum as expected by refprop.dll)      *
+ *    zipped     = DOUBLE value (0 for every pair of value1 and value2, 1 for value1(k) with   *
+ *                 value2(k) only)                                                             *
+ *                                                                                             *
+ *  Every call opens its own connection, which the server closes after the response, so a      *
+ *  session never holds a worker between calls and any number of sessions share the pool.      *
+ *=============================================================================================*/
+
+// Copyright 2026 The MathWorks, Inc.
+
+#include "propertyServerProtocol.h"
+
+#include <string>
+#include <vector>
+#include <string.h>
+#include <unistd.h>
+#include <sys/un.h>
+#include "mex.h"
+
+/////////////////////////////////////////////////
+// open a connection to the socket, -1 on fail //
+/////////////////////////////////////////////////
+static int connectToServer(const std::string &socketPath)
+{
+    sockaddr_un address = {};
+    address.sun_family  = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        return -1;
+    }
+    strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if ((fd < 0) || (connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0))
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return -1;
+    }
+#ifdef SO_NOSIGPIPE
+    int noSigPipe = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+    return fd;
+} // end function connectToServer
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// function to check that the number and type of arguments, in and out, are as expected //
+//////////////////////////////////////////////////////////////////////////////////////////
+void checkArguments(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
+{
+    int expectedIn = 10;   // expected number of input variables
+
+    if(numOutArg > 1)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:serverMexC:nlhs", "Incorrect number of outputs were given, only 1 output is allowed");
+    }
+
+    if(numInArg != expectedIn)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:serverMexC:nrhs", "%i inputs were given, but %i are expected.", numInArg, expectedIn);
+    }
+    else if(!mxIsChar(inputs[0]) || !mxIsChar(inputs[1]) || !mxIsChar(inputs[2]) || !mxIsChar(inputs[5]) || !mxIsChar(inputs[8]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:serverMexC:prhs", "Input variables socketPath, propReq, spec, fluid and unit_char expected to be of type CHAR.");
+    }
+    else if(!mxIsDouble(inputs[3]) || !mxIsDouble(inputs[4]) || !mxIsDouble(inputs[6]) || !mxIsDouble(inputs[7]) || !mxIsDouble(inputs[9]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:serverMexC:prhs", "Input variables value1, value2, iMass, z and zipped expected to be of type DOUBLE.");
+    }
+    else if(mxGetNumberOfElements(inputs[7]) != 20)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:serverMexC:prhs", "Input variable z expected to have 20 elements, %zu were given.", mxGetNumberOfElements(inputs[7]));
+    }
+} // end function checkArguments
+
+///////////////////////////////////////////////////////////////////////////////
+// send the request and receive the response, false if the connection failed //
+///////////////////////////////////////////////////////////////////////////////
+static bool exchange(int fd, const ServerRequest &request, const std::vector<std::string> &text,
+                     const mxArray *value1, const mxArray *value2, ServerResponse &response)
+{
+    if (!sendAll(fd, &request, sizeof(request)))
+    {
+        return false;
+    }
+    for (size_t its = 0; its < text.size(); its++)
+    {
+        if (!sendAll(fd, text[its].data(), text[its].size()))
+        {
+            return false;
+        }
+    } // end loop over text fields
+    return sendAll(fd, mxGetPr(value1), size_t(request.numelVal1) * sizeof(double)) &&
+           sendAll(fd, mxGetPr(value2), size_t(request.numelVal2) * sizeof(double)) &&
+           recvAll(fd, &response, sizeof(response));
+} // end function exchange
+
+void mexFunction(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
+{
+    checkArguments(numOutArg, outputs, numInArg, inputs);
+
+    char *socketPath = mxArrayToString(inputs[0]);
+    std::vector<std::string> text;
+    text.push_back(mxArrayToString(inputs[1]));   // propReq
+    text.push_back(mxArrayToString(inputs[2]));   // spec
+    text.push_back(mxArrayToString(inputs[5]));   // fluid
+    text.push_back(mxArrayToString(inputs[8]));   // unit_char
+
+    ServerRequest request = {};
+    request.magic      = serverMagic;
+    request.version    = serverVersion;
+    request.iMass      = int32_t(mxGetScalar(inputs[6]));
+    request.propReqLen = uint32_t(text[0].size());
+    request.specLen    = uint32_t(text[1].size());
+    request.fluidLen   = uint32_t(text[2].size());
+    request.unitsLen   = uint32_t(text[3].size());
+    request.zipped     = (mxGetScalar(inputs[9]) != 0.0) ? 1 : 0;
+    request.numelVal1  = mxGetNumberOfElements(inputs[3]);
+    request.numelVal2  = mxGetNumberOfElements(inputs[4]);
+    memcpy(request.z, mxGetPr(inputs[7]), sizeof(request.z));
+    if (!requestWithinLimits(request))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:serverMexC:prhs", "refpropServer accepts at most %u characters per name and %zu values per request, evaluate the grid in smaller parts.", serverMaxTextLen, size_t(serverMaxNumValues));
+    }
+
+    int fd = connectToServer(socketPath);
+    if (fd < 0)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:serverMexC:connect", "Cannot connect to refpropServer at %s. Start it with startPropertyServer.", socketPath);
+    }
+    ServerResponse response = {};
+    if (!exchange(fd, request, text, inputs[3], inputs[4], response) || (response.magic != serverMagic))
+    {
+        close(fd);
+        mexErrMsgIdAndTxt("MyToolbox:serverMexC:connect", "The connection to refpropServer at %s was lost, the worker may have crashed.", socketPath);
+    }
+
+    if (response.status != 0)
+    {
+        std::string msg(response.msgLen, ' ');
+        recvAll(fd, &msg[0], msg.size());
+        close(fd);
+        mexErrMsgIdAndTxt("MyToolbox:serverMexC:refprop", "refpropServer: %s", msg.c_str());
+    }
+
+    size_t numCols = request.zipped ? 1 : size_t(request.numelVal2);
+    if (response.numValues != (request.numelVal1 * numCols))
+    {
+        close(fd);
+        mexErrMsgIdAndTxt("MyToolbox:serverMexC:connect", "refpropServer returned %zu values, %zu were expected.", size_t(response.numValues), size_t(request.numelVal1 * numCols));
+    }
+    outputs[0] = mxCreateNumericMatrix(size_t(request.numelVal1), numCols, mxDOUBLE_CLASS, mxREAL);
+    bool received = recvAll(fd, mxGetPr(outputs[0]), size_t(response.numValues) * sizeof(double));
+    close(fd);
+    if (!received)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:serverMexC:connect", "The connection to refpropServer at %s was lost, the worker may have crashed.", socketPath);
+    }
+} // end function mexFunction
@@ -0,0 +1,66 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% siUnitFactors
+%   Returns the scale and offset that convert a value in Unit to SI units, valueSI = value*Scale + Offset, from the
+%   unit tables of unit_convert_SI.
+%
+%   From MATLAB:
+%        [Scale, Offset] = siUnitFactors(Unit, Type)
+%
+%   Where
+%
+%       Unit    = CHAR unit, e.g. 'kPa', 'bar', 'degC', 'kJ/kg'; case is ignored
+%       Type    = CHAR 'P' (pressure, Pa), 'H' (specific enthalpy, J/kg), 'T' (temperature, K) or 'S' (one part of a
+%                      specific entropy unit, J/(kg K): the enthalpy part or the temperature part)
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function [Scale, Offset] = siUnitFactors(Unit, Type)
+    arguments
+        Unit          (1, :) {mustBeText};
+        Type          (1, :) {mustBeText};
+    end
+
+    PressureUnits    = ["pa", "kpa", "mpa", "bar", "psi",  "atm"];
+    PressureScales   = [1,    1e3,   1e6,   1e5,   6894.8, 101325];
+    EnthalpyUnits    = ["kj/kg", "j/kg", "j/g", "btu/lbm"];
+    EnthalpyScales   = [1e3,     1,      1e3,   2326.0];
+    TemperatureUnits = ["k", "degc", "degf"];
+    TemperatureScale = [1,   1,      5/9];
+    TemperatureShift = [0,   273.15, 273.15 - 32*5/9];
+
+    Offset = 0;
+    switch lower(Type)
+        case "p"  % Pressure
+            ux = find(strcmpi(Unit, PressureUnits), 1);
+            if isempty(ux)
+                error("pressure unit error?")
+            end
+            Scale = PressureScales(ux);
+        case "h"  % specific enthalpy
+            ux = find(strcmpi(Unit, EnthalpyUnits), 1);
+            if isempty(ux)
+                error("enthalpy unit error?")
+            end
+            Scale = EnthalpyScales(ux);
+        case "t"  % temperature
+            ux = find(strcmpi(Unit, TemperatureUnits), 1);
+            if isempty(ux)
+                error("temperature unit error?")
+            end
+            Scale  = TemperatureScale(ux);
+            Offset = TemperatureShift(ux);
+        case "s"  % specific entropy, per unit of enthalpy or per degree of temperature
+            ux = find(strcmpi(Unit, EnthalpyUnits), 1);
+            tx = find(strcmpi(Unit, TemperatureUnits), 1);
+            if ~isempty(ux)
+                Scale = EnthalpyScales(ux);
+            elseif ~isempty(tx)
+                Scale = 1 / TemperatureScale(tx);
+            else
+                error("specific entropy unit error?")
+            end
+        otherwise  % catch input error
+            error("check unit type. P/H/T/S allowed.")
+    end
+end % end function siUnitFactors
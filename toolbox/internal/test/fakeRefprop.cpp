@@ -0,0 +1,168 @@
+/*=============================================================================================*
+ *  fakeRefprop.cpp - stand-in for the REFPROP shared library, so refpropEngineTest runs       *
+ *                    without a REFPROP installation. It exports the few routines the engine   *
+ *                    calls with REFPROP's unmangled names and argument lists.                 *
+ *                                                                                             *
+ *  Any fluid but NOTAFLUID sets, and the unit systems are MKS and MASS BASE SI. REFPROPdll    *
+ *  returns a + 2 b for every property and spec, and error 1 when a is negative, which gives   *
+ *  the test known values and known failed points. The exceptions are:                         *
+ *    - the limits TMIN = 1, TMAX = 1000, PMAX = 1000, DMAX = 100 and PTRP = 5, and a melting  *
+ *      line at 2 and a sublimation line at 1.5 for T, H or S at any pressure,                 *
+ *    - saturated states at T = P, with D, E, H and S of 10, T, T and 1 for the liquid and of  *
+ *      1, T + 90, T + 100 and 11 for the vapor, when PQ or TQ asks for several properties,    *
+ *    - a PH flash between those states, which interpolates them in the quality,               *
+ *    - 1000 added to a + 2 b while PREOSdll has switched to Peng-Robinson.                    *
+ *=============================================================================================*/
+
+// Copyright 2026 The MathWorks, Inc.
+
+#include <cstddef>
+#include <string.h>
+#include <math.h>
+
+#if defined(_WIN32)
+#define FAKE_API extern "C" __declspec(dllexport)
+#else
+#define FAKE_API extern "C" __attribute__((visibility("default")))
+#endif
+
+FAKE_API void RPVersion(char *hv, size_t hvLength)
+{
+    strncpy(hv, "fake", hvLength);
+} // end function RPVersion
+
+FAKE_API void SETUPdll(int &, char *, char *, char *, int &ierr, char *, size_t, size_t, size_t, size_t)
+{
+    ierr = 0;
+} // end function SETUPdll
+
+FAKE_API void SETPATHdll(char *, size_t)
+{
+} // end function SETPATHdll
+
+FAKE_API void SETFLUIDSdll(char *hFld, int &ierr, size_t)
+{
+    ierr = (strstr(hFld, "NOTAFLUID") != NULL) ? 101 : 0;
+} // end function SETFLUIDSdll
+
+FAKE_API void GETENUMdll(int &, char *hEnum, int &iEnum, int &ierr, char *herr, size_t, size_t herrLength)
+{
+    ierr  = 0;
+    iEnum = 0;
+    if (strncmp(hEnum, "MKS", 3) == 0)
+    {
+        iEnum = 2;
+    }
+    else if (strncmp(hEnum, "MASS BASE SI", 12) == 0)
+    {
+        iEnum = 21;
+    }
+    else
+    {
+        ierr = 1;
+        strncpy(herr, "unknown unit system", herrLength);
+    } // end if MKS, else if MASS BASE SI, else unknown
+} // end function GETENUMdll
+
+static int preos = 0;   // model set by PREOSdll, 2 -> Peng-Robinson
+
+FAKE_API void PREOSdll(int &iPREOS)
+{
+    preos = iPREOS;
+} // end function PREOSdll
+
+/////////////////////////////////////////////////////////////////////////////////////
+// T, P, D, E, H and S of the saturated liquid (side 0) or vapor (side 1) at T = P //
+/////////////////////////////////////////////////////////////////////////////////////
+static void saturated(double tp, int side, double *output)
+{
+    output[0] = tp;
+    output[1] = tp;
+    output[2] = (side == 0) ? 10.0 : 1.0;
+    output[3] = tp + ((side == 0) ? 0.0 : 90.0);
+    output[4] = tp + ((side == 0) ? 0.0 : 100.0);
+    output[5] = (side == 0) ? 1.0 : 11.0;
+} // end function saturated
+
+///////////////////////////////////////////////////////////////////////////////////
+// property prop of the two-phase state of quality q between the saturated       //
+// states at T = P, linear in the quality but for D, which is linear in 1 / D    //
+///////////////////////////////////////////////////////////////////////////////////
+static double twoPhase(char prop, double tp, double q)
+{
+    const char *names = "TPDEHS";
+    double      liquid[6];
+    double      vapor [6];
+    saturated(tp, 0, liquid);
+    saturated(tp, 1, vapor);
+    if (prop == 'Q')
+    {
+        return q;
+    }
+    if (prop == 'D')
+    {
+        return 1.0 / (((1.0 - q) / liquid[2]) + (q / vapor[2]));
+    }
+    const char *at = strchr(names, prop);
+    return (at != NULL) ? liquid[at - names] + q * (vapor[at - names] - liquid[at - names]) : NAN;
+} // end function twoPhase
+
+FAKE_API void REFPROPdll(char *, char *hIn, char *hOut, int &, int &, int &, double &a, double &b, double *,
+                         double *output, char *hUnits, int &iUCode, double *x, double *y, double *x3, double &q,
+                         int &ierr, char *herr, size_t, size_t, size_t, size_t hUnitsLength, size_t herrLength)
+{
+    strncpy(hUnits, "", hUnitsLength);
+    iUCode  = 0;
+    q       = -998.0;
+    x[0]    = 1.0;
+    y[0]    = 1.0;
+    x3[0]   = 0.0;
+    ierr    = 0;
+    herr[0] = '\0';
+
+    ////////////////////////////////////////////////////////////
+    // limits, and the melting and sublimation lines at any P //
+    ////////////////////////////////////////////////////////////
+    if ((hIn[0] == '\0') && (strcmp(hOut, "TMIN;TMAX;PMAX;DMAX") == 0))
+    {
+        output[0] = 1.0;
+        output[1] = 1000.0;
+        output[2] = 1000.0;
+        output[3] = 100.0;
+        return;
+    }
+    if ((hIn[0] == '\0') && (strcmp(hOut, "PTRP") == 0))
+    {
+        output[0] = 5.0;
+        return;
+    }
+    if ((strcmp(hIn, "PMELT") == 0) || (strcmp(hIn, "PSUBL") == 0))
+    {
+        output[0] = (hIn[1] == 'M') ? 2.0 : 1.5;
+        return;
+    }
+
+    if (a < 0.0)
+    {
+        ierr = 1;
+        strncpy(herr, "negative input", herrLength);
+        return;
+    }
+    if (((strcmp(hIn, "PQ") == 0) || (strcmp(hIn, "TQ") == 0)) && (strchr(hOut, ';') != NULL))
+    {
+        saturated(a, int(b), output);
+        q = b;
+        return;
+    }
+    if ((strcmp(hIn, "PH") == 0) && (strlen(hOut) == 1))
+    {
+        double quality = (b - a) / 100.0;   // H of the saturated liquid is P, of the vapor P + 100
+        if ((quality > 0.0) && (quality < 1.0))
+        {
+            output[0] = twoPhase(hOut[0], a, quality);
+            q         = quality;
+            return;
+        }
+    } // end if a PH flash, which may be two-phase
+    output[0] = a + (2.0 * b) + ((preos == 2) ? 1000.0 : 0.0);
+} // end function REFPROPdll
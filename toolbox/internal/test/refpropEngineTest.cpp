@@ -0,0 +1,353 @@
+/*=============================================================================================*
+ *  refpropEngineTest.cpp - checks the status codes and failed-point handling of the C         *
+ *                          interface in refpropEngine.h against fakeRefprop, and the          *
+ *                          phase output, models, domain check, lever rule, shared cache       *
+ *                          and interrupt check of its evaluations.                            *
+ *                                                                                             *
+ *  From a shell (ctest does this for you):                                                    *
+ *       refpropEngineTest fakeRefpropDir                                                      *
+ *                                                                                             *
+ *  Where                                                                                      *
+ *    fakeRefpropDir = directory holding the fakeRefprop library under REFPROP's library name  *
+ *                                                                                             *
+ *  Prints each check that fails and returns the number of failed checks.                      *
+ *=============================================================================================*/
+
+// Copyright 2026 The MathWorks, Inc.
+
+#include "refpropEngine.h"
+#include "sharedResultCache.h"
+
+#include <string>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static int numFailedChecks = 0;
+
+static void check(bool passed, const char *what)
+{
+    if (!passed)
+    {
+        printf("FAILED: %s\n", what);
+        numFailedChecks++;
+    }
+} // end function check
+
+///////////////////////////////////////////////////////////////////////////////////
+// loading REFPROP: a missing path or library fails, and all sessions of the     //
+// process share the directory of the first one                                  //
+///////////////////////////////////////////////////////////////////////////////////
+static rpeSession *testOpen(const char *refpropPath)
+{
+    int status = -1;
+    check((rpeOpen(NULL, &status) == NULL) && (status == RPE_ERR_ARGUMENT), "rpeOpen of a NULL path");
+    check((rpeOpen("/nonexistent/REFPROP", &status) == NULL) && (status == RPE_ERR_LOAD),
+          "rpeOpen of a directory without REFPROP");
+    check(strstr(rpeLastError(NULL), "/nonexistent/REFPROP") != NULL, "rpeLastError of a failed rpeOpen");
+
+    rpeSession *session = rpeOpen(refpropPath, &status);
+    check((session != NULL) && (status == RPE_OK), "rpeOpen of the fakeRefprop directory");
+    if (session != NULL)
+    {
+        check((rpeOpen("/nonexistent/REFPROP", &status) == NULL) && (status == RPE_ERR_LOAD),
+              "rpeOpen of another directory while REFPROP is loaded");
+    }
+    return session;
+} // end function testOpen
+
+///////////////////////////////////////////////////////////////////////////////////
+// fluid and unit setup, and evaluations before it has succeeded                 //
+///////////////////////////////////////////////////////////////////////////////////
+static void testSetup(rpeSession *session)
+{
+    double z[20]     = {1.0};
+    double value     = 1.0;
+    double output    = 0.0;
+    std::string longFluid(RPE_FLUID_LENGTH, 'A');
+
+    check(rpeEvaluate(session, "H", "TP", 1, &value, &value, &output) == RPE_ERR_NOT_READY,
+          "rpeEvaluate before rpeSetFluid");
+    check(rpeSetFluid(NULL, "Water", z, 1) == RPE_ERR_ARGUMENT, "rpeSetFluid of a NULL session");
+    check(rpeSetFluid(session, NULL, z, 1) == RPE_ERR_ARGUMENT, "rpeSetFluid of a NULL fluid");
+    check(rpeSetFluid(session, "Water", NULL, 1) == RPE_ERR_ARGUMENT, "rpeSetFluid of a NULL composition");
+    check(rpeSetFluid(session, longFluid.c_str(), z, 1) == RPE_ERR_ARGUMENT, "rpeSetFluid of a too long fluid");
+    check(rpeSetFluid(session, "NOTAFLUID", z, 1) == RPE_ERR_FLUID, "rpeSetFluid of an unknown fluid");
+    check(rpeLastError(session)[0] != '\0', "rpeLastError after an unknown fluid");
+
+    check(rpeSetFluid(session, "Water", z, 1) == RPE_OK, "rpeSetFluid of Water");
+    check(rpeNumComponents(session) == 1, "rpeNumComponents of Water");
+    check(rpeEvaluate(session, "H", "TP", 1, &value, &value, &output) == RPE_ERR_NOT_READY,
+          "rpeEvaluate before rpeSetUnits");
+    check(rpeSetUnits(session, NULL) == RPE_ERR_ARGUMENT, "rpeSetUnits of NULL units");
+    check(rpeSetUnits(session, "FURLONGS") == RPE_ERR_UNITS, "rpeSetUnits of an unknown unit system");
+    check(rpeSetUnits(session, "MKS") == RPE_OK, "rpeSetUnits of MKS");
+} // end function testSetup
+
+///////////////////////////////////////////////////////////////////////////////////
+// arguments of the evaluations, and a failed point among good ones, which is    //
+// NaN and counted while the rest of the batch is evaluated                      //
+///////////////////////////////////////////////////////////////////////////////////
+static void testEvaluate(rpeSession *session)
+{
+    double value1[4] = {1.0, -1.0, 2.0, 3.0};
+    double value2[4] = {10.0, 20.0, 30.0, 40.0};
+    double output[6] = {0.0};
+    std::string longSpec(RPE_STRING_LENGTH, 'T');
+
+    check(rpeEvaluate(NULL, "H", "TP", 4, value1, value2, output) == RPE_ERR_ARGUMENT, "rpeEvaluate of a NULL session");
+    check(rpeEvaluate(session, "H", "TP", 4, value1, value2, NULL) == RPE_ERR_ARGUMENT, "rpeEvaluate into NULL");
+    check(rpeEvaluate(session, "H", longSpec.c_str(), 4, value1, value2, output) == RPE_ERR_ARGUMENT,
+          "rpeEvaluate of a too long spec");
+
+    check(rpeEvaluate(session, "H", "TP", 4, value1, value2, output) == RPE_OK, "rpeEvaluate with a failed point");
+    check((output[0] == 21.0) && isnan(output[1]) && (output[2] == 62.0) && (output[3] == 83.0),
+          "rpeEvaluate values, NaN at the failed point");
+    check((rpeNumEvaluated(session) == 4) && (rpeNumFailed(session) == 1), "rpeNumEvaluated and rpeNumFailed");
+    check(rpeLastError(session)[0] != '\0', "rpeLastError after a failed point");
+
+    //////////////////////////////////////////////////////////////////////////
+    // a 2x3 grid of value1 down the rows and value2 across the columns     //
+    //////////////////////////////////////////////////////////////////////////
+    size_t outDims[2] = {2, 3};
+    size_t stride1[2] = {1, 0};
+    size_t stride2[2] = {0, 1};
+    check(rpeEvaluateExpanded(session, "H", "TP", 2, outDims, value1, stride1, value2, stride2, output) == RPE_OK,
+          "rpeEvaluateExpanded of a grid");
+    check((output[0] == 21.0) && isnan(output[1]) && (output[2] == 41.0) && isnan(output[3]) &&
+          (output[4] == 61.0) && isnan(output[5]), "rpeEvaluateExpanded values in column-major order");
+    check(rpeNumFailed(session) == 3, "rpeNumFailed of the grid");
+
+    unsigned char mask[4]        = {1, 0, 1, 0};
+    int           pointStatus[4] = {-1, -1, -1, -1};
+    size_t        numPoints      = 4;
+    size_t        unitStride     = 1;
+    check(rpeEvaluateExpandedMasked(session, "H", "TP", 1, &numPoints, value1, &unitStride, value2, &unitStride, mask,
+                                    output, pointStatus) == RPE_OK, "rpeEvaluateExpandedMasked");
+    check((pointStatus[0] == RPE_POINT_OK) && (pointStatus[1] == RPE_POINT_MASKED) &&
+          (pointStatus[2] == RPE_POINT_OK) && (pointStatus[3] == RPE_POINT_MASKED) && isnan(output[3]),
+          "rpeEvaluateExpandedMasked point status");
+    check((rpeNumEvaluated(session) == 2) && (rpeNumSkipped(session) == 2) && (rpeNumFailed(session) == 0),
+          "rpeEvaluateExpandedMasked counts");
+} // end function testEvaluate
+
+///////////////////////////////////////////////////////////////////////////////////
+// records with their own propReq and spec, each with its REFPROP error          //
+///////////////////////////////////////////////////////////////////////////////////
+static void testRecords(rpeSession *session)
+{
+    const char *propReq[3] = {"H", "D", "S"};
+    const char *spec   [3] = {"TP", "PH", "TQ"};
+    const char *badSpec[3] = {"TP", NULL, "TQ"};
+    double      value1 [3] = {1.0, -2.0, 3.0};
+    double      value2 [3] = {1.0, 2.0, 0.5};
+    double      output [3] = {0.0};
+    int         ierr   [3] = {-1, -1, -1};
+
+    check(rpeEvaluateRecords(session, 3, propReq, badSpec, value1, value2, output, ierr) == RPE_ERR_ARGUMENT,
+          "rpeEvaluateRecords with a NULL spec");
+    check(rpeEvaluateRecords(session, 3, propReq, spec, value1, value2, output, ierr) == RPE_OK,
+          "rpeEvaluateRecords with a failed record");
+    check((output[0] == 3.0) && isnan(output[1]) && (output[2] == 4.0), "rpeEvaluateRecords values");
+    check((ierr[0] == 0) && (ierr[1] == 1) && (ierr[2] == 0), "rpeEvaluateRecords ierr of each record");
+    check((rpeNumEvaluated(session) == 3) && (rpeNumFailed(session) == 1), "rpeEvaluateRecords counts");
+} // end function testRecords
+
+///////////////////////////////////////////////////////////////////////////////////
+// the quality and compositions of each point from the same flash, NaN at the    //
+// failed point                                                                  //
+///////////////////////////////////////////////////////////////////////////////////
+static void testPhaseOutput(rpeSession *session)
+{
+    double value1[4] = {1.0, -1.0, 2.0, 3.0};
+    double value2[4] = {10.0, 20.0, 30.0, 40.0};
+    double output[4] = {0.0};
+    double q [4], x[4], y[4], x3[4];
+
+    rpeSetPhaseOutput(session, q, x, y, x3);
+    check(rpeEvaluate(session, "H", "TP", 4, value1, value2, output) == RPE_OK, "rpeEvaluate with phase output");
+    check((q[0] == -998.0) && isnan(q[1]) && (q[3] == -998.0) && (x[0] == 1.0) && isnan(x[1]) && (y[2] == 1.0) &&
+          isnan(y[1]) && (x3[3] == 0.0) && isnan(x3[1]), "rpeSetPhaseOutput values, NaN at the failed point");
+    rpeSetPhaseOutput(session, NULL, NULL, NULL, NULL);
+} // end function testPhaseOutput
+
+///////////////////////////////////////////////////////////////////////////////////
+// the fast model switches REFPROP to Peng-Robinson for its evaluations only     //
+///////////////////////////////////////////////////////////////////////////////////
+static void testModel(rpeSession *session)
+{
+    double value1 = 1.0;
+    double value2 = 10.0;
+    double output = 0.0;
+
+    check(rpeSetModel(session, 5) == RPE_ERR_ARGUMENT, "rpeSetModel of an unknown model");
+    check((rpeSetModel(session, RPE_MODEL_FAST) == RPE_OK) && (rpeGetModel(session) == RPE_MODEL_FAST),
+          "rpeSetModel of the fast model");
+    check((rpeEvaluate(session, "H", "TP", 1, &value1, &value2, &output) == RPE_OK) && (output == 1021.0),
+          "rpeEvaluate with the fast model");
+    check((rpeSetModel(session, RPE_MODEL_EXACT) == RPE_OK) &&
+          (rpeEvaluate(session, "H", "TP", 1, &value1, &value2, &output) == RPE_OK) && (output == 21.0),
+          "rpeEvaluate with the exact model after the fast one");
+} // end function testModel
+
+///////////////////////////////////////////////////////////////////////////////////
+// points outside the limits, at a negative P or D, at a saturation P below the  //
+// triple point, or below the melting or sublimation line are not evaluated      //
+///////////////////////////////////////////////////////////////////////////////////
+static void testDomain(rpeSession *session)
+{
+    double value1[6]      = {500.0, 2000.0, 500.0, 1.8,   1.8, 1.2};
+    double value2[6]      = {100.0, 100.0,  -1.0,  100.0, 2.0, 2.0};
+    double output[6]      = {0.0};
+    int    pointStatus[6] = {-1, -1, -1, -1, -1, -1};
+    size_t numPoints      = 6;
+    size_t unitStride     = 1;
+
+    rpeSetDomainCheck(session, 1);
+    check(rpeEvaluateExpandedMasked(session, "H", "TP", 1, &numPoints, value1, &unitStride, value2, &unitStride, NULL,
+                                    output, pointStatus) == RPE_OK, "rpeEvaluateExpandedMasked with the domain check");
+    check((pointStatus[0] == RPE_POINT_OK) && (pointStatus[1] == RPE_POINT_OUT_OF_RANGE) &&
+          (pointStatus[2] == RPE_POINT_OUT_OF_RANGE) && (pointStatus[3] == RPE_POINT_SOLID) &&
+          (pointStatus[4] == RPE_POINT_OK) && (pointStatus[5] == RPE_POINT_SOLID),
+          "domain check of T and P, below the melting line and below the sublimation line");
+    check((output[0] == 700.0) && isnan(output[1]) && (output[4] == 5.8) && isnan(output[5]) &&
+          (rpeNumEvaluated(session) == 2) && (rpeNumSkipped(session) == 4), "domain check values and counts");
+
+    double pressure[2] = {2.0, 10.0};
+    double quality [2] = {0.5, 0.5};
+    double density [2] = {-1.0, 1.0};
+    double temp    [2] = {500.0, 500.0};
+    numPoints          = 2;
+    check(rpeEvaluateExpandedMasked(session, "H", "PQ", 1, &numPoints, pressure, &unitStride, quality, &unitStride,
+                                    NULL, output, pointStatus) == RPE_OK, "rpeEvaluateExpandedMasked of PQ");
+    check((pointStatus[0] == RPE_POINT_OUT_OF_RANGE) && (pointStatus[1] == RPE_POINT_OK),
+          "domain check of a saturation P below the triple point");
+    check(rpeEvaluateExpandedMasked(session, "H", "TD", 1, &numPoints, temp, &unitStride, density, &unitStride,
+                                    NULL, output, pointStatus) == RPE_OK, "rpeEvaluateExpandedMasked of TD");
+    check((pointStatus[0] == RPE_POINT_OUT_OF_RANGE) && (pointStatus[1] == RPE_POINT_OK),
+          "domain check of a negative D");
+    rpeSetDomainCheck(session, 0);
+} // end function testDomain
+
+///////////////////////////////////////////////////////////////////////////////////
+// two-phase points by the lever rule agree with the full flash, and the         //
+// single-phase points are still flashed                                         //
+///////////////////////////////////////////////////////////////////////////////////
+static void testLeverRule(rpeSession *session)
+{
+    const char *props[2]  = {"S", "D"};
+    double      value1[3] = {200.0, 200.0, 200.0};
+    double      value2[3] = {150.0, 250.0, 350.0};
+    double      flashed[3];
+    double      lever  [3];
+
+    for (int itp = 0; itp < 2; itp++)
+    {
+        rpeSetLeverRule(session, 0);
+        check(rpeEvaluate(session, props[itp], "PH", 3, value1, value2, flashed) == RPE_OK, "rpeEvaluate by flash");
+        check(rpeNumLeverRule(session) == 0, "rpeNumLeverRule without the lever rule");
+        rpeSetLeverRule(session, 1);
+        check(rpeEvaluate(session, props[itp], "PH", 3, value1, value2, lever) == RPE_OK,
+              "rpeEvaluate by the lever rule");
+        check((rpeNumLeverRule(session) == 1) && (rpeNumEvaluated(session) == 3),
+              "rpeNumLeverRule counts the two-phase point only");
+        check((fabs(lever[1] - flashed[1]) < 1e-12) && (lever[0] == flashed[0]) && (lever[2] == flashed[2]),
+              "lever rule values agree with the flash");
+    } // end loop over a property linear in the quality and the density
+    rpeSetLeverRule(session, 0);
+} // end function testLeverRule
+
+///////////////////////////////////////////////////////////////////////////////////
+// the second evaluation of the same points is served by the shared cache, but   //
+// for the failed point, and a segment whose creator died before publishing its  //
+// header is replaced                                                            //
+///////////////////////////////////////////////////////////////////////////////////
+static void testSharedCache(rpeSession *session)
+{
+#if !defined(_WIN32)
+    double      value1[4] = {1.0, -1.0, 2.0, 3.0};
+    double      value2[4] = {10.0, 20.0, 30.0, 40.0};
+    double      output[4] = {0.0};
+    std::string name      = "refpropEngineTest" + std::to_string(getpid());
+    std::string deadName  = name + "dead";
+    shm_unlink(("/" + name).c_str());
+    shm_unlink(("/" + deadName).c_str());
+
+    check(rpeSetSharedCache(session, "a/b", 16) == RPE_ERR_CACHE, "rpeSetSharedCache of a name with a slash");
+    check(rpeSetSharedCache(session, name.c_str(), 16) == RPE_OK, "rpeSetSharedCache");
+    check((rpeEvaluate(session, "H", "TP", 4, value1, value2, output) == RPE_OK) && (rpeNumCacheHits(session) == 0),
+          "rpeEvaluate into an empty shared cache");
+    check((rpeEvaluate(session, "H", "TP", 4, value1, value2, output) == RPE_OK) && (rpeNumCacheHits(session) == 3) &&
+          (rpeNumFailed(session) == 1) && (output[0] == 21.0) && isnan(output[1]) && (output[3] == 83.0),
+          "rpeEvaluate from the shared cache, the failed point evaluated again");
+
+    int fd = shm_open(("/" + deadName).c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    check((fd >= 0) && (ftruncate(fd, off_t(sizeof(SharedCacheHeader) + (16 * sizeof(SharedCacheSlot)))) == 0),
+          "creating a segment without publishing its header");
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    check(rpeSetSharedCache(session, deadName.c_str(), 16) == RPE_OK, "rpeSetSharedCache of a dead creator's segment");
+    check((rpeEvaluate(session, "H", "TP", 4, value1, value2, output) == RPE_OK) && (rpeNumCacheHits(session) == 0),
+          "rpeEvaluate into the replaced shared cache");
+
+    check(rpeSetSharedCache(session, NULL, 0) == RPE_OK, "rpeSetSharedCache of NULL");
+    shm_unlink(("/" + name).c_str());
+    shm_unlink(("/" + deadName).c_str());
+#endif
+} // end function testSharedCache
+
+static int alwaysInterrupted(void *)
+{
+    return 1;
+} // end function alwaysInterrupted
+
+///////////////////////////////////////////////////////////////////////////////////
+// an interrupt stops the evaluation at the next column of the grid             //
+///////////////////////////////////////////////////////////////////////////////////
+static void testInterrupt(rpeSession *session)
+{
+    double value1[2] = {1.0, 2.0};
+    double value2[3] = {10.0, 20.0, 30.0};
+    double output[6] = {0.0};
+    size_t outDims[2] = {2, 3};
+    size_t stride1[2] = {1, 0};
+    size_t stride2[2] = {0, 1};
+
+    rpeSetInterruptCheck(session, alwaysInterrupted, NULL);
+    check(rpeEvaluateExpanded(session, "H", "TP", 2, outDims, value1, stride1, value2, stride2, output) ==
+          RPE_ERR_INTERRUPTED, "rpeEvaluateExpanded interrupted");
+    check((rpeNumEvaluated(session) == 2) && (output[1] == 22.0) && (rpeLastError(session)[0] != '\0'),
+          "rpeNumEvaluated of the first column before the interrupt");
+    rpeSetInterruptCheck(session, NULL, NULL);
+} // end function testInterrupt
+
+int main(int argc, char *argv[])
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: refpropEngineTest fakeRefpropDir\n");
+        return 2;
+    }
+
+    rpeSession *session = testOpen(argv[1]);
+    if (session == NULL)
+    {
+        return numFailedChecks;
+    }
+    testSetup(session);
+    testEvaluate(session);
+    testRecords(session);
+    testPhaseOutput(session);
+    testModel(session);
+    testDomain(session);
+    testLeverRule(session);
+    testSharedCache(session);
+    testInterrupt(session);
+    rpeClose(session);
+    rpeClose(NULL);
+
+    printf("%d failed checks\n", numFailedChecks);
+    return numFailedChecks;
+} // end function main
@@ -0,0 +1,315 @@
+/*=============================================================================================*
+ *  transportMexC.cpp - thermodynamic and transport properties from one flash per state point, *
+ *                      written with the MEX C api.                                            *
+ *                                                                                             *
+ *  From MATLAB(R):                                                                               *
+ *       output = transportMexC(propReq, spec, value1, value2, fluid, iMass, z, path, zipped)  *
+ *                                                                                             *
+ *  Where (see: https://refprop-docs.readthedocs.io/en/latest/DLL/legacy.html)                 *
+ *    output    = DOUBLE (array of size MxNx(numProp+3)) in MASS BASE SI units. The first      *
+ *                numProp pages hold the properties in propReq, followed by the viscosity      *
+ *                (Pa s), thermal conductivity (W/(m K)) and surface tension (N/m). When       *
+ *                zipped is 1 the array is of size Mx1x(numProp+3)                             *
+ *    propReq   = CHAR semicolon separated list of 'hOut' values (may be empty)                *
+ *    spec      = CHAR value accepted by REFPROP as 'hIn'  values                              *
+ *    value1    = DOUBLE (array of size 1xM) of values related to the first character in spec  *
+ *    value2    = DOUBLE (array of size 1xN) of values related to the second character in spec *
+ *    fluid     = CHAR value accepted by REFPROP as 'hFld' values (for mulit-species,          *
+ *                list numSpec fluids separated by a semicolon (;), where 1 < numSpec <= 20    *
+ *    iMass     = INT value to determine input units: 0 -> Molar, 1 -> Mass (sets iMass)       *
+ *    z         = DOUBLE (array of size 1x20) of species fractions                             *
+ *    path      = CHAR path to Refprop directory (e.g. C:\\ProgramFiles (x86)\\REFPROP)        *
+ *    zipped    = DOUBLE value (0 for every pair of value1 and value2, 1 for value1(k) with    *
+ *                value2(k) only, in which case M must equal N)                                *
+ *                                                                                             *
+ *  The viscosity and thermal conductivity are NaN for two-phase states. The surface tension   *
+ *  of a two-phase state uses its own liquid and vapor phases, that of a single-phase state    *
+ *  is taken at saturation at the state temperature (NaN above the critical temperature).      *
+ *=============================================================================================*/
+
+// Copyright 2026 The MathWorks, Inc.
+
+#define REFPROP_IMPLEMENTATION
+#define REFPROP_FUNCTION_MODIFIER
+#undef UNICODE
+#include "REFPROP_lib.h"
+#undef REFPROP_FUNCTION_MODIFIER
+#undef REFPROP_IMPLEMENTATION
+#include "refpropMexHelpers.h"
+
+#include <algorithm>
+#include <string>
+#include <math.h>
+#include "mex.h"
+
+static const size_t numFlash     = 4;  // T, D, DLIQ, DVAP are always requested from the flash
+static const size_t numTransport = 3;  // viscosity, thermal conductivity, surface tension
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// function to check that the number and type of arguments, in and out, are as expected //
+//////////////////////////////////////////////////////////////////////////////////////////
+void checkArguments(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
+{
+    int expectedIn = 9;   // expected number of input variables
+    int inputInt;
+    double inputDouble;
+
+    if(numOutArg > 1)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:transportMexC:nlhs", "Incorrect number of outputs were given, only 1 output is allowed");
+    }
+
+    if(numInArg != expectedIn)
+    {
+        mexErrMsgIdAndTxt("MyToolbox:transportMexC:nrhs", "%i inputs were given, but %i are expected.", numInArg, expectedIn);
+    }
+    else if(!mxIsChar(inputs[0]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:transportMexC:prhs", "Input variable propReq expected to be of type CHAR.");
+    }
+    else if(!mxIsChar(inputs[1]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:transportMexC:prhs", "Input variable spec expected to be of type CHAR.");
+    }
+    else if(!mxIsDouble(inputs[2]) || !mxIsDouble(inputs[3]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:transportMexC:prhs", "Input variables value1 and value2 expected to be of type DOUBLE.");
+    }
+    else if(!mxIsChar(inputs[4]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:transportMexC:prhs", "Input variable substance (or mixture) expected to be of type CHAR.");
+    }
+    else if(!mxIsDouble(inputs[5]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:transportMexC:prhs", "Input variable MassOrMolar expected to be of type DOUBLE with values of 0 or 1.");
+    }
+    else if(!mxIsDouble(inputs[6]) || (mxGetNumberOfElements(inputs[6]) != 20))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:transportMexC:prhs", "Input variable Composition expected to be of type DOUBLE with 20 elements.");
+    }
+    else if(!mxIsChar(inputs[7]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:transportMexC:prhs", "Input variable PathToRefPropDll expected to be of type CHAR.");
+    }
+    else if(!mxIsDouble(inputs[8]))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:transportMexC:prhs", "Input variable Zipped expected to be of type DOUBLE with values of 0 or 1.");
+    }
+    else
+    {
+        inputDouble = mxGetScalar(inputs[5]);
+        inputInt    = int(inputDouble);
+        if ((double(inputInt) != inputDouble) || ((inputInt != 0) && (inputInt != 1)))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:transportMexC:prhs",
+                              "MassOrMolar input of %f is invalid. Acceptable values are 0 for Molar and 1 for Mass to select desired units.", inputDouble);
+        } // end if MassOrMolar is invalid
+
+        if ((mxGetScalar(inputs[8]) != 0.0) && (mxGetNumberOfElements(inputs[2]) != mxGetNumberOfElements(inputs[3])))
+        {
+            mexErrMsgIdAndTxt("MyToolbox:transportMexC:prhs",
+                              "Zipped inputs require value1 and value2 to have the same number of elements: %zu and %zu were given.",
+                              mxGetNumberOfElements(inputs[2]), mxGetNumberOfElements(inputs[3]));
+        } // end if zipped inputs differ in size
+    } // end if input types not as expected, else check values
+} // end function checkArguments
+
+///////////////////////////////////////////////////////////////////////////////////
+// transport properties of one solved state. D, Dl and Dv are in kg/m^3 and are  //
+// converted to mol/L with the molar mass of the composition of their own phase. //
+// Values that REFPROP cannot return are left as NaN in trn (eta, tcx, sigma).   //
+///////////////////////////////////////////////////////////////////////////////////
+static void transportAtState(double T, double D, double Dl, double Dv, double q, double *z, double *x, double *y,
+                             double *trn, char *herr)
+{
+    int    ierr = 0;
+    int    kph  = 1;      // saturation at the state temperature is evaluated as a bubble point
+    double wmm, wmmL, wmmV, eta, tcx, sigma, P, DlSat, DvSat;
+    double xSat[20], ySat[20];
+
+    trn[0] = NAN;
+    trn[1] = NAN;
+    trn[2] = NAN;
+
+    if ((q > 0.0) && (q < 1.0))
+    {
+        ////////////////////////////////////////////////////////////////
+        // two-phase: only the surface tension between the two phases //
+        ////////////////////////////////////////////////////////////////
+        WMOLdll(x, wmmL);
+        WMOLdll(y, wmmV);
+        DlSat = Dl / wmmL;
+        DvSat = Dv / wmmV;
+        SURTENdll(T, DlSat, DvSat, x, y, sigma, ierr, herr, herr_length);
+        if (ierr <= 0) { trn[2] = sigma; }
+        return;
+    } // end if two-phase
+
+    WMOLdll(z, wmm);
+    D = D / wmm;
+    TRNPRPdll(T, D, z, eta, tcx, ierr, herr, herr_length);
+    if (ierr <= 0)
+    {
+        trn[0] = eta * 1.0e-6;  // uPa s -> Pa s
+        trn[1] = tcx;
+    } // end if transport succeeded
+
+    SATTdll(T, z, kph, P, DlSat, DvSat, xSat, ySat, ierr, herr, herr_length);
+    if (ierr <= 0)
+    {
+        SURTENdll(T, DlSat, DvSat, xSat, ySat, sigma, ierr, herr, herr_length);
+        if (ierr <= 0) { trn[2] = sigma; }
+    } // end if a saturation state exists at T
+} // end function transportAtState
+
+void mexFunction(int numOutArg, mxArray *outputs[], int numInArg, const mxArray *inputs[])
+{
+    ///////////////////////////////////////////////////////////////////////
+    // check that the input and output variables have the correct format //
+    ///////////////////////////////////////////////////////////////////////
+    checkArguments(numOutArg, outputs, numInArg, inputs);
+
+    ///////////////////////////////
+    // getting the actual inputs //
+    ///////////////////////////////
+    const char   *propReq   = mxArrayToString(inputs[0]);               // Properties requested for output
+    const char   *specSum   = mxArrayToString(inputs[1]);               // characters encoding spec variables
+    const double *value1    = mxGetPr(        inputs[2]);               // values for first  spec variable
+    const double *value2    = mxGetPr(        inputs[3]);               // values for second spec variable
+    const char   *fluid     = mxArrayToString(inputs[4]);               // String for fluid type
+          int     iMass     = int(mxGetScalar(inputs[5]));              // Specifies mole or mass based input composition -> 0 = mole, 1 = mass
+          double *zIn       = mxGetPr(        inputs[6]);               // Composition on a mole or mass basis depending on iMass
+    std::string   path      = std::string(mxArrayToString(inputs[7]));  // location of reprop dll
+          bool    zipped    = (mxGetScalar(inputs[8]) != 0.0);          // pair value1(k) with value2(k) only
+          size_t  numelVal1 = mxGetNumberOfElements(inputs[2]);         // number of values for the first spec
+          size_t  numelVal2 = mxGetNumberOfElements(inputs[3]);         // number of values for the second spec
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // the flash always returns T, D, DLIQ and DVAP ahead of the requested props //
+    ///////////////////////////////////////////////////////////////////////////////
+    std::string props(propReq);
+    size_t      numProp  = 0;
+    std::string flashOut = "T;D;DLIQ;DVAP";
+    if (props.find_first_not_of(" ") != std::string::npos)
+    {
+        numProp   = 1 + std::count(props.begin(), props.end(), ';');
+        flashOut += ";" + props;
+    } // end if thermodynamic properties were requested
+
+    /////////////////////////////////////////////
+    // Allocate memory for the output variable //
+    /////////////////////////////////////////////
+    size_t numCols   = zipped ? 1 : numelVal2;
+    size_t numPoints = numelVal1 * numCols;
+    mwSize outDims[3] = {numelVal1, numCols, numProp + numTransport};
+    outputs[0] = mxCreateNumericArray(3, outDims, mxDOUBLE_CLASS, mxREAL);
+    double *propOut = mxGetPr(outputs[0]);
+
+    ///////////////////////////
+    // Setup local variables //
+    ///////////////////////////
+    size_t itr        = 0;                      // iterator over rows
+    size_t itc        = 0;                      // iterator over columns
+    size_t itp        = 0;                      // iterator over output properties
+    int    ierr       = 0;                      // OUTPUT: error flag -> 0 = successful, !0 = unsuccessful
+    int    iUnits     = 0;                      // INPUT:  Enumeration to denote which unit system to use
+    int    mixFlag    = 0;                      // flag to determine whether input is mixture
+    int    iFlag      = 0;                      // INPUT:  GETENUMdll checks all possible strings
+    double z[20];                               // Composition on a mole basis
+    double x[20];                               // OUTPUT: Composition of liquid phase
+    double y[20];                               // OUTPUT: Composition of vapor phase
+    double wmm;                                 // molar mass of the mixture (not used)
+    double q;                                   // OUTPUT: Vapor quality
+    double hOutput[200];                        // OUTPUT: Array of properties specified by hOut
+    double trn[numTransport];                   // viscosity, thermal conductivity, surface tension of one state
+    char   herr[herr_length];                   // OUTPUT: Error string
+    char   unitString[] = "MASS BASE SI";       // all values are returned in SI units
+#if defined(_WIN32)
+    std::string DLL_name = "REFPRP64.DLL";      // Refprop dll used on Windows
+#else
+    std::string DLL_name = "";                  // librefprop.so or librefprop.dylib
+#endif
+    std::string serr;                           // load_REFPROP requires the error variable to be a string
+
+    /////////////////////////////
+    // loading the Refprop dll //
+    /////////////////////////////
+    if (!load_REFPROP(serr, path, DLL_name))
+    {
+        mexErrMsgIdAndTxt("MyToolbox:transportMexC:load", "REFPROP failed to load from: %s -> %s", path.c_str(), serr.c_str());
+    }
+    SETPATHdll(const_cast<char*>(path.c_str()), 255);
+
+    setRefpropFluid(fluid, zIn, mixFlag, ierr);
+    if (ierr != 0)
+    {
+        unload_REFPROP(serr);
+        mexErrMsgIdAndTxt("MyToolbox:transportMexC:prhs", "Fluid %s failed to set: Error %d", fluid, ierr);
+    }
+
+    ///////////////////////////////////////////////////////////////////////
+    // TRNPRPdll and SURTENdll expect a mole fraction composition.       //
+    // A .MIX file has already returned its composition in mole fraction //
+    ///////////////////////////////////////////////////////////////////////
+    if ((iMass == 1) && !isMixFile(fluid))
+    {
+        XMOLEdll(zIn, z, wmm);
+    }
+    else
+    {
+        std::copy(zIn, zIn + 20, z);
+    } // end if mass, else molar composition
+
+    GETENUMdll(iFlag, unitString, iUnits, ierr, herr, hUnits_length, herr_length);
+    if (ierr != 0)
+    {
+        unload_REFPROP(serr);
+        mexErrMsgIdAndTxt("MyToolbox:transportMexC:prhs", "Converting %s to enum failed: Error %d -> %s", unitString, ierr, herr);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // one flash per state point, the transport routines reuse the solved state. //
+    // After the first call the fluid string is passed as blank so REFPROP keeps //
+    // the loaded fluid                                                          //
+    ///////////////////////////////////////////////////////////////////////////////
+    for (itc = 0; itc < numCols; itc++)
+    {
+        for (itr = 0; itr < numelVal1; itr++)
+        {
+            size_t idx = (numelVal1 * itc) + itr;
+            double a   = value1[itr];
+            double b   = zipped ? value2[itr] : value2[itc];
+
+            ierr = callREFPROPdll((idx == 0) ? fluid : " ", specSum, flashOut.c_str(), iUnits, 0, mixFlag, a, b, z,
+                                  hOutput, q, x, y, herr);
+            if (ierr > 0)
+            {
+                mexWarnMsgIdAndTxt("MyToolbox:transportMexC:refprop", "Refprop call failed: WARNING %s = (%f, %f) -> %d %s", specSum, a, b, ierr, herr);
+                for (itp = 0; itp < (numProp + numTransport); itp++)
+                {
+                    propOut[(numPoints * itp) + idx] = NAN;
+                } // end loop over output properties
+                continue;
+            } // end if the flash failed
+
+            transportAtState(hOutput[0], hOutput[1], hOutput[2], hOutput[3], q, z, x, y, trn, herr);
+
+            for (itp = 0; itp < numProp; itp++)
+            {
+                propOut[(numPoints * itp) + idx] = hOutput[numFlash + itp];
+            } // end loop over thermodynamic properties
+            for (itp = 0; itp < numTransport; itp++)
+            {
+                propOut[(numPoints * (numProp + itp)) + idx] = trn[itp];
+            } // end loop over transport properties
+        } // end loop over spec 1 (itr)
+    } // end loop over spec 2 (itc)
+
+    //////////////////////////////////////////
+    // Unload refprop to release the memory //
+    //////////////////////////////////////////
+    if (!unload_REFPROP(serr))
+    {
+        mexWarnMsgIdAndTxt("MyToolbox:transportMexC:unload", "REFPROP failed to unload properly.");
+    } // if REFPROP failed to unload
+} // end function mexFunction -> entry point
@@ -0,0 +1,58 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% validateRefpropInputs
+%   Checks shared by every MATLAB(R) function that calls one of the REFPROP mex files.
+%
+%   From MATLAB:
+%        Composition = validateRefpropInputs(Fluid, Composition, Path2Refprop)
+%
+%   Where
+%
+%       Fluid   = CHAR value accepted by REFPROP as 'hFld' values, for multi-species list species 1 to numSpec
+%                      separated by semicolons (;)
+%  Composition  = DOUBLE (1xnumSpec array) of species fractions where (1 < numSpec <= 20) and values must sum to 1.
+%                        On return it is padded with zeros to the 20 elements expected by the mex files.
+%  Path2Refprop = CHAR path to Refprop directory (e.g. C:\\ProgramFiles (x86)\\REFPROP)
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function Composition = validateRefpropInputs(Fluid, Composition, Path2Refprop)
+    arguments
+        Fluid         (1, :)char;
+        Composition   (1, :)double;
+        Path2Refprop  (1, :)char;
+    end
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % Checking Path2Refprop validity %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    if ~exist(Path2Refprop, 'dir')
+        error(Path2Refprop + " does not exist. Please specify the path to your RefProp installation.");
+    else
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        % look for the library files directly rather than listing the REFPROP directory %
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        if ~any(isfile(fullfile(Path2Refprop, ["REFPRP64.DLL", "librefprop.so", "librefprop.dylib"])))
+            error(Path2Refprop + " does not contain ""REFPRP64.DLL"" (or ""librefprop.so"", ""librefprop.dylib"" on "...
+                  + "Linux and macOS). Please specify the path to your RefProp installation.")
+        end % end if the directory does not contain the REFPROP shared library
+    end % end if not, else, refprop directory exists
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % Checking validity of Composition and Fluid since there must be one fluid for every  %
+    % composition entry, we want to make sure they match in size. Also, Composition must  %
+    % have at least one and no more than twenty elements, and the elements must sum to 1. %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    nelCmp = numel(Composition);
+    nelFld = numel(strsplit(Fluid, ';'));
+    if nelCmp ~= nelFld
+        error('Fluid must contain the same number of elements as the specified composition. Currently, you have specified %d fluids: %s, and %d compositions', nelFld, Fluid, nelCmp);
+    end
+    if (sum(Composition) < (1 - 0.0001)) || (sum(Composition) > (1 + 0.0001)) || any(Composition < 0)
+        error('Composition must contain positive values between 0 and 1, which sum to 1. Currently, your composition sums to %d', sum(Composition));
+    end
+    if nelCmp > 20
+        error('Composition and Fluid cannot have more than 20 elements. Currently, your Composition and Fluid arrays contains %d elements.', nelCmp);
+    end
+    Composition = [Composition, zeros(1, (20 - nelCmp))];
+end % end function validateRefpropInputs
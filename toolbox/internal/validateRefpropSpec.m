@@ -0,0 +1,84 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% validateRefpropSpec
+%   Checks that Spec is a pair of input properties or a flag accepted by REFPROP as 'hIn' values.
+%
+%   From MATLAB:
+%        validateRefpropSpec(Spec)
+%
+%   Where
+%
+%       Spec    = CHAR value accepted by REFPROP as 'hIn' values, e.g. 'TP', 'PHL', 'TMELT', 'CRIT'
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2019 - 2026 The MathWorks, Inc.
+
+function validateRefpropSpec(Spec)
+    arguments
+        Spec          (1, :)char;
+    end
+
+    PossibleSpecs  = {'T', 'P', 'D', 'E', 'H', 'S', 'Q'};   % Temperature, Pressure, Density, Energy, Enthalpy, Entropy, Quality
+    AddonsAfter1   = {'MELT', 'SUBL'};                      % Melting or sublimation point given the input properties
+    AddonsAfter2   = {'L', '>', '<', 'V'};                  % Single phase liquid (L, >), Single Phase Vaopor (<, V)
+
+    SupportedSpecFlags   = {'NBP', 'CRIT', 'TRIP', 'DSAT', 'HSAT', 'HSAT2', 'SSAT', 'SSAT2', 'SSAT3'};
+    UnsupportedSpecFlags = {'FLAGS', 'EOSMIN', 'EOSMAX', 'SETREF', 'SETREFOFF', 'PATH', 'SATSPLN'};
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%
+    % Checking Spec Validity %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%
+    mainMessage = 'it should be a pair of unique letters from the following: T, P, D, E, H, S, Q.';
+    enhcMessage = 'It may be enhanced with one of the following: L, <, >, V, MELT, SUBL.';
+    flagMessage = 'it may be one of the following supported flags: CRIT, TRIP, DSAT, NBP, HSAT, HSAT2, SSAT, SSAT2, SSAT3.';
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % Must have at least two characters %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    if (size(Spec, 2) < 2) 
+        error('Spec was given as %s, but %s\n%s\nOr %s', Spec, mainMessage, enhcMessage, flagMessage)
+    elseif (size(Spec, 2) == 2)
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        % if there are two characters,                      %
+        % they must both be from the allowed character list %
+        % and must be different from each other             %
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        if strcmp(Spec, '  ')
+           % noop (Two blank spaces allows for critical and triple point reqs.)
+        elseif (    (~(    any(strcmpi(Spec(1), PossibleSpecs))    ...
+                    && any(strcmpi(Spec(2), PossibleSpecs)) ) )...
+             || (          strcmpi(Spec(1), Spec(2)      )    ) )
+            error('Spec was given as %s, but %s\n%s\nOr %s', Spec, mainMessage, enhcMessage, flagMessage)
+        end
+    elseif (size(Spec, 2) == 3) 
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        % if there are three characters,                                              %
+        %   Either: the first two characters must be from the allowed character list  %
+        %           and the third character must be from the add-on character list    %
+        %           and the first two characters must be different from each other    %
+        %     OR    it can be "NBP" -> one of the supported flags                     %
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        if(    (    (~(    any(strcmpi(Spec(1), PossibleSpecs  ))     ...
+                        && any(strcmpi(Spec(2), PossibleSpecs  ))     ...
+                        && any(strcmpi(Spec(3), AddonsAfter2   ))) )  ...
+                || (           strcmpi(Spec(1), Spec(2)        )   ) )...
+            && (          ~any(strcmpi(Spec, SupportedSpecFlags))    ) )
+            error('Spec was given as %s, but %s\n%s\nOr %s', Spec, mainMessage, enhcMessage, flagMessage)
+        end
+    else % (size(Spec, 2)  > 3)
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        % if there are four or more characters,                                       %
+        %   Either: the first character must be from the allowed character list       %
+        %           and the rest of the entry must be from the add-on character list  %
+        %     OR    it can one of the supported flags (NOT one of the unsupported)    %
+        %    ELSE   if it is of the supported flags, send a message about it          %
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        if(    (~(    any(strcmpi(Spec(1),     PossibleSpecs))    ...
+                   && any(strcmpi(Spec(2:end), AddonsAfter1 ))) ) ...
+            && (     ~any(strcmpi(Spec, SupportedSpecFlags  ))  ) ...
+            && (     ~any(strcmpi(Spec, UnsupportedSpecFlags))  ) )
+            error('Spec was given as %s, but %s\n%s\nOr %s', Spec, mainMessage, enhcMessage, flagMessage)
+        elseif any(strcmpi(Spec, UnsupportedSpecFlags))
+            error('Spec was given as %s, but MLrefprop does not support use of this flag at this time.', Spec);
+        end 
+    end
+end % end function validateRefpropSpec
@@ -0,0 +1,62 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% handle = (double) scalar handle of the prepared query, pass it to evaluatePreparedProperty
+%
+% [INPUTS]:
+% libraryLocation   = (string) the location of the REFPROP library files (dll, exe, etc.)
+% requestedProperty = (string) the thermodynamic property name for which the value will be returned
+% inputProperty1    = (string) name of the 1st property used as the state point
+% inputProperty2    = (string) name of the 2nd property used as the state point
+% fluid             = (string) indicating the fluid, e.g., "Water", "R32;R125"
+% fluidComposition  = (double) array of size 1xnumSpec species fraction where 1 <= numSpec <= 20, whose values must
+%                              sum to 1; numSpec must match the number of species in the fluid
+% massOrMolar       = (int) value to determine input composition units: 0 -> Molar, 1 -> Mass
+% desiredUnits      = (char) enum as expected by refprop.dll to determine the units to use, e.g., MKS, MASS BASE SI
+%
+% Runs the checks of getFluidProperty on everything except the state point values once, loads REFPROP, sets the fluid
+% and resolves desiredUnits to its REFPROP enum. evaluatePreparedProperty then only passes the handle and the values
+% to REFPROP, which keeps the cost of a call with a single state point small, e.g., when a property is evaluated at
+% every step of a simulation. REFPROP stays loaded until every handle has been released with
+% releasePreparedProperty. REFPROP only.
+%
+% EXAMPLES:
+%    libLoc = 'C:\Program Files (x86)\REFPROP\';
+%
+%    Specific enthalpy of water in J/mol at every step of a loop:
+%    hQuery = prepareFluidProperty(libLoc, 'H', 'T', 'P', "Water", 1, 1, 'MKS');
+%    for k = 1:1000
+%        h(k) = evaluatePreparedProperty(hQuery, 290 + 0.1*k, 101.325);
+%    end
+%    releasePreparedProperty(hQuery);
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function handle = prepareFluidProperty(libraryLocation, requestedProperty, inputProperty1, inputProperty2, fluid,...
+                                       fluidComposition, massOrMolar, desiredUnits)
+    arguments
+        libraryLocation   (1, :) {mustBeText}
+        requestedProperty (1, :) {mustBeText}
+        inputProperty1    (1, :) {mustBeText}
+        inputProperty2    (1, :) {mustBeText}
+        fluid             (1, :) {mustBeText}
+        fluidComposition  (1, :) double       = 1;
+        massOrMolar       (1, 1) double       = 0;
+        desiredUnits      (1, :) {mustBeText} = "MKS";
+    end
+
+    if ~contains(libraryLocation, "REFPROP", "IgnoreCase", true)
+        error("Prepared queries are available for REFPROP only. Use getFluidProperty with keepLibraryLoaded=true "...
+              + "for CoolProp.");
+    end
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % the same checks MLrefprop runs on every call, run once for the handle %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    inputProps = char(string(inputProperty1) + string(inputProperty2));
+    validateRefpropSpec(inputProps);
+    Composition = validateRefpropInputs(char(fluid), fluidComposition, char(libraryLocation));
+
+    handle = preparedMexC('prepare', char(requestedProperty), inputProps, char(fluid), massOrMolar, Composition,...
+                          char(desiredUnits), char(libraryLocation));
+end % end function prepareFluidProperty
@@ -0,0 +1,67 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% values = (memmapfile) map of the property surface, values.Data.values is the MxNxP array of property values, one page
+%                       per requested property. Only the parts that are indexed are read from disk
+% info   = (struct) the file header with fields
+%                       dataSize    - [M, N, P]
+%                       tileSize    - [rows, columns] of a tile
+%                       tilesDone   - number of tiles written, tiles are written down the rows first
+%                       numTiles    - total number of tiles
+%                       complete    - true when every tile has been written
+%                       meta        - struct of the inputs the file was written with (library, fluid, composition,
+%                                     requested properties and the input property names and values)
+%                       metaText    - meta as the JSON text stored in the file
+%                       headerBytes - size of the header, the values start at this byte offset
+%                       tilesDoneOffset - byte offset of the tilesDone counter
+%
+% [INPUTS]:
+% fileName = (string) file written by streamFluidProperty
+%
+% File layout (little-endian):
+%    bytes 0-7     'FLPSTRM1'
+%    uint32        header size in bytes
+%    uint32        format version (1)
+%    uint64 x 6    M, N, P, tile rows, tile columns, tiles done
+%    uint32        length of the JSON metadata in bytes, followed by the UTF-8 JSON text padded to the header size
+%    double        MxNxP values in column-major order
+%
+% EXAMPLES:
+%    [values, info] = readFluidPropertyStream("co2.flps");
+%    H = values.Data.values(:, :, info.meta.requestedProperties == "H");
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function [values, info] = readFluidPropertyStream(fileName)
+    arguments
+        fileName (1, :) {mustBeText}
+    end
+
+    [fid, msg] = fopen(fileName, 'r', 'ieee-le');
+    if fid < 0
+        error("Cannot open %s: %s", fileName, msg);
+    end
+    closeFile = onCleanup(@() fclose(fid));
+
+    magic = fread(fid, [1, 8], 'uchar=>char');
+    if ~strcmp(magic, 'FLPSTRM1')
+        error("%s is not a file written by streamFluidProperty.", fileName);
+    end
+    info.headerBytes = fread(fid, 1, 'uint32');
+    version          = fread(fid, 1, 'uint32');
+    if version ~= 1
+        error("%s has format version %d, only version 1 can be read.", fileName, version);
+    end
+    sizes                = fread(fid, [1, 6], 'uint64');
+    info.tilesDoneOffset = 8 + 4 + 4 + (5 * 8);
+    info.dataSize        = sizes(1:3);
+    info.tileSize        = sizes(4:5);
+    info.tilesDone       = sizes(6);
+    info.numTiles        = ceil(info.dataSize(1) / info.tileSize(1)) * ceil(info.dataSize(2) / info.tileSize(2));
+    info.complete        = (info.tilesDone >= info.numTiles);
+    metaBytes            = fread(fid, 1, 'uint32');
+    info.metaText        = native2unicode(fread(fid, [1, metaBytes], '*uint8'), 'UTF-8');
+    info.meta            = jsondecode(info.metaText);
+
+    values = memmapfile(fileName, Offset=info.headerBytes, Format={'double', info.dataSize, 'values'}, Repeat=1);
+end % end function readFluidPropertyStream
@@ -0,0 +1,123 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% calls = (struct) (Kx1) array of the recorded getFluidProperty calls in the order they were made, with fields
+%                      Library           - "REFPROP", "CoolProp" or "Server" (REFPROP through a refpropServer)
+%                      StartTime         - start of the call in s since the trace was started
+%                      Elapsed           - duration of the call in s
+%                      RequestedProperty, InputProperty1, InputProperty2, Fluid, DesiredUnits, Accuracy,
+%                      CoolPropBackend, InputUnits (1x2), OutputUnit - (string) the arguments of the call
+%                      MassOrMolar, Composition, Values1, Values2, DomainCheck - the other arguments of the call
+%                      Values            - (1xK) values the call returned in column-major order, [] when they
+%                                          were not recorded
+% info  = (struct) with fields Started (datetime the trace was started), NumCalls, NumPoints and Truncated, true
+%                  when the last record is incomplete, e.g., because MATLAB exited before stopFluidPropertyTrace
+%
+% [INPUTS]:
+% traceFile = (string) file written by startFluidPropertyTrace
+%
+% File layout (little-endian), one record per call after the header; see internal/fluidPropertyTrace.m for the
+% layout of a record:
+%    bytes 0-7     'FLPTRCE1'
+%    uint32        format version (1)
+%    double        POSIX time the trace was started
+%
+% EXAMPLES:
+%    calls = readFluidPropertyTrace("cycle.fptrace");
+%    histogram(categorical([calls.RequestedProperty]))
+%    fprintf("%.1f%% of the time in CP calls\n", 100 * sum([calls([calls.RequestedProperty] == "CP").Elapsed]) /...
+%            sum([calls.Elapsed]));
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function [calls, info] = readFluidPropertyTrace(traceFile)
+    arguments
+        traceFile (1, :) {mustBeText}
+    end
+
+    [fid, msg] = fopen(traceFile, 'r', 'ieee-le');
+    if fid < 0
+        error("Cannot open %s: %s", traceFile, msg);
+    end
+    closeFile = onCleanup(@() fclose(fid));
+
+    magic = fread(fid, [1, 8], 'uchar=>char');
+    if ~strcmp(magic, 'FLPTRCE1')
+        error("%s is not a file written by startFluidPropertyTrace.", traceFile);
+    end
+    version = fread(fid, 1, 'uint32');
+    if version ~= 1
+        error("%s has format version %d, only version 1 can be read.", traceFile, version);
+    end
+    info.Started = datetime(fread(fid, 1, 'double'), ConvertFrom="posixtime");
+    bytes        = fread(fid, [1, Inf], '*uint8');
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % the records are length prefixed, walk them in the bytes read at once %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    libraries = ["REFPROP", "CoolProp", "Server"];
+    names     = ["RequestedProperty", "InputProperty1", "InputProperty2", "Fluid", "DesiredUnits", "Accuracy",...
+                 "CoolPropBackend", "InputUnits1", "InputUnits2", "OutputUnit"];
+    callList  = {};
+    offset    = 0;
+    info.Truncated = false;
+    while offset < numel(bytes)
+        recordBytes = Inf;
+        if offset + 4 <= numel(bytes)
+            recordBytes = double(typecast(bytes(offset+1:offset+4), 'uint32'));
+        end
+        if offset + 4 + recordBytes > numel(bytes)
+            info.Truncated = true;
+            break
+        end
+        record      = bytes(offset+5:offset+4+recordBytes);
+        offset      = offset + 4 + recordBytes;
+
+        times = typecast(record(1:16), 'double');
+        call  = struct("Library", libraries(double(record(17)) + 1), "StartTime", times(1), "Elapsed", times(2));
+        flags = double(record(18));
+        pos   = 18;
+        for name = names
+            [call.(name), pos] = unpackString(record, pos);
+        end
+        call.InputUnits  = [call.InputUnits1, call.InputUnits2];
+        call             = rmfield(call, ["InputUnits1", "InputUnits2"]);
+        call.MassOrMolar = typecast(record(pos+1:pos+8), 'double');
+        pos              = pos + 8;
+        [call.Composition, pos] = unpackArray(record, pos);
+        [call.Values1, pos]     = unpackArray(record, pos);
+        [call.Values2, pos]     = unpackArray(record, pos);
+        call.DomainCheck        = logical(bitand(flags, 1));
+        call.Values             = [];
+        if bitand(flags, 2)
+            call.Values = unpackArray(record, pos);
+        end
+        callList{end+1, 1} = call; %#ok<AGROW>
+    end
+
+    calls = vertcat(callList{:});
+    if isempty(calls)
+        calls = struct([]);
+    end
+
+    info.NumCalls  = numel(calls);
+    info.NumPoints = 0;
+    for kx = 1:numel(calls)
+        info.NumPoints = info.NumPoints + max(numel(calls(kx).Values1), 1) * max(numel(calls(kx).Values2), 1);
+    end
+end % end function readFluidPropertyTrace
+
+function [value, pos] = unpackString(record, pos)
+% UNPACKSTRING string stored as a uint16 length followed by its UTF-8 characters
+    len   = double(typecast(record(pos+1:pos+2), 'uint16'));
+    value = string(native2unicode(record(pos+3:pos+2+len), 'UTF-8'));
+    pos   = pos + 2 + len;
+end % end function unpackString
+
+function [values, pos] = unpackArray(record, pos)
+% UNPACKARRAY row of doubles stored as a uint32 count followed by the values
+    count  = double(typecast(record(pos+1:pos+4), 'uint32'));
+    values = typecast(record(pos+5:pos+4+8*count), 'double');
+    values = reshape(values, 1, []);
+    pos    = pos + 4 + 8 * count;
+end % end function unpackArray
@@ -0,0 +1,27 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [INPUTS]:
+% handle = (double) handle returned by prepareFluidProperty, when it is not given every prepared query is released
+%
+% REFPROP is unloaded once the last prepared query has been released. Clearing the mex files (clear mex) releases
+% every prepared query as well.
+%
+% EXAMPLES:
+%    releasePreparedProperty(hQuery);
+%    releasePreparedProperty();
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function releasePreparedProperty(handle)
+    arguments
+        handle (1, :) double = [];
+    end
+
+    if isempty(handle)
+        preparedMexC('releaseAll');
+    else
+        for hx = 1:numel(handle)
+            preparedMexC('release', handle(hx));
+        end % end loop over handles
+    end
+end % end function releasePreparedProperty
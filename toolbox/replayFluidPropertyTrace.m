@@ -0,0 +1,175 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% report = (struct) with the fields
+%              NumCalls, NumPoints   - calls and state points in the trace
+%              NumReplayed           - calls replayed, the others cannot be evaluated by the target library
+%              NumSkipped            - calls not replayed, see below
+%              RecordedTime          - time the replayed calls took when they were recorded in s
+%              ReplayTime            - time the same calls took in the replay in s
+%              Speedup               - RecordedTime / ReplayTime
+%              NumCompared           - points whose recorded values the replayed values were compared with
+%              MaxRelDeviation       - largest relative deviation of the replayed from the recorded values
+%              RmsRelDeviation       - root mean square of the relative deviations
+%              NumFailedReplay       - points the recording evaluated but the replay returned NaN for
+%              Calls                 - (table) one row per call with Index, Library, RequestedProperty, Fluid,
+%                                      NumPoints, Replayed, RecordedTime, ReplayTime and MaxRelDeviation
+%
+% [INPUTS]:
+% traceFile       = (string) file written by startFluidPropertyTrace
+% libraryLocation = (string) the location of the REFPROP or CoolProp library files the trace is replayed with
+% Accuracy        = [REFPROP optional (name, value) pair] (string) accuracy tier of every replayed call, defaults to
+%                                                                  "" -> the tier each call was recorded with
+% CoolPropBackend = [CoolProp optional (name, value) pair] (string) CoolProp backend of every replayed call, defaults
+%                                                                  to "" -> the backend each call was recorded with
+% Server          = [REFPROP optional (name, value) pair] (string) socket path of a refpropServer to replay with,
+%                                                                  defaults to "" -> REFPROP in this session
+%
+% The calls are replayed one after the other in the recorded order, with the recorded inputs, so the replay sees the
+% same sequence of fluids and state points the application made, fluid switches and cache behavior included. CoolProp is
+% kept loaded between the calls and unloaded at the end. A call recorded with the other library is replayed when it can
+% be translated: a single species or molar composition, the property names T, P, D, H, S, Q and CP (Dmass, Hmass, Smass
+% and Cpmass in CoolProp), REFPROP's MASS BASE SI units and no InputUnits or OutputUnit. Other calls are skipped and
+% counted in NumSkipped. Deviations are only computed for traces recorded with RecordResults=true.
+%
+% EXAMPLES:
+%    rpLoc = 'C:\Program Files (x86)\REFPROP\';
+%    cpLoc = 'C:\Program Files\CoolProp\';
+%
+%    Replay a recorded cycle simulation with the fast tier and with CoolProp's bicubic tables:
+%    fast  = replayFluidPropertyTrace("cycle.fptrace", rpLoc, Accuracy="fast");
+%    tables = replayFluidPropertyTrace("cycle.fptrace", cpLoc, CoolPropBackend="BICUBIC&HEOS");
+%    fprintf("fast tier %.1fx, max deviation %.2g\n", fast.Speedup, fast.MaxRelDeviation);
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function report = replayFluidPropertyTrace(traceFile, libraryLocation, opts)
+    arguments
+        traceFile            (1, :) {mustBeText}
+        libraryLocation      (1, :) {mustBeText}
+        opts.Accuracy        (1, 1) string {mustBeMember(opts.Accuracy, ["", "exact", "fast", "hybrid"])} = "";
+        opts.CoolPropBackend (1, 1) string {mustBeMember(opts.CoolPropBackend,...
+                                                         ["", "HEOS", "BICUBIC&HEOS", "TTSE&HEOS"])} = "";
+        opts.Server          (1, :) {mustBeText} = "";
+    end
+
+    if fluidPropertyTrace("isRecording")
+        error("A trace is being recorded, call stopFluidPropertyTrace before replaying so the replay is not recorded.");
+    end
+    calls = readFluidPropertyTrace(traceFile);
+
+    toRefprop    = contains(libraryLocation, "REFPROP", "IgnoreCase", true);
+    localRefprop = toRefprop && (strlength(opts.Server) == 0);
+    cpNames      = containers.Map({'T', 'P', 'D',     'H',     'S',     'Q', 'CP'},...
+                                  {'T', 'P', 'Dmass', 'Hmass', 'Smass', 'Q', 'Cpmass'});
+    rpNames      = containers.Map(cpNames.values, cpNames.keys);
+
+    numCalls     = numel(calls);
+    numPoints    = zeros(numCalls, 1);
+    replayed     = false(numCalls, 1);
+    replayTime   = zeros(numCalls, 1);
+    maxDeviation = NaN(numCalls, 1);
+    sumSquares   = 0;
+    numCompared  = 0;
+    numFailed    = 0;
+    unloadAtEnd  = onCleanup(@() unloadCoolProp(toRefprop));
+
+    for kx = 1:numCalls
+        call = calls(kx);
+        numPoints(kx) = max(numel(call.Values1), 1) * max(numel(call.Values2), 1);
+
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        % same library: the recorded arguments, with the tier or backend asked for, if any %
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        names    = [call.RequestedProperty, call.InputProperty1, call.InputProperty2];
+        units    = call.DesiredUnits;
+        accuracy = "exact";
+        backend  = "HEOS";
+        if toRefprop == (call.Library ~= "CoolProp")
+            if localRefprop
+                accuracy = call.Accuracy;
+            end
+            backend = call.CoolPropBackend;
+        else
+            %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+            % other library: translate the property names of calls in SI units, skip the ones we can't %
+            %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+            nameMap = rpNames;
+            if toRefprop
+                units = "MASS BASE SI";
+            else
+                nameMap = cpNames;
+            end
+            if ~all(isKey(nameMap, cellstr(names))) || any(strlength([call.InputUnits, call.OutputUnit]) > 0) ||...
+               (~toRefprop && (units ~= "MASS BASE SI")) || ((numel(call.Composition) > 1) && (call.MassOrMolar ~= 0))
+                continue
+            end
+            names = string(values(nameMap, cellstr(names)));
+        end
+        if (opts.Accuracy ~= "") && localRefprop
+            accuracy = opts.Accuracy;
+        end
+        if (opts.CoolPropBackend ~= "") && ~toRefprop
+            backend = opts.CoolPropBackend;
+        end
+
+        replayTimer = tic;
+        try
+            value = getFluidProperty(libraryLocation, char(names(1)), char(names(2)), call.Values1, char(names(3)),...
+                                     call.Values2, call.Fluid, call.Composition, call.MassOrMolar, char(units),...
+                                     keepLibraryLoaded=true, Server=opts.Server, Accuracy=accuracy,...
+                                     InputUnits=call.InputUnits, OutputUnit=call.OutputUnit,...
+                                     CoolPropBackend=backend, DomainCheck=call.DomainCheck && localRefprop);
+        catch
+            value = NaN(numPoints(kx), 1);
+        end
+        replayTime(kx) = toc(replayTimer);
+        replayed(kx)   = true;
+
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        % relative deviation over the points both evaluated, failures where only the replay failed %
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        if numel(call.Values) == numel(value)
+            recorded  = call.Values(:);
+            value     = value(:);
+            both      = isfinite(recorded) & isfinite(value);
+            deviation = abs(value(both) - recorded(both)) ./ max(abs(recorded(both)), realmin);
+            if ~isempty(deviation)
+                maxDeviation(kx) = max(deviation);
+                sumSquares       = sumSquares + sum(deviation.^2);
+                numCompared      = numCompared + numel(deviation);
+            end
+            numFailed = numFailed + nnz(isfinite(recorded) & ~isfinite(value));
+        end
+    end % end for each recorded call
+
+    recordedTime = zeros(numCalls, 1);
+    if numCalls > 0
+        recordedTime = [calls.Elapsed]';
+    end
+    report = struct("NumCalls", numCalls, "NumPoints", sum(numPoints), "NumReplayed", nnz(replayed),...
+                    "NumSkipped", nnz(~replayed), "RecordedTime", sum(recordedTime(replayed)),...
+                    "ReplayTime", sum(replayTime), "Speedup", sum(recordedTime(replayed)) / sum(replayTime),...
+                    "NumCompared", numCompared, "MaxRelDeviation", max([maxDeviation; NaN], [], "omitnan"),...
+                    "RmsRelDeviation", sqrt(sumSquares / numCompared), "NumFailedReplay", numFailed);
+
+    library = strings(numCalls, 1);
+    request = strings(numCalls, 1);
+    fluid   = strings(numCalls, 1);
+    if numCalls > 0
+        library = [calls.Library]';
+        request = [calls.RequestedProperty]';
+        fluid   = [calls.Fluid]';
+    end
+    report.Calls = table((1:numCalls)', library, request, fluid, numPoints, replayed, recordedTime, replayTime,...
+                         maxDeviation, VariableNames=["Index", "Library", "RequestedProperty", "Fluid",...
+                                                      "NumPoints", "Replayed", "RecordedTime", "ReplayTime",...
+                                                      "MaxRelDeviation"]);
+end % end function replayFluidPropertyTrace
+
+function unloadCoolProp(toRefprop)
+% UNLOADCOOLPROP the replay keeps CoolProp loaded between calls, unload it once at the end
+    if ~toRefprop && libisloaded('CoolProp')
+        unloadlibrary('CoolProp');
+    end
+end % end function unloadCoolProp
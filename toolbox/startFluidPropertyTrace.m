@@ -0,0 +1,35 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [INPUTS]:
+% traceFile     = (string) binary file the calls are recorded to, created or overwritten
+% RecordResults = [optional (name, value) pair] (logical) defaults to true -> store the values each call returned,
+%                                                                             which replayFluidPropertyTrace compares
+%                                                                             the replayed values against
+%                                                                    false -> store the inputs and timing only
+%
+% Every getFluidProperty call in this MATLAB session, including those made by fitSaturationAncillary,
+% compareAccuracyTiers and other functions built on it, is recorded until stopFluidPropertyTrace: the library (REFPROP,
+% CoolProp or a refpropServer), the property names, fluid, composition, units and options, the input arrays, the start
+% time and duration of the call, and optionally its result. Functions that call their own MEX files, such as
+% getFluidPropertyBatch or getCycleStates, are not recorded. The library location and the Mask option are not recorded.
+% Only one trace is recorded at a time.
+%
+% EXAMPLES:
+%    libLoc = 'C:\Program Files (x86)\REFPROP\';
+%
+%    Record a simulation's property workload, then replay it with the fast accuracy tier:
+%    startFluidPropertyTrace("cycle.fptrace");
+%    runCycleSimulation();
+%    info   = stopFluidPropertyTrace();
+%    report = replayFluidPropertyTrace("cycle.fptrace", libLoc, Accuracy="fast");
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function startFluidPropertyTrace(traceFile, opts)
+    arguments
+        traceFile          (1, :) {mustBeText}
+        opts.RecordResults (1, 1) logical = true;
+    end
+
+    fluidPropertyTrace("start", char(traceFile), opts.RecordResults);
+end % end function startFluidPropertyTrace
@@ -0,0 +1,79 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% socketPath = (string) path of the Unix domain socket the server listens on, pass it to getFluidProperty as the
+%                       Server option
+%
+% [INPUTS]:
+% libraryLocation = (string) the location of the REFPROP library files (librefprop.so or librefprop.dylib)
+% SocketPath      = [optional (name, value) pair] (string) socket to listen on, defaults to
+%                                                          refpropServer_<user>.sock in tempdir
+% NumWorkers      = [optional (name, value) pair] (double) number of worker processes, each with its own REFPROP
+%                                                          instance, defaults to 4
+% CacheSize       = [optional (name, value) pair] (double) number of state points in the result cache all workers
+%                                                          share, defaults to 1e6; 0 disables the cache
+%
+% Starts refpropServer (built by createREFPROPmex) in the background, unless a server is already running on the
+% socket. The server keeps REFPROP loaded and the last fluid set in every worker, so MATLAB sessions and batch jobs on
+% the same host share the load and setup cost and the result cache. A REFPROP crash ends one worker, which the
+% server restarts, rather than the MATLAB session. The server keeps running after MATLAB exits until
+% stopPropertyServer is called. Linux and macOS only, the server output is written to <socketPath>.log.
+%
+% EXAMPLES:
+%    libLoc = '/opt/REFPROP/';
+%
+%    server = startPropertyServer(libLoc);
+%    h = getFluidProperty(libLoc, 'H', 'T', 300:10:400, 'P', 101.325, 'Water', 1, 1, 'MKS', Server=server);
+%    stopPropertyServer(server);
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function socketPath = startPropertyServer(libraryLocation, opts)
+    arguments
+        libraryLocation (1, :) {mustBeText}
+        opts.SocketPath (1, :) {mustBeText} = fullfile(tempdir, "refpropServer_" + getenv("USER") + ".sock");
+        opts.NumWorkers (1, 1) double {mustBeInteger, mustBePositive} = 4;
+        opts.CacheSize  (1, 1) double {mustBeInteger, mustBeNonnegative} = 1e6;
+    end
+
+    if ispc
+        error("refpropServer uses Unix domain sockets and worker processes, it runs on Linux and macOS only.");
+    end
+    socketPath = string(opts.SocketPath);
+
+    if isServerRunning(socketPath)
+        return
+    end
+
+    serverExe = fullfile(fileparts(which('serverMexC')), 'refpropServer');
+    if ~isfile(serverExe)
+        error("%s does not exist. Run createREFPROPmex to build refpropServer.", serverExe);
+    end
+
+    [status, msg] = system(sprintf('"%s" "%s" "%s" %d %d > "%s.log" 2>&1 &', serverExe, socketPath,...
+                                   libraryLocation, opts.NumWorkers, opts.CacheSize, socketPath));
+    if status ~= 0
+        error("refpropServer failed to start: %s", msg);
+    end
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % the server writes its pid file once the socket is listening for connections %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    startTime = tic;
+    while ~isServerRunning(socketPath)
+        if toc(startTime) > 10
+            error("refpropServer did not start within 10 s, see %s.log", socketPath);
+        end
+        pause(0.1);
+    end
+end % end function startPropertyServer
+
+function running = isServerRunning(socketPath)
+% true when the pid file exists and names a live process
+    running = false;
+    pidFile = socketPath + ".pid";
+    if isfile(pidFile) && isfile(socketPath)
+        pid     = str2double(strtrim(fileread(pidFile)));
+        running = ~isnan(pid) && (system(sprintf('kill -0 %d 2>/dev/null', pid)) == 0);
+    end
+end % end function isServerRunning
@@ -0,0 +1,19 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% info = (struct) with the fields File (the trace file), NumCalls (getFluidProperty calls recorded) and NumPoints
+%                 (state points those calls returned)
+%
+% Stops the trace started by startFluidPropertyTrace and closes its file. Calling it while no trace is recorded
+% returns the summary of the last trace, or an empty File when there was none.
+%
+% EXAMPLES:
+%    startFluidPropertyTrace("cycle.fptrace");
+%    runCycleSimulation();
+%    info = stopFluidPropertyTrace()
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function info = stopFluidPropertyTrace()
+    info = fluidPropertyTrace("stop");
+end % end function stopFluidPropertyTrace
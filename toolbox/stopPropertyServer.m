@@ -0,0 +1,27 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [INPUTS]:
+% socketPath = (string) socket returned by startPropertyServer, defaults to the startPropertyServer default
+%
+% Stops the refpropServer listening on socketPath and its workers. Every MATLAB session using the server loses it, so
+% call this once no session needs the server any more.
+%
+% EXAMPLES:
+%    stopPropertyServer(server);
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function stopPropertyServer(socketPath)
+    arguments
+        socketPath (1, :) {mustBeText} = fullfile(tempdir, "refpropServer_" + getenv("USER") + ".sock");
+    end
+
+    pidFile = string(socketPath) + ".pid";
+    if ~isfile(pidFile)
+        warning("No refpropServer is running on %s.", socketPath);
+        return
+    end
+
+    pid = str2double(strtrim(fileread(pidFile)));
+    system(sprintf('kill -TERM %d 2>/dev/null', pid));
+end % end function stopPropertyServer
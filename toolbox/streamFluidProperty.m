@@ -0,0 +1,172 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% info = (struct) header of the output file as returned by readFluidPropertyStream
+%
+% [INPUTS]:
+% fileName            = (string) binary file the property surface is written to, see readFluidPropertyStream for the
+%                                layout
+% libraryLocation     = (string) the location of the REFPROP or CoolProp library files (dll, exe, etc.)
+% requestedProperties = (string) array of thermodynamic property names, e.g., ["H", "S", "D"] for REFPROP,
+%                                ["Hmass", "Smass", "Dmass"] for CoolProp
+% inputProperty1      = (string) name of the 1st property used as the state point
+% inputProperty1Value = (double) (1xM) array of values of the 1st property in SI units (K, Pa, kg/m^3, J/kg)
+% inputProperty2      = (string) name of the 2nd property used as the state point
+% inputProperty2Value = (double) (1xN) array of values of the 2nd property in SI units (K, Pa, kg/m^3, J/kg)
+% fluid               = (string) indicating the fluid, e.g., "Water", "R32;R125"
+% fluidComposition    = (double) array of size 1xnumSpec species fraction where 1 <= numSpec <= 20, whose values must
+%                                sum to 1; numSpec must match the number of species in the fluid
+% massOrMolar         = [REFPROP only] (int) value to determine input composition units: 0 -> Molar, 1 -> Mass
+% TileSize            = [optional (name, value) pair] (double) [rows, columns] of the grid evaluated and written at
+%                                                              a time, defaults to [256, 256]
+% Resume              = [optional (name, value) pair] (logical) defaults to true  -> continue an existing file of the
+%                                                                                    same run from its last
+%                                                                                    completed tile
+%                                                                           false -> start the file again
+% keepLibraryLoaded   = [CoolProp optional (name, value) pair] (logical) see getFluidProperty
+%
+% The MxN grid is evaluated one tile at a time with one flash per state point for all requested properties (see
+% getFluidDerivatives), and each tile is written to the file before the next is evaluated, so the memory used does not
+% depend on the grid size. The number of completed tiles is kept in the file header and updated after every tile, so
+% a run that is interrupted continues from the last completed tile when called again with the same inputs. Points in
+% tiles that have not been written yet are NaN. All values are in SI units (MASS BASE SI for REFPROP).
+%
+% EXAMPLES:
+%    libLoc = 'C:\Program Files (x86)\REFPROP\';
+%
+%    Tabulate enthalpy, entropy and density of CO2 on a 4000x4000 (T, P) grid:
+%    streamFluidProperty("co2.flps", libLoc, ["H", "S", "D"], 'T', linspace(220, 800, 4000), 'P',...
+%                        linspace(1e5, 3e7, 4000), "CO2");
+%    [values, info] = readFluidPropertyStream("co2.flps");
+%    H = values.Data.values(:, 1:10, 1);
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function info = streamFluidProperty(fileName, libraryLocation, requestedProperties, inputProperty1,...
+                                    inputProperty1Value, inputProperty2, inputProperty2Value, fluid,...
+                                    fluidComposition, massOrMolar, opts)
+    arguments
+        fileName               (1, :) {mustBeText}
+        libraryLocation        (1, :) {mustBeText}
+        requestedProperties    (1, :) string
+        inputProperty1         (1, :) {mustBeText}
+        inputProperty1Value    (1, :) double
+        inputProperty2         (1, :) {mustBeText}
+        inputProperty2Value    (1, :) double
+        fluid                  (1, :) string
+        fluidComposition       (1, :) double  = 1;
+        massOrMolar            (1, 1) double  = 1;
+        opts.TileSize          (1, 2) double {mustBeInteger, mustBePositive} = [256, 256];
+        opts.Resume            (1, 1) logical = true;
+        opts.keepLibraryLoaded (1, 1) logical = false;
+    end
+
+    numRows  = numel(inputProperty1Value);
+    numCols  = numel(inputProperty2Value);
+    numProp  = numel(requestedProperties);
+    tileSize = min(opts.TileSize, max([numRows, numCols], 1));
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % the inputs are kept in the header so the file describes itself and a run %
+    % is only resumed into a file written with the same inputs                 %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    isRefprop = contains(libraryLocation, "REFPROP", "IgnoreCase", true);
+    library   = "CoolProp";
+    if isRefprop
+        library = "REFPROP";
+    end
+    meta = struct("library", library, "fluid", fluid, "fluidComposition", fluidComposition,...
+                  "massOrMolar", massOrMolar, "requestedProperties", requestedProperties,...
+                  "inputProperty1", string(inputProperty1), "inputProperty1Value", inputProperty1Value,...
+                  "inputProperty2", string(inputProperty2), "inputProperty2Value", inputProperty2Value);
+    metaText = jsonencode(meta);
+
+    tileRowEdges = unique([0:tileSize(1):numRows, numRows]);
+    tileColEdges = unique([0:tileSize(2):numCols, numCols]);
+    numTileRows  = numel(tileRowEdges) - 1;
+    numTiles     = numTileRows * (numel(tileColEdges) - 1);
+
+    tilesDone = 0;
+    if opts.Resume && isfile(fileName)
+        [~, info] = readFluidPropertyStream(fileName);
+        if ~strcmp(info.metaText, metaText) || ~isequal(info.tileSize, tileSize)
+            error("%s was written for different inputs or a different TileSize. Delete it, choose another file or "...
+                  + "set Resume=false to start again.", fileName);
+        end
+        tilesDone = info.tilesDone;
+    else
+        createStreamFile(fileName, [numRows, numCols, numProp], tileSize, metaText);
+    end
+
+    [fid, msg] = fopen(fileName, 'r+', 'ieee-le');
+    if fid < 0
+        error("Cannot open %s for writing: %s", fileName, msg);
+    end
+    closeFile = onCleanup(@() fclose(fid));
+    [~, info] = readFluidPropertyStream(fileName);
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % CoolProp stays loaded between tiles and is unloaded at the end, unless %
+    % the user asked to keep it loaded                                       %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    if ~isRefprop
+        cpObj = MLCoolProp(libraryLocation, opts.keepLibraryLoaded); %#ok<NASGU> unloads CoolProp when deleted
+    end
+
+    for tx = (tilesDone + 1):numTiles
+        rowTile = mod(tx - 1, numTileRows) + 1;
+        colTile = floor((tx - 1) / numTileRows) + 1;
+        rows    = (tileRowEdges(rowTile) + 1):tileRowEdges(rowTile + 1);
+        cols    = (tileColEdges(colTile) + 1):tileColEdges(colTile + 1);
+
+        props = getFluidDerivatives(libraryLocation, requestedProperties, string.empty(1, 0), inputProperty1,...
+                                    inputProperty1Value(rows), inputProperty2, inputProperty2Value(cols), fluid,...
+                                    fluidComposition, massOrMolar, keepLibraryLoaded=true);
+        propNames = fieldnames(props);
+
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        % the file holds an MxNxP column-major array, so a tile is one write per column %
+        %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+        for px = 1:numProp
+            tileVals = props.(propNames{px});
+            for cx = 1:numel(cols)
+                offset = info.headerBytes + 8 * (((px - 1) * numRows * numCols) + ((cols(cx) - 1) * numRows)...
+                                                 + (rows(1) - 1));
+                fseek(fid, offset, 'bof');
+                fwrite(fid, tileVals(:, cx), 'double');
+            end % end loop over columns of the tile
+        end % end loop over properties
+
+        fseek(fid, info.tilesDoneOffset, 'bof');
+        fwrite(fid, tx, 'uint64');
+    end % end loop over tiles
+
+    clear closeFile
+    [~, info] = readFluidPropertyStream(fileName);
+end % end function streamFluidProperty
+
+function createStreamFile(fileName, dataSize, tileSize, metaText)
+% write the header and fill the data with NaN one column at a time
+    [fid, msg] = fopen(fileName, 'w', 'ieee-le');
+    if fid < 0
+        error("Cannot create %s: %s", fileName, msg);
+    end
+    closeFile = onCleanup(@() fclose(fid));
+
+    metaBytes   = unicode2native(metaText, 'UTF-8');
+    fixedBytes  = 8 + 4 + 4 + (6 * 8) + 4;
+    headerBytes = 8 * ceil((fixedBytes + numel(metaBytes)) / 8);
+
+    fwrite(fid, 'FLPSTRM1', 'uchar');
+    fwrite(fid, headerBytes, 'uint32');
+    fwrite(fid, 1, 'uint32');                                   % file format version
+    fwrite(fid, [dataSize, tileSize, 0], 'uint64');             % M, N, P, tile rows, tile columns, tiles done
+    fwrite(fid, numel(metaBytes), 'uint32');
+    fwrite(fid, metaBytes, 'uint8');
+    fwrite(fid, zeros(1, headerBytes - fixedBytes - numel(metaBytes)), 'uint8');
+
+    nanColumn = NaN(dataSize(1), 1);
+    for cx = 1:(dataSize(2) * dataSize(3))
+        fwrite(fid, nanColumn, 'double');
+    end % end loop over columns of every property
+end % end function createStreamFile
@@ -0,0 +1,84 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% [OUTPUT]:
+% job = (FluidPropertyJob) handle to the running evaluation, see FluidPropertyJob for the progress, fetch, cancel and
+%                          wait methods. fetch(job) returns the same MxN array as getFluidProperty
+%
+% [INPUTS]:
+% libraryLocation ... desiredUnits = same as getFluidProperty
+% Pool            = [optional (name, value) pair] (parallel.Pool) process pool to run on, defaults to gcp. Thread
+%                                                                  pools and backgroundPool are rejected
+% NumChunks       = [optional (name, value) pair] (double) number of chunks the rows of the output are split into,
+%                                                          defaults to 4 chunks per worker. More chunks give finer
+%                                                          progress and cancellation at a small cost per chunk
+%
+% submitFluidProperty returns as soon as the chunks are queued on the pool (requires Parallel Computing Toolbox). The
+% chunks are evaluated by getFluidProperty on process workers, since REFPROP keeps its state in global memory. A
+% cancelled job stops between chunks, chunks already running are interrupted on their worker. With CoolProp the
+% workers keep the library loaded between chunks.
+%
+% EXAMPLES:
+%    libLoc = 'C:\Program Files (x86)\REFPROP\';
+%
+%    Start a 1000x1000 enthalpy surface, check on it, then collect it:
+%    job = submitFluidProperty(libLoc, 'H', 'T', linspace(250, 400, 1000), 'P', linspace(1e5, 4e6, 1000),...
+%                              "R134a", 1, 1, 'MASS BASE SI');
+%    status = progress(job)
+%    H = fetch(job);
+%
+%    Stop a job that is no longer needed:
+%    cancel(job);
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+% Copyright 2026 The MathWorks, Inc.
+
+function job = submitFluidProperty(libraryLocation, requestedProperty, inputProperty1, inputProperty1Value,...
+                                   inputProperty2, inputProperty2Value, fluid, fluidComposition, massOrMolar,...
+                                   desiredUnits, opts)
+    arguments
+        libraryLocation        (1, :) {mustBeText}
+        requestedProperty      (1, :) {mustBeText}
+        inputProperty1         (1, :) {mustBeText}
+        inputProperty1Value    (1, :) double
+        inputProperty2         (1, :) {mustBeText}
+        inputProperty2Value    (1, :) double
+        fluid                  (1, :) string
+        fluidComposition       (1, :) double       = 1;
+        massOrMolar            (1, 1) double       = 0;
+        desiredUnits           (1, :) {mustBeText} = "MKS";
+        opts.Pool                                  = [];
+        opts.NumChunks                double       = [];
+    end
+
+    if isempty(opts.Pool)
+        opts.Pool = gcp;
+    end
+    if isempty(opts.Pool)
+        error("No parallel pool is open and automatic pool creation is off. Start a process pool with " +...
+              "parpool(""Processes"") or pass one as Pool.");
+    elseif ~isa(opts.Pool, "parallel.Pool") || isa(opts.Pool, "parallel.ThreadPool") ||...
+           isa(opts.Pool, "parallel.BackgroundPool")
+        error("Pool must be a process pool, such as parpool(""Processes""). REFPROP keeps its state in global " +...
+              "memory, so thread workers, including backgroundPool, would share one REFPROP instance.");
+    end
+    if isempty(opts.NumChunks)
+        opts.NumChunks = 4 * opts.Pool.NumWorkers;
+    end
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    % split the rows (values of inputProperty1) into chunks, each chunk is one getFluidProperty call %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    numRows   = numel(inputProperty1Value);
+    numChunks = max(1, min(opts.NumChunks, numRows));
+    rowEdges  = round(linspace(0, numRows, numChunks + 1));
+
+    futures = parallel.FevalFuture.empty(0, 1);
+    for cx = 1:numChunks
+        chunkRows = (rowEdges(cx) + 1):rowEdges(cx + 1);
+        futures(cx, 1) = parfeval(opts.Pool, @getFluidProperty, 1, libraryLocation, requestedProperty,...
+                                  inputProperty1, inputProperty1Value(chunkRows), inputProperty2,...
+                                  inputProperty2Value, fluid, fluidComposition, massOrMolar, desiredUnits,...
+                                  "keepLibraryLoaded", true);
+    end % end loop over chunks
+
+    job = FluidPropertyJob(futures, rowEdges, [numRows, numel(inputProperty2Value)]);
+end % end function submitFluidProperty